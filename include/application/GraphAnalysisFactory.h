@@ -15,6 +15,9 @@ namespace Application
     public:
         // репозитории
         static std::unique_ptr<Domain::IGraphRepository> createRepository();
+        // по содержимому файла: двоичный формат графа или текстовый список ребер
+        // (с метриками связей из <файл>.metrics.csv и координатами узлов из <файл>.nodes.csv, если они есть)
+        static std::unique_ptr<Domain::IGraphRepository> createRepository(const std::string &filename);
 
         // алгоритмы поиска пути
         static Infrastructure::IPathFinderPtr createPathFinder();
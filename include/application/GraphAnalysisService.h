@@ -4,11 +4,15 @@
 #include <vector>
 #include <memory>
 #include <utility>
+#include <cstdint>
 
 namespace Domain
 {
     class NetworkGraph;
     using NetworkGraphPtr = std::shared_ptr<NetworkGraph>;
+    class ConcurrentGraph;
+    using NodeId = std::int64_t;
+    using NodePair = std::pair<NodeId, NodeId>;
 
     struct PathResult;
     class IGraphRepository;
@@ -27,11 +31,17 @@ namespace Application
         GraphAnalysisService() = default;
         Domain::PathResult analyzeShortestPath(
             const Domain::NetworkGraphPtr &graph,
-            int start_id, int end_id);
+            Domain::NodeId start_id, Domain::NodeId end_id);
 
         std::vector<Domain::PathResult> analyzePathsParallel(
             const Domain::NetworkGraphPtr &graph,
-            const std::vector<std::pair<int, int>> &routes);
+            const std::vector<Domain::NodePair> &routes);
+
+        // запросы к графу, который параллельно обновляет писатель: каждый запрос
+        // закрепляет текущую версию и не блокирует публикацию новых
+        std::vector<Domain::PathResult> analyzePathsParallel(
+            const Domain::ConcurrentGraph &graph,
+            const std::vector<Domain::NodePair> &routes);
     };
 
 }
@@ -75,6 +75,16 @@ namespace Config
             };
         }
         
+        // 7) пользовательская стратегия (из файла стратегий) для всех алгоритмов с весами
+        static StrategySettings createCustom(Domain::WeightCalculator::Strategy strategy) {
+            return {
+                Domain::WeightCalculator::UNIFORM_WEIGHTS,
+                strategy,
+                strategy,
+                strategy
+            };
+        }
+        
         // получить описание конфигурации
         std::string getDescription() const {
             return "Config[Uniform: " + Domain::WeightCalculator::getStrategyName(exact_uniform) +
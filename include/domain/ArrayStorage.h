@@ -0,0 +1,158 @@
+#ifndef ARRAYSTORAGE_H
+#define ARRAYSTORAGE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Domain
+{
+    // массив, который либо владеет элементами (std::vector), либо ссылается на чужую память
+    // только для чтения (например, на отображенный файл или общий блок, см. share). владелец
+    // чужой памяти удерживается через backing, при первом изменении содержимое копируется в собственный вектор
+    template <typename T>
+    class ArrayStorage
+    {
+    public:
+        ArrayStorage() = default;
+        explicit ArrayStorage(std::vector<T> values) : owned(std::move(values)) { sync(); }
+        ArrayStorage(const ArrayStorage &other) { *this = other; }
+        ArrayStorage(ArrayStorage &&other) noexcept { *this = std::move(other); }
+
+        ArrayStorage &operator=(const ArrayStorage &other)
+        {
+            if (this == &other) return *this;
+            owned = other.owned;
+            backing = other.backing;
+            external = other.external;
+            heap = other.heap;
+            count = other.count;
+            refresh();
+            return *this;
+        }
+
+        ArrayStorage &operator=(ArrayStorage &&other) noexcept
+        {
+            owned = std::move(other.owned);
+            backing = std::move(other.backing);
+            external = other.external;
+            heap = other.heap;
+            count = other.count;
+            refresh();
+            other.reset();
+            return *this;
+        }
+
+        // представление count элементов по адресу data без копирования
+        static ArrayStorage view(const T *data, std::size_t count, std::shared_ptr<const void> backing)
+        {
+            ArrayStorage res;
+            res.backing = std::move(backing);
+            res.external = data;
+            res.count = count;
+            res.refresh();
+            return res;
+        }
+
+        // перенос собственных элементов в неизменяемый блок в куче: массив становится его представлением,
+        // копии массива ссылаются на тот же блок без копирования элементов
+        void share()
+        {
+            if (external || owned.empty()) return;
+            auto block = std::make_shared<const std::vector<T>>(std::move(owned));
+            std::vector<T>().swap(owned);
+            external = block->data();
+            count = block->size();
+            backing = std::move(block);
+            heap = true;
+            refresh();
+        }
+
+        bool isView() const { return external != nullptr; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        const T *data() const { return values; }
+        const T *begin() const { return values; }
+        const T *end() const { return values + count; }
+        const T &operator[](std::size_t index) const { return values[index]; }
+
+        // изменяющие операции (представление сначала копируется)
+        T &operator[](std::size_t index)
+        {
+            detach();
+            return owned[index];
+        }
+
+        void push_back(const T &value)
+        {
+            detach();
+            owned.push_back(value);
+            sync();
+        }
+
+        void reserve(std::size_t size)
+        {
+            detach();
+            owned.reserve(size);
+            sync();
+        }
+
+        void resize(std::size_t size, const T &value = T())
+        {
+            detach();
+            owned.resize(size, value);
+            sync();
+        }
+
+        void assign(std::size_t size, const T &value)
+        {
+            release();
+            owned.assign(size, value);
+            sync();
+        }
+
+        // освобождение памяти (в том числе ссылки на чужую)
+        void reset()
+        {
+            release();
+            std::vector<T>().swap(owned);
+            sync();
+        }
+
+        // байты в куче процесса; отображенная память не учитывается, общий блок - в каждом массиве, который на него ссылается
+        std::size_t getMemoryUsage() const { return owned.capacity() * sizeof(T) + (heap ? count * sizeof(T) : 0); }
+
+    private:
+        void detach()
+        {
+            if (!external) return;
+            owned.assign(external, external + count);
+            release();
+            sync();
+        }
+
+        void release()
+        {
+            external = nullptr;
+            heap = false;
+            backing.reset();
+        }
+
+        void sync()
+        {
+            count = owned.size();
+            refresh();
+        }
+
+        void refresh() { values = external ? external : owned.data(); }
+
+        std::vector<T> owned;
+        std::shared_ptr<const void> backing;
+        const T *external = nullptr;
+        bool heap = false;              // external - общий блок в куче (share)
+        const T *values = nullptr;      // external или owned.data()
+        std::size_t count = 0;
+    };
+}
+
+#endif
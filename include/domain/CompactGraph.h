@@ -0,0 +1,112 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include "NetworkTypes.h"
+#include "ArrayStorage.h"
+#include "PagedArray.h"
+#include "WeightCalculator.h"
+#include "LinkParameterStore.h"
+#include "MemoryUsage.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Domain
+{
+    class CompactGraph;
+    using CompactGraphPtr = std::shared_ptr<const CompactGraph>;
+
+    // неизменяемое CSR-представление графа (строится один раз, общее для всех решателей).
+    // массивы лежат в общих блоках: снимок с измененными параметрами (withParameters) разделяет
+    // с базовым топологию целиком, а параметры и веса - кроме страниц с измененными ребрами
+    class CompactGraph
+    {
+    public:
+        using NodeIndex = Domain::NodeIndex;
+        using EdgeIndex = std::uint32_t;
+        using WeightArray = std::shared_ptr<const PagedArray<double>>;
+
+        static constexpr NodeIndex INVALID_NODE = INVALID_NODE_INDEX;
+        static constexpr EdgeIndex INVALID_EDGE = std::numeric_limits<EdgeIndex>::max();
+
+        // массивы CSR как они хранятся в графе (для сериализации и сборки поверх готовой памяти)
+        struct Arrays
+        {
+            ArrayStorage<NodeId> nodeIds;
+            ArrayStorage<NodeId> sortedIds;        // пусто, если nodeIds упорядочены по id
+            ArrayStorage<NodeIndex> sortedIndex;
+            ArrayStorage<EdgeIndex> offsets;
+            ArrayStorage<NodeIndex> targets;
+            LinkParameterStore parameters;
+        };
+
+        // edge_index (если задан) получает соответствие id ребра графа -> индекс ребра CSR
+        static CompactGraphPtr build(const NetworkGraph &graph, std::vector<EdgeIndex> *edge_index = nullptr);
+
+        // та же структура с перенумерованными вершинами: order[новый индекс] = старый индекс;
+        // edge_map (если задан) получает соответствие старый индекс ребра -> новый
+        static CompactGraphPtr permute(const CompactGraph &base, const std::vector<NodeIndex> &order,
+                                       std::vector<EdgeIndex> *edge_map = nullptr);
+
+        // снимок той же топологии с измененными параметрами части ребер: топология общая с base,
+        // в столбцах параметров и уже посчитанных массивах весов копируются только страницы с этими ребрами
+        static CompactGraphPtr withParameters(const CompactGraph &base,
+                                              const std::vector<std::pair<EdgeIndex, LinkParameters>> &changes);
+
+        // граф поверх готовых массивов без копирования (например, отображенных из файла);
+        // проверяются только размеры и крайние смещения, std::invalid_argument - несогласованные массивы
+        static CompactGraphPtr fromArrays(Arrays arrays);
+
+        // размеры
+        std::size_t getNodeCount() const { return nodeIds.size(); }
+        std::size_t getEdgeCount() const { return targets.size(); }
+
+        // преобразование внешних id <-> плотные индексы 0..n-1
+        NodeId getNodeId(NodeIndex index) const { return nodeIds[index]; }
+        NodeIndex findIndex(NodeId id) const;
+
+        // исходящие ребра вершины u занимают диапазон [edgesBegin(u), edgesEnd(u))
+        EdgeIndex edgesBegin(NodeIndex u) const { return offsets[u]; }
+        EdgeIndex edgesEnd(NodeIndex u) const { return offsets[u + 1]; }
+        std::size_t getOutDegree(NodeIndex u) const { return offsets[u + 1] - offsets[u]; }
+        NodeIndex getTarget(EdgeIndex e) const { return targets[e]; }
+        EdgeIndex findEdge(NodeIndex u, NodeIndex v) const;
+
+        // параметры ребер по столбцам, id ребра в хранилище совпадает с индексом CSR
+        LinkParameters getEdgeParameters(EdgeIndex e) const { return parameters.get(e); }
+        double getEdgeValue(LinkParameterStore::Column column, EdgeIndex e) const { return parameters.getValue(column, e); }
+        const LinkParameterStore &getParameterStore() const { return parameters; }
+
+        // массивы CSR (см. Arrays)
+        const ArrayStorage<NodeId> &getNodeIdArray() const { return nodeIds; }
+        const ArrayStorage<NodeId> &getSortedIdArray() const { return sortedIds; }
+        const ArrayStorage<NodeIndex> &getSortedIndexArray() const { return sortedIndex; }
+        const ArrayStorage<EdgeIndex> &getOffsetArray() const { return offsets; }
+        const ArrayStorage<NodeIndex> &getTargetArray() const { return targets; }
+
+        // массив весов по индексу ребра, вычисляется при первом обращении
+        WeightArray getEdgeWeights(WeightCalculator::Strategy strategy) const;
+
+        // память по структурам (массивы CSR, параметры, посчитанные веса)
+        MemoryUsage getMemoryUsage() const;
+
+    private:
+        // массивы построенного графа в общие блоки
+        void share();
+
+        ArrayStorage<NodeId> nodeIds;         // индекс -> внешний id (по возрастанию id, если не перенумерован)
+        ArrayStorage<NodeId> sortedIds;       // для перенумерованного графа: id по возрастанию
+        ArrayStorage<NodeIndex> sortedIndex;  //   и индексы соответствующих вершин
+        ArrayStorage<EdgeIndex> offsets;      // n + 1 смещений
+        ArrayStorage<NodeIndex> targets;      // конец ребра, внутри строки по возрастанию
+        LinkParameterStore parameters;
+
+        mutable std::mutex weightsMutex;
+        mutable std::unordered_map<int, WeightArray> weightsCache;
+    };
+}
+
+#endif
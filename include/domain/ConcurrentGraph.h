@@ -0,0 +1,117 @@
+#ifndef CONCURRENTGRAPH_H
+#define CONCURRENTGRAPH_H
+
+#include "NetworkTypes.h"
+#include "NetworkGraph.h"
+#include "CompactGraph.h"
+#include "LinkParameterStore.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Domain
+{
+    // граф для параллельных запросов при одном писателе (схема read-copy-update с эпохами).
+    // читатели закрепляют неизменяемую CSR-версию без блокировок, писатель меняет свою
+    // копию NetworkGraph и атомарно публикует новую версию; старая версия освобождается,
+    // когда ее не удерживает ни один читатель
+    class ConcurrentGraph
+    {
+    public:
+        // закрепленная версия графа: действительна до разрушения объекта
+        class ReadGuard
+        {
+        public:
+            ReadGuard() = default;
+            ReadGuard(ReadGuard &&other) noexcept
+                : slot(std::exchange(other.slot, nullptr)), graph(std::exchange(other.graph, nullptr)), epoch(other.epoch) {}
+            ReadGuard &operator=(ReadGuard &&other) noexcept;
+            ReadGuard(const ReadGuard &) = delete;
+            ReadGuard &operator=(const ReadGuard &) = delete;
+            ~ReadGuard() { release(); }
+
+            const CompactGraph &operator*() const { return *graph; }
+            const CompactGraph *operator->() const { return graph; }
+            const CompactGraph &get() const { return *graph; }
+            std::uint64_t getEpoch() const { return epoch; }
+
+        private:
+            friend class ConcurrentGraph;
+            ReadGuard(std::atomic<std::uint64_t> *slot, const CompactGraph *graph, std::uint64_t epoch)
+                : slot(slot), graph(graph), epoch(epoch) {}
+            void release();
+
+            std::atomic<std::uint64_t> *slot = nullptr;
+            const CompactGraph *graph = nullptr;
+            std::uint64_t epoch = 0;
+        };
+
+        // reader_slots - число одновременно закрепленных версий (0 - по числу ядер)
+        explicit ConcurrentGraph(NetworkGraphPtr graph, std::size_t reader_slots = 0);
+        ~ConcurrentGraph();
+        ConcurrentGraph(const ConcurrentGraph &) = delete;
+        ConcurrentGraph &operator=(const ConcurrentGraph &) = delete;
+
+        // сторона читателя (любой поток)
+        ReadGuard pin() const;
+        std::uint64_t getEpoch() const { return epoch.load(); }
+
+        // сторона писателя (один поток): изменения видны читателям после publish()
+        bool setEdgeParameters(NodeId source, NodeId target, const LinkParameters &params)
+        {
+            return graph->setEdgeParameters(source, target, params);
+        }
+        bool setEdgeParameter(NodeId source, NodeId target, LinkParameterStore::Column column, double value)
+        {
+            return graph->setEdgeParameter(source, target, column, value);
+        }
+
+        // произвольные изменения графа писателя (узлы, ребра, пакетная загрузка)
+        template <typename Mutation>
+        void modify(Mutation &&mutation)
+        {
+            mutation(*graph);
+        }
+
+        // публикация накопленных изменений, возвращает эпоху новой версии; после изменений
+        // только параметров новая версия собирается из прежней без перестроения CSR
+        std::uint64_t publish();
+
+        // освобождение вышедших из обращения версий, возвращает число освобожденных
+        std::size_t reclaim();
+
+        std::size_t getRetiredCount() const { return retired.size(); }
+        const NetworkGraph &getWriterGraph() const { return *graph; }
+
+    private:
+        // слот читателя на отдельной кэш-линии: 0 - свободен, иначе эпоха при закреплении
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<std::uint64_t> epoch{0};
+        };
+
+        struct RetiredVersion
+        {
+            std::uint64_t epoch;     // эпоха, с которой версия больше не выдается
+            CompactGraphPtr graph;
+        };
+
+        std::uint64_t getOldestPinnedEpoch() const;
+
+        NetworkGraphPtr graph;
+        std::unique_ptr<ReaderSlot[]> slots;
+        std::size_t slotCount;
+
+        std::atomic<const CompactGraph *> current{nullptr};
+        std::atomic<std::uint64_t> epoch{1};
+
+        // данные писателя
+        CompactGraphPtr currentOwner;
+        std::vector<RetiredVersion> retired;
+    };
+    using ConcurrentGraphPtr = std::shared_ptr<ConcurrentGraph>;
+}
+
+#endif
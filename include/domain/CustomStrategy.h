@@ -0,0 +1,84 @@
+#ifndef CUSTOMSTRATEGY_H
+#define CUSTOMSTRATEGY_H
+
+#include "WeightCalculator.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Domain
+{
+    // пользовательская стратегия весов: сумма слагаемых coefficient * term(параметры ребра).
+    // описание собирается в программу один раз при загрузке: нулевые слагаемые отбрасываются,
+    // известны нужные столбцы, а пакетный расчет идет за один проход по ребрам: на каждой плитке
+    // векторов выполняется вся программа, какой бы она ни была
+    class CustomStrategy
+    {
+    public:
+        enum Term {
+            // линейные слагаемые - значение параметра (порядок как у LinkParameterStore::Column)
+            LATENCY,
+            BANDWIDTH,
+            PACKET_LOSS,
+            UTILIZATION,
+            COST,
+            RELIABILITY,
+            // нелинейные слагаемые на формулах встроенных стратегий
+            EFFECTIVE_LATENCY,          // latency * (1 + 3 * utilization^2)
+            INVERSE_BANDWIDTH,          // 1 / bandwidth
+            INVERSE_CURRENT_BANDWIDTH,  // 1 / (bandwidth * (1 - packet_loss))
+            UNRELIABILITY,              // 1 - надежность с учетом потерь и загрузки
+            UTILIZATION_EXCESS,         // max(0, utilization - threshold)
+            TERM_COUNT
+        };
+
+        struct Component {
+            Term term = LATENCY;
+            double coefficient = 0.0;
+            double threshold = 0.0;     // только для UTILIZATION_EXCESS
+        };
+
+        // слагаемые складываются в порядке описания (от него зависит округление)
+        struct Spec {
+            std::string name;
+            std::string description;
+            std::vector<Component> components;
+        };
+
+        // компиляция описания; std::invalid_argument - пустое имя или нет ненулевых слагаемых
+        explicit CustomStrategy(const Spec &spec);
+
+        const std::string &getName() const { return spec.name; }
+        const std::string &getDescription() const { return spec.description; }
+        const Spec &getSpec() const { return spec; }
+        // битовая маска нужных столбцов LinkParameterStore
+        unsigned getColumns() const { return columns; }
+        // ненулевые слагаемые в порядке описания (непустая)
+        const std::vector<Component> &getProgram() const { return program; }
+
+        double evaluate(const LinkParameters &params) const;
+        // вес ребра e по столбцам параметров (используются только нужные столбцы)
+        double weight(const WeightCalculator::ParameterColumns &c, std::size_t e) const;
+        // веса count ребер; побитово совпадают с evaluate при любом наборе инструкций
+        void calculateBatch(const WeightCalculator::ParameterColumns &c, std::size_t count, double *out,
+                            WeightCalculator::InstructionSet isa) const;
+
+        static std::string getTermName(Term term);
+        // поиск слагаемого по имени из getTermName; false - имя неизвестно
+        static bool findTerm(const std::string &name, Term &term);
+
+    private:
+        Spec spec;
+        std::vector<Component> program;     // ненулевые слагаемые в порядке описания
+        unsigned columns = 0;
+        unsigned sharedTerms = 0;           // нелинейные слагаемые без порога, считаются раз на плитку (бит 1 << term)
+
+        // ядра в WeightKernels.cpp: нелинейные слагаемые плитки в буфер, затем сумма программы в регистрах
+        void calculateBatchScalar(const WeightCalculator::ParameterColumns &c, std::size_t first, std::size_t count,
+                                  double *out) const;
+        void calculateBatchAvx2(const WeightCalculator::ParameterColumns &c, std::size_t count, double *out) const;
+        void calculateBatchAvx512(const WeightCalculator::ParameterColumns &c, std::size_t count, double *out) const;
+    };
+}
+
+#endif
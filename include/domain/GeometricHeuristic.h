@@ -0,0 +1,55 @@
+#ifndef GEOMETRICHEURISTIC_H
+#define GEOMETRICHEURISTIC_H
+
+#include "CompactGraph.h"
+#include "NodeCoordinates.h"
+#include "WeightCalculator.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Domain
+{
+    class GeometricHeuristic;
+    using GeometricHeuristicPtr = std::shared_ptr<const GeometricHeuristic>;
+
+    // оценка A* по координатам узлов: h(u) = scale * |u - goal|, где scale - наименьшее по ребрам
+    // отношение веса стратегии к расстоянию между концами ребра (для задержки - 1 / наибольшая скорость).
+    // тогда h(u) <= w(u, v) + h(v) для каждого ребра: оценка согласована и не превышает длины
+    // кратчайшего пути. проверка выполняется при построении; если гарантию дать нельзя, оценки нулевые
+    class GeometricHeuristic
+    {
+    public:
+        // массивы по индексам вершин graph; эвристика годится только для этого снимка и стратегии
+        GeometricHeuristic(const CompactGraph &graph, const NodeCoordinates &coordinates,
+                           WeightCalculator::Strategy strategy);
+
+        // false - оценки нулевые (A* совпадает с Дейкстрой): у части узлов нет координат,
+        // есть ребра с отрицательным или неопределенным весом или ребро нулевого веса между разными точками
+        bool isUsable() const { return scale > 0.0; }
+
+        double getScale() const { return scale; }
+        WeightCalculator::Strategy getStrategy() const { return strategy; }
+        std::size_t getNodeCount() const { return positions.size(); }
+        std::size_t getMissingNodes() const { return missingNodes; }
+        std::size_t getInvalidEdges() const { return invalidEdges; }
+        std::size_t getZeroWeightEdges() const { return zeroWeightEdges; }
+
+        double estimate(CompactGraph::NodeIndex u, CompactGraph::NodeIndex goal) const
+        {
+            return scale * NodeCoordinates::distance(positions[u], positions[goal]);
+        }
+
+        std::size_t getMemoryBytes() const { return positions.capacity() * sizeof(NodeCoordinates::Position); }
+
+    private:
+        WeightCalculator::Strategy strategy;
+        std::vector<NodeCoordinates::Position> positions;   // по индексу вершины снимка
+        double scale = 0.0;
+        std::size_t missingNodes = 0;
+        std::size_t invalidEdges = 0;
+        std::size_t zeroWeightEdges = 0;
+    };
+}
+
+#endif
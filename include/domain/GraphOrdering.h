@@ -0,0 +1,40 @@
+#ifndef GRAPHORDERING_H
+#define GRAPHORDERING_H
+
+#include "NetworkTypes.h"
+#include "CompactGraph.h"
+#include <string>
+#include <vector>
+
+namespace Domain
+{
+    // перенумерация вершин CSR-представления для локальности обращений к памяти:
+    // соседние по графу вершины получают близкие индексы, внешние id не меняются
+    class GraphOrdering
+    {
+    public:
+        enum Method {
+            ID_ORDER,          // по возрастанию внешнего id (исходный порядок)
+            BFS_ORDER,         // обход в ширину по компонентам связности
+            RCM_ORDER,         // обратный Катхилла-Макки: минимизация ширины ленты матрицы смежности
+            DEGREE_ORDER,      // по убыванию степени (концентраторы в начале)
+            COMMUNITY_ORDER    // по сообществам (распространение меток), внутри сообщества - BFS
+        };
+
+        // оценка локальности: для обхода важны расстояния между индексами концов ребра
+        struct Locality {
+            double averageGap = 0.0;        // средняя |u - v| по ребрам
+            std::size_t maxGap = 0;         // ширина ленты
+            double crossLineShare = 0.0;    // доля ребер, чьи концы лежат в разных кэш-линиях массива double
+        };
+
+        // перестановка: позиция в новом порядке -> индекс вершины в graph
+        static std::vector<NodeIndex> compute(const CompactGraph &graph, Method method);
+        static Locality measure(const CompactGraph &graph);
+
+        static std::string getMethodName(Method method);
+        static std::vector<Method> getAllMethods();
+    };
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include "NetworkTypes.h"
+#include "WeightCalculator.h"
+#include "CompactGraph.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <vector>
+#include <memory>
+
+namespace Domain
+{
+    class GraphSnapshot;
+    using GraphSnapshotPtr = std::shared_ptr<GraphSnapshot>;
+
+    // снимок графа с копированием при записи: общий неизменяемый CSR-базис
+    // плюс список отличий (удаленные узлы/ребра и переопределенные параметры).
+    // создание снимка O(1), снимок с k изменениями занимает O(k) памяти;
+    // копия снимка - независимая ветка сценария той же стоимости
+    class GraphSnapshot
+    {
+    public:
+        using NodeIndex = CompactGraph::NodeIndex;
+        using EdgeIndex = CompactGraph::EdgeIndex;
+
+        explicit GraphSnapshot(CompactGraphPtr base);
+
+        const CompactGraph &getBase() const { return *base; }
+        const CompactGraphPtr &getBasePtr() const { return base; }
+
+        // операции, повторяющие интерфейс NetworkGraph
+        bool hasNode(NodeId id) const;
+        bool hasEdge(NodeId source, NodeId target) const;
+        int getNodeCount() const;
+        std::vector<NodeId> getAllNodeIds() const;
+        std::optional<LinkParameters> tryGetEdgeParameters(NodeId source, NodeId target) const;
+
+        bool removeNode(NodeId id);
+        bool removeEdge(NodeId source, NodeId target);
+        bool setEdgeParameters(NodeId source, NodeId target, const LinkParameters &params);
+
+        // число записанных отличий от базового графа
+        std::size_t getChangeCount() const;
+
+        // доступ по плотным индексам базового графа (для обходов и адаптера BGL)
+        bool isNodeActive(NodeIndex u) const;
+        bool isEdgeActive(NodeIndex source, EdgeIndex e) const;
+
+        // веса только переопределенных ребер для стратегии, остальные берутся из базиса
+        std::unordered_map<EdgeIndex, double> getWeightOverrides(WeightCalculator::Strategy strategy) const;
+
+    private:
+        CompactGraphPtr base;
+        std::unordered_set<NodeIndex> removedNodes;
+        std::unordered_set<EdgeIndex> removedEdges;
+        std::unordered_map<EdgeIndex, LinkParameters> overrides;
+    };
+}
+
+#endif
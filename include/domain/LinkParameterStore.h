@@ -0,0 +1,95 @@
+#ifndef LINKPARAMETERSTORE_H
+#define LINKPARAMETERSTORE_H
+
+#include "NetworkTypes.h"
+#include "ParameterColumn.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Domain
+{
+    // хранилище параметров связей в виде параллельных массивов (structure of arrays),
+    // индекс в каждом массиве - идентификатор ребра. столбец, все значения которого равны
+    // значению по умолчанию из LinkParameters, не занимает памяти
+    class LinkParameterStore
+    {
+    public:
+        using EdgeId = std::uint32_t;
+
+        // режимы хранения (байт на ребро при всех выделенных столбцах) и допуск весов WeightCalculator:
+        // FULL_PRECISION - double, 48 байт, без потерь;
+        // FLOAT32 - float, 24 байта; относительная погрешность весов до 1e-6,
+        //   для адаптивной стратегии до 1e-5 (ветка с 1 - reliability);
+        // QUANTIZED - задержка, пропускная способность и стоимость в float, потери,
+        //   загрузка и надежность - 16-битные доли: 18 байт; относительная погрешность
+        //   весов до 1e-4, для адаптивной стратегии до 1e-3, и ветка может смениться
+        //   для значений в пределах шага квантования от порогов (загрузка 0.8, потери 0.1)
+        enum Encoding {
+            FULL_PRECISION,
+            FLOAT32,
+            QUANTIZED
+        };
+
+        enum Column {
+            LATENCY,
+            BANDWIDTH,
+            PACKET_LOSS,
+            UTILIZATION,
+            COST,
+            RELIABILITY,
+            COLUMN_COUNT
+        };
+
+        explicit LinkParameterStore(Encoding encoding = FULL_PRECISION);
+
+        // хранилище из готовых столбцов без свободных id (например, отображенных из файла);
+        // std::invalid_argument - кодировки столбцов не соответствуют режиму или разные длины
+        static LinkParameterStore fromColumns(Encoding encoding, std::array<ParameterColumn, COLUMN_COUNT> columns);
+
+        Encoding getEncoding() const { return encoding; }
+        // перекодирование всех столбцов в другой режим
+        void setEncoding(Encoding encoding);
+
+        // добавление/удаление ребра, освободившиеся id используются повторно
+        EdgeId add(const LinkParameters &params);
+        void release(EdgeId id);
+        void reserve(std::size_t count);
+        void clear();
+        // столбцы в общие блоки (см. ParameterColumn::share): копия хранилища не копирует значения
+        void share();
+
+        void set(EdgeId id, const LinkParameters &params);
+        LinkParameters get(EdgeId id) const;
+
+        double getValue(Column column, EdgeId id) const { return columns[column].get(id); }
+        void setValue(Column column, EdgeId id, double value) { columns[column].set(id, value); }
+
+        // блок значений столбца [first, first + n) для поколоночных проходов (см. ParameterColumn::read)
+        const double *readColumn(Column column, std::size_t first, std::size_t n, double *buffer) const
+        {
+            return columns[column].read(first, n, buffer);
+        }
+        bool isColumnMaterialized(Column column) const { return columns[column].isMaterialized(); }
+        const ParameterColumn &getColumn(Column column) const { return columns[column]; }
+
+        // размер диапазона id (включая освобожденные) и число занятых id
+        std::size_t size() const { return columns[LATENCY].size(); }
+        std::size_t getActiveCount() const { return size() - freeIds.size(); }
+
+        // байт на ребро в текущем режиме и в произвольном режиме при тех же выделенных столбцах
+        std::size_t getBytesPerEdge() const { return getBytesPerEdge(encoding); }
+        std::size_t getBytesPerEdge(Encoding encoding) const;
+        std::size_t getMemoryUsage() const;
+
+        static ParameterColumn::Encoding getColumnEncoding(Encoding encoding, Column column);
+        static const char *getEncodingName(Encoding encoding);
+
+    private:
+        Encoding encoding;
+        std::array<ParameterColumn, COLUMN_COUNT> columns;
+        std::vector<EdgeId> freeIds;
+    };
+}
+
+#endif
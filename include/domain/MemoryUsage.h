@@ -0,0 +1,51 @@
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Domain
+{
+    // разбивка занятой памяти по структурам данных (байты)
+    struct MemoryUsage
+    {
+        std::vector<std::pair<std::string, std::size_t>> items;
+
+        void add(const std::string &name, std::size_t bytes) { items.emplace_back(name, bytes); }
+        void add(const std::string &prefix, const MemoryUsage &other)
+        {
+            for (const auto &[name, bytes] : other.items)
+                items.emplace_back(prefix + name, bytes);
+        }
+
+        std::size_t getTotal() const
+        {
+            std::size_t total = 0;
+            for (const auto &item : items) total += item.second;
+            return total;
+        }
+    };
+
+    namespace MemoryEstimate
+    {
+        // служебный заголовок блока кучи (типичный для 64-битных аллокаторов)
+        constexpr std::size_t HEAP_OVERHEAD = 16;
+
+        template <typename T>
+        std::size_t of(const std::vector<T> &v) { return v.capacity() * sizeof(T); }
+
+        // оценка для узловой хэш-таблицы: массив корзин + узел (указатель, значение, кэш хэша) на элемент
+        template <typename K, typename V, typename H, typename E, typename A>
+        std::size_t of(const std::unordered_map<K, V, H, E, A> &m)
+        {
+            using Value = typename std::unordered_map<K, V, H, E, A>::value_type;
+            return m.bucket_count() * sizeof(void *) +
+                   m.size() * (sizeof(void *) + sizeof(Value) + sizeof(std::size_t) + HEAP_OVERHEAD);
+        }
+    }
+}
+
+#endif
@@ -3,48 +3,246 @@
 
 #include "NetworkTypes.h"
 #include "WeightCalculator.h"
+#include "CompactGraph.h"
+#include "GeometricHeuristic.h"
+#include "NodeCoordinates.h"
+#include "GraphOrdering.h"
+#include "GraphSnapshot.h"
+#include "LinkParameterStore.h"
+#include "MemoryUsage.h"
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <cstdint>
+#include <optional>
+#include <iterator>
 
 namespace Domain
 {
     class NetworkGraph
     {
     public:
-        using AdjMap = std::unordered_map<int, std::unordered_map<int, LinkParameters>>;
+        using EdgeId = LinkParameterStore::EdgeId;
+        // строка смежности по плотным индексам: сосед -> id ребра, параметры лежат в parameters по столбцам;
+        // тот же тип используется для обратного индекса (источник -> id ребра)
+        using AdjRow = std::unordered_map<NodeIndex, EdgeId>;
 
-        NetworkGraph(const std::string &name = "network");
+        // ребро, читаемое прямо из хранилища графа (без копирования параметров);
+        // для входящих ребер getNeighbor() - источник ребра
+        class EdgeRef
+        {
+        public:
+            EdgeRef(NodeIndex neighbor, EdgeId id, const NetworkGraph *graph)
+                : neighbor(neighbor), id(id), graph(graph) {}
+
+            NodeId getTarget() const { return graph->nodeIds[neighbor]; }
+            NodeId getNeighbor() const { return graph->nodeIds[neighbor]; }
+            NodeIndex getNeighborIndex() const { return neighbor; }
+            EdgeId getId() const { return id; }
+            double getValue(LinkParameterStore::Column column) const { return graph->parameters.getValue(column, id); }
+            LinkParameters getParameters() const { return graph->parameters.get(id); }
+
+        private:
+            NodeIndex neighbor;
+            EdgeId id;
+            const NetworkGraph *graph;
+        };
+
+        class NeighborIterator
+        {
+        public:
+            using InnerIterator = AdjRow::const_iterator;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = EdgeRef;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = EdgeRef;
+
+            NeighborIterator() = default;
+            NeighborIterator(InnerIterator it, const NetworkGraph *graph) : it(it), graph(graph) {}
+
+            EdgeRef operator*() const { return EdgeRef(it->first, it->second, graph); }
+            NeighborIterator &operator++() { ++it; return *this; }
+            NeighborIterator operator++(int) { auto copy = *this; ++it; return copy; }
+            bool operator==(const NeighborIterator &other) const { return it == other.it; }
+            bool operator!=(const NeighborIterator &other) const { return it != other.it; }
+
+        private:
+            InnerIterator it;
+            const NetworkGraph *graph = nullptr;
+        };
+
+        // невладеющее представление соседей вершины, действительно до следующего изменения графа
+        class NeighborRange
+        {
+        public:
+            NeighborRange() = default;
+            NeighborRange(const AdjRow *edges, const NetworkGraph *graph)
+                : edges(edges), graph(graph) {}
+
+            NeighborIterator begin() const { return edges ? NeighborIterator(edges->begin(), graph) : NeighborIterator(); }
+            NeighborIterator end() const { return edges ? NeighborIterator(edges->end(), graph) : NeighborIterator(); }
+            std::size_t size() const { return edges ? edges->size() : 0; }
+            bool empty() const { return size() == 0; }
+
+        private:
+            const AdjRow *edges = nullptr;
+            const NetworkGraph *graph = nullptr;
+        };
+
+        NetworkGraph(const std::string &name = "network",
+                     LinkParameterStore::Encoding encoding = LinkParameterStore::FULL_PRECISION);
         
         // базовые операции с узлами
-        void addNode(int id, const std::string &name = "");
-        void ensureNode(int id);
+        void addNode(NodeId id, const std::string &name = "");
+        void ensureNode(NodeId id);
         
         // две версии добавления ребер
-        void addEdge(int source, int target, const LinkParameters &params);
-        void addEdge(int source, int target, double weight = 1.0);
+        void addEdge(NodeId source, NodeId target, const LinkParameters &params);
+        void addEdge(NodeId source, NodeId target, double weight = 1.0);
+
+        // пакетная загрузка: хранилища резервируются один раз под весь пакет, повторы ребра
+        // схлопываются (побеждает последняя запись, как при последовательных addEdge)
+        void addEdges(const EdgeRecord *edges, std::size_t count);
+        void addEdges(const std::vector<EdgeRecord> &edges) { addEdges(edges.data(), edges.size()); }
+        void reserve(std::size_t node_count, std::size_t edge_count);
         
         // операции с графом
-        bool hasNode(int id) const;
-        std::vector<int> getNeighbors(int node_id) const;
-        double getEdgeWeight(int source, int target) const;
-        double getEdgeWeight(int source, int target, WeightCalculator::Strategy strategy) const;
-        LinkParameters getEdgeParameters(int source, int target) const;
+        bool hasNode(NodeId id) const;
+        std::vector<NodeId> getNeighbors(NodeId node_id) const;
+        double getEdgeWeight(NodeId source, NodeId target) const;
+        double getEdgeWeight(NodeId source, NodeId target, WeightCalculator::Strategy strategy) const;
+        LinkParameters getEdgeParameters(NodeId source, NodeId target) const;
+
+        // неаллоцирующий обход соседей и поиск ребер без исключений
+        NeighborRange neighbors(NodeId node_id) const noexcept;
+        std::size_t getOutDegree(NodeId node_id) const noexcept;
+        std::optional<EdgeId> findEdge(NodeId source, NodeId target) const noexcept;
+        std::optional<LinkParameters> tryGetEdgeParameters(NodeId source, NodeId target) const noexcept;
+
+        // входящие ребра по обратному индексу (для обратных поисков и запросов предшественников)
+        NeighborRange inNeighbors(NodeId node_id) const noexcept;
+        std::size_t getInDegree(NodeId node_id) const noexcept;
+        std::vector<NodeId> getPredecessors(NodeId node_id) const;
+
+        // стабильные плотные индексы узлов 0..getIndexBound()-1: индекс не меняется, пока узел
+        // существует, освободившиеся индексы переиспользуются. решатели работают в индексах
+        // и переводят их во внешние id только на границе API
+        NodeIndex findIndex(NodeId id) const noexcept;
+        NodeId getNodeId(NodeIndex index) const { return nodeIds[index]; }
+        bool isActiveIndex(NodeIndex index) const noexcept { return index < active.size() && active[index]; }
+        std::size_t getIndexBound() const { return nodeIds.size(); }
+        NeighborRange neighborsAt(NodeIndex index) const noexcept;
+        NeighborRange inNeighborsAt(NodeIndex index) const noexcept;
+        std::optional<EdgeId> findEdgeAt(NodeIndex source, NodeIndex target) const noexcept;
+
+        // обновление параметров существующего ребра (false, если ребра нет)
+        bool setEdgeParameters(NodeId source, NodeId target, const LinkParameters &params);
+        bool setEdgeParameter(NodeId source, NodeId target, LinkParameterStore::Column column, double value);
+
+        // веса всех ребер по id ребра для стратегии: массив строится при первом обращении,
+        // а после изменений графа пересчитываются только затронутые ребра
+        const std::vector<double> &getEdgeWeights(WeightCalculator::Strategy strategy) const;
+
+        // режим хранения параметров ребер (см. LinkParameterStore::Encoding);
+        // смена режима перекодирует параметры и сбрасывает кэши весов
+        LinkParameterStore::Encoding getParameterEncoding() const { return parameters.getEncoding(); }
+        void setParameterEncoding(LinkParameterStore::Encoding encoding);
+        const LinkParameterStore &getParameterStore() const { return parameters; }
+
+        // счетчик изменений графа (растет при любой мутации)
+        std::uint64_t getVersion() const { return version; }
         
+        // память по структурам графа (хэш-таблицы - оценка); CSR-снимок учитывается отдельной строкой
+        MemoryUsage getMemoryUsage() const;
+        std::size_t getEdgeCount() const { return parameters.getActiveCount(); }
+
         // информация о графе
         int getNodeCount() const;
         std::string getInfo() const;
-        std::vector<int> getAllNodeIds() const;
-        bool removeNode(int id);
-        bool removeEdge(int from, int to);
+        std::vector<NodeId> getAllNodeIds() const;
+        bool removeNode(NodeId id);
+        bool removeEdge(NodeId from, NodeId to);
         NetworkGraphPtr createSnapshot() const;
 
+        // легкий снимок для сценариев "что если": разделяет CSR-базис и хранит только отличия
+        GraphSnapshotPtr createOverlaySnapshot() const;
+
+        // нумерация вершин CSR-снимков для локальности обходов (внешние id не меняются)
+        GraphOrdering::Method getNodeOrdering() const { return nodeOrdering; }
+        void setNodeOrdering(GraphOrdering::Method method);
+
+        // CSR-снимок текущего состояния, строится лениво; если с прошлого снимка менялись
+        // только параметры ребер, топология копируется и пересчитываются лишь эти ребра
+        CompactGraphPtr getCompactGraph() const;
+
+        // готовый CSR-снимок текущего состояния (например, отображенный из файла) вместо построения;
+        // сверяются вершины и ребра, но не параметры. std::invalid_argument - снимок другого графа
+        void adoptCompactGraph(CompactGraphPtr compact);
+
+        // координаты узлов для геометрической эвристики A*; nullptr - координат нет
+        void setCoordinates(NodeCoordinatesPtr coordinates);
+        NodeCoordinatesPtr getCoordinates() const;
+
+        // эвристика стратегии для снимка compact, строится и проверяется при первом запросе;
+        // nullptr - у графа нет координат
+        GeometricHeuristicPtr getGeometricHeuristic(const CompactGraphPtr &compact,
+                                                    WeightCalculator::Strategy strategy) const;
+
     private:
+        friend class CompactGraph;
+
+        struct WeightChange {
+            std::uint64_t version;
+            EdgeId edge;
+        };
+
+        struct WeightCache {
+            std::uint64_t version = 0;
+            bool built = false;
+            std::vector<double> weights;
+        };
+
+        struct HeuristicCache {
+            std::weak_ptr<const CompactGraph> graph;   // снимок, для которого построена эвристика
+            GeometricHeuristicPtr heuristic;
+        };
+
+        // регистрация мутации; для изменения параметров ребра - с записью в журнал
+        void markChanged();
+        void markEdgeChanged(EdgeId edge);
+        void trimJournal();    // удаление записей журнала, учтенных всеми кэшами весов и CSR-снимком
+        EdgeId findEdgeId(NodeId source, NodeId target) const;
+        NodeIndex acquireIndex(NodeId id);
+
         std::string name;
-        AdjMap adjacency;
-        std::unordered_set<int> nodes;
+        std::vector<NodeId> nodeIds;                    // индекс -> внешний id
+        std::vector<std::uint8_t> active;               // 0 - индекс свободен
+        std::unordered_map<NodeId, NodeIndex> indexById;
+        std::vector<NodeIndex> freeIndices;
+        std::vector<AdjRow> adjacency;                  // исходящие ребра по индексу узла
+        std::vector<AdjRow> reverseAdjacency;           // входящие ребра по индексу узла
+        LinkParameterStore parameters;
+        GraphOrdering::Method nodeOrdering = GraphOrdering::ID_ORDER;
+
+        std::uint64_t version = 0;
+        std::uint64_t structureVersion = 0;    // последнее изменение узлов или ребер
+        std::uint64_t journalStart = 0;        // журнал покрывает изменения после этой версии
+        std::vector<WeightChange> weightJournal;
+
+        mutable std::mutex weightsMutex;
+        mutable std::unordered_map<int, WeightCache> weightCaches;
+
+        mutable std::mutex compactMutex;
+        mutable CompactGraphPtr compactCache;
+        mutable std::uint64_t compactVersion = 0;
+        mutable std::vector<CompactGraph::EdgeIndex> compactEdgeIndex;   // id ребра -> индекс в compactCache
+
+        mutable std::mutex heuristicMutex;
+        NodeCoordinatesPtr coordinates;
+        mutable std::unordered_map<int, HeuristicCache> heuristicCaches;
     };
 }
 
@@ -4,9 +4,18 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <limits>
+#include <utility>
 
 namespace Domain
 {
+    // внешний id узла (64 бита - для крупных разреженных id) и плотный внутренний индекс
+    using NodeId = std::int64_t;
+    using NodeIndex = std::uint32_t;
+    constexpr NodeIndex INVALID_NODE_INDEX = std::numeric_limits<NodeIndex>::max();
+    using NodePair = std::pair<NodeId, NodeId>;   // маршрут или ребро (откуда, куда)
+
     class NetworkGraph;
     using NetworkGraphPtr = std::shared_ptr<NetworkGraph>;
 
@@ -22,15 +31,27 @@ namespace Domain
         LinkParameters(double weight) : latency(weight), cost(weight) {}
     };
 
+    // запись ребра для пакетной загрузки графа
+    struct EdgeRecord {
+        NodeId source = 0;
+        NodeId target = 0;
+        LinkParameters params;
+        EdgeRecord() = default;
+        EdgeRecord(NodeId source, NodeId target, const LinkParameters &params)
+            : source(source), target(target), params(params) {}
+    };
+
     // результат поиска пути в графе
     struct PathResult
     {
-        bool success = false;       // успешно ли найден путь
-        std::string errorMessage;   // сообщение об ошибке, если путь не найден
-        std::vector<int> pathNodes; // последовательность вершин в найденном пути
-        double totalCost = 0.0;     // общая стоимость пути
-        std::string algorithmName;  // название использованного алгоритма
-        double executionTime = 0.0; // время выполнения в ms
+        bool success = false;          // успешно ли найден путь
+        std::string errorMessage;      // сообщение об ошибке, если путь не найден
+        std::vector<NodeId> pathNodes; // последовательность вершин в найденном пути
+        double totalCost = 0.0;        // общая стоимость пути
+        std::string algorithmName;     // название использованного алгоритма
+        double executionTime = 0.0;    // время выполнения в ms
+        std::size_t scratchBytes = 0;  // рабочая память алгоритма на один запрос (байты, оценка)
+        std::size_t settledNodes = 0;  // вершин извлечено из очереди (A*), 0 - не считается
         // конструктор по умолчанию для корректной работы с STL
         PathResult() = default;
     };
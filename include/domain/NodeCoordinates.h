@@ -0,0 +1,63 @@
+#ifndef NODECOORDINATES_H
+#define NODECOORDINATES_H
+
+#include "NetworkTypes.h"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Domain
+{
+    class NodeCoordinates;
+    using NodeCoordinatesPtr = std::shared_ptr<const NodeCoordinates>;
+
+    // координаты узлов графа для геометрической эвристики A*. хранятся компактно:
+    // id по возрастанию и точки в том же порядке, поиск - двоичный
+    class NodeCoordinates
+    {
+    public:
+        enum System {
+            PLANAR,        // (x, y), евклидово расстояние в единицах координат
+            GEOGRAPHIC     // x - долгота, y - широта в градусах; расстояние в км
+        };
+
+        struct Point
+        {
+            double x = 0.0;
+            double y = 0.0;
+        };
+
+        // точка в пространстве, где расстояние евклидово: плоская - (x, y, 0),
+        // географическая - на сфере радиуса Земли (хорда не длиннее дуги и тоже метрика)
+        struct Position
+        {
+            double x = 0.0;
+            double y = 0.0;
+            double z = 0.0;
+        };
+
+        static constexpr double EARTH_RADIUS_KM = 6371.0088;
+
+        // повтор id - остается последняя точка. std::invalid_argument - координата не конечна
+        // или (для GEOGRAPHIC) широта вне [-90, 90], долгота вне [-180, 180]
+        NodeCoordinates(System system, std::vector<std::pair<NodeId, Point>> points);
+
+        System getSystem() const { return system; }
+        std::size_t size() const { return ids.size(); }
+
+        // nullptr - координат узла нет
+        const Point *find(NodeId id) const;
+
+        Position toPosition(const Point &point) const;
+
+        static double distance(const Position &a, const Position &b);
+
+    private:
+        System system;
+        std::vector<NodeId> ids;
+        std::vector<Point> points;
+    };
+}
+
+#endif
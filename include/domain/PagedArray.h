@@ -0,0 +1,145 @@
+#ifndef PAGEDARRAY_H
+#define PAGEDARRAY_H
+
+#include "ArrayStorage.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Domain
+{
+    // массив с копированием при записи по страницам поверх сплошной основы ArrayStorage.
+    // если основа - представление (общий блок после share или отображенный файл), запись копирует
+    // только затронутую страницу из PAGE_SIZE элементов; копия массива разделяет с оригиналом основу
+    // и все страницы, копируется лишь таблица страниц. собственная основа меняется на месте.
+    // пока ни одна страница не заменена, элементы лежат подряд (data())
+    template <typename T>
+    class PagedArray
+    {
+    public:
+        static constexpr std::size_t PAGE_SHIFT = 10;
+        static constexpr std::size_t PAGE_SIZE = std::size_t(1) << PAGE_SHIFT;
+
+        PagedArray() = default;
+        explicit PagedArray(ArrayStorage<T> values) : base(std::move(values)) {}
+
+        // представление count элементов по адресу data без копирования (см. ArrayStorage::view)
+        static PagedArray view(const T *data, std::size_t count, std::shared_ptr<const void> backing)
+        {
+            return PagedArray(ArrayStorage<T>::view(data, count, std::move(backing)));
+        }
+
+        std::size_t size() const { return base.size(); }
+        bool empty() const { return base.empty(); }
+        // элементы подряд; nullptr, если часть страниц заменена
+        const T *data() const { return pages.empty() ? base.data() : nullptr; }
+
+        const T &operator[](std::size_t index) const
+        {
+            if (pages.empty()) return base[index];
+            const auto &page = pages[index >> PAGE_SHIFT];
+            return page ? page[index & PAGE_MASK] : base[index];
+        }
+
+        // элементы [first, first + n) подряд: из основы или одной страницы; nullptr - диапазон пересекает
+        // границу замененной страницы
+        const T *range(std::size_t first, std::size_t n) const
+        {
+            if (pages.empty()) return base.data() + first;
+            const std::size_t page = first >> PAGE_SHIFT;
+            const std::size_t last = n ? (first + n - 1) >> PAGE_SHIFT : page;
+            if (pages[page] && last == page) return pages[page].get() + (first & PAGE_MASK);
+            for (std::size_t p = page; p <= last; ++p)
+                if (pages[p]) return nullptr;
+            return base.data() + first;
+        }
+
+        void set(std::size_t index, const T &value)
+        {
+            if (!base.isView())
+                base[index] = value;
+            else
+                writablePage(index >> PAGE_SHIFT)[index & PAGE_MASK] = value;
+        }
+
+        // изменение размера сначала собирает замененные страницы в собственную основу
+        void push_back(const T &value)
+        {
+            flatten();
+            base.push_back(value);
+        }
+
+        void reserve(std::size_t size)
+        {
+            flatten();
+            base.reserve(size);
+        }
+
+        void resize(std::size_t size, const T &value = T())
+        {
+            flatten();
+            base.resize(size, value);
+        }
+
+        void reset()
+        {
+            std::vector<std::shared_ptr<T[]>>().swap(pages);
+            base.reset();
+        }
+
+        // основа в общий блок (см. ArrayStorage::share): дальнейшие копии не копируют элементы
+        void share() { base.share(); }
+
+        // байты в куче процесса: основа (см. ArrayStorage::getMemoryUsage), таблица и замененные страницы;
+        // страницы, общие с другими копиями, учитываются в каждой
+        std::size_t getMemoryUsage() const
+        {
+            std::size_t bytes = base.getMemoryUsage() + pages.capacity() * sizeof(std::shared_ptr<T[]>);
+            for (std::size_t p = 0; p < pages.size(); ++p)
+                if (pages[p]) bytes += pageLength(p) * sizeof(T);
+            return bytes;
+        }
+
+    private:
+        static constexpr std::size_t PAGE_MASK = PAGE_SIZE - 1;
+
+        std::size_t pageLength(std::size_t page) const
+        {
+            return std::min(PAGE_SIZE, size() - (page << PAGE_SHIFT));
+        }
+
+        // страница, которой владеет только этот массив (общая или еще не замененная копируется)
+        T *writablePage(std::size_t page)
+        {
+            if (pages.empty())
+                pages.resize((size() + PAGE_SIZE - 1) >> PAGE_SHIFT);
+            auto &slot = pages[page];
+            if (!slot || slot.use_count() > 1)
+            {
+                const std::size_t length = pageLength(page);
+                std::shared_ptr<T[]> copy(new T[length]);
+                const T *source = slot ? slot.get() : base.data() + (page << PAGE_SHIFT);
+                std::copy(source, source + length, copy.get());
+                slot = std::move(copy);
+            }
+            return slot.get();
+        }
+
+        void flatten()
+        {
+            if (pages.empty()) return;
+            std::vector<T> values(base.begin(), base.end());
+            for (std::size_t p = 0; p < pages.size(); ++p)
+                if (pages[p])
+                    std::copy(pages[p].get(), pages[p].get() + pageLength(p), values.begin() + (p << PAGE_SHIFT));
+            std::vector<std::shared_ptr<T[]>>().swap(pages);
+            base = ArrayStorage<T>(std::move(values));
+        }
+
+        ArrayStorage<T> base;
+        std::vector<std::shared_ptr<T[]>> pages;   // пусто или по числу страниц; nullptr - страница основы
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef PARAMETERCOLUMN_H
+#define PARAMETERCOLUMN_H
+
+#include "PagedArray.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Domain
+{
+    // столбец значений одного параметра связей с выбранной кодировкой.
+    // пока все значения равны значению по умолчанию, память под столбец не выделяется
+    class ParameterColumn
+    {
+    public:
+        enum Encoding {
+            FLOAT64,      // без потерь
+            FLOAT32,      // относительная погрешность до 2^-24 (~6e-8)
+            FRACTION16    // доля 0..1 с шагом 1/65535, абсолютная погрешность до 7.7e-6; значения вне 0..1 обрезаются
+        };
+
+        explicit ParameterColumn(Encoding encoding = FLOAT64, double default_value = 0.0)
+            : encoding(encoding), defaultValue(default_value) {}
+
+        // выделенный столбец поверх готовых значений в кодировке encoding (count элементов по адресу data);
+        // память не копируется, пока столбец не изменяют, backing удерживает ее владельца
+        static ParameterColumn view(Encoding encoding, double default_value, const void *data, std::size_t count,
+                                    std::shared_ptr<const void> backing);
+
+        Encoding getEncoding() const { return encoding; }
+        double getDefaultValue() const { return defaultValue; }
+        bool isMaterialized() const { return materialized; }
+        std::size_t size() const { return count; }
+        // закодированные значения подряд (size() * getEncodedSize(getEncoding()) байт); nullptr для невыделенного
+        // столбца и для копии, в которой часть страниц заменена (см. PagedArray)
+        const void *getData() const;
+
+        double get(std::size_t index) const
+        {
+            if (!materialized) return defaultValue;
+            switch (encoding)
+            {
+            case FLOAT32: return f32[index];
+            case FRACTION16: return q16[index] * (1.0 / FRACTION_SCALE);
+            default: return f64[index];
+            }
+        }
+
+        void set(std::size_t index, double value)
+        {
+            if (!materialized)
+            {
+                if (value == defaultValue) return;
+                materialize();
+            }
+            store(index, value);
+        }
+
+        void push(double value);
+        void resize(std::size_t size);
+        void reserve(std::size_t size);
+        void clear();
+        // значения в общие блоки: копии столбца не копируют их, запись в копию заменяет одну страницу
+        void share();
+
+        // значения страницы page (PagedArray::PAGE_SIZE элементов, последняя может быть короче) подряд
+        // без копирования; nullptr - столбец не выделен или хранится не в FLOAT64
+        const double *getPage(std::size_t page) const
+        {
+            if (!materialized || encoding != FLOAT64) return nullptr;
+            const std::size_t first = page << PagedArray<double>::PAGE_SHIFT;
+            return f64.range(first, std::min(PagedArray<double>::PAGE_SIZE, count - first));
+        }
+
+        // значения [first, first + n) в double: для FLOAT64 - указатель прямо в столбец, если диапазон
+        // лежит подряд, иначе значения декодируются в buffer (не меньше n элементов)
+        const double *read(std::size_t first, std::size_t n, double *buffer) const;
+
+        // тот же столбец в другой кодировке
+        ParameterColumn reencode(Encoding target) const;
+
+        // байт на значение (0, если столбец не выделен) и занятая память
+        std::size_t getBytesPerValue() const { return materialized ? getEncodedSize(encoding) : 0; }
+        std::size_t getMemoryUsage() const;
+        static std::size_t getEncodedSize(Encoding encoding);
+        // count значений в кодировке encoding так, как их хранит столбец (count * getEncodedSize байт в out)
+        static void encode(Encoding encoding, const double *values, std::size_t count, void *out);
+
+    private:
+        static constexpr double FRACTION_SCALE = 65535.0;
+
+        void materialize();
+        void store(std::size_t index, double value)
+        {
+            switch (encoding)
+            {
+            case FLOAT32: f32.set(index, static_cast<float>(value)); break;
+            case FRACTION16: q16.set(index, quantize(value)); break;
+            default: f64.set(index, value); break;
+            }
+        }
+        static std::uint16_t quantize(double value)
+        {
+            if (!(value > 0.0)) return 0;
+            if (value >= 1.0) return static_cast<std::uint16_t>(FRACTION_SCALE);
+            return static_cast<std::uint16_t>(std::lround(value * FRACTION_SCALE));
+        }
+
+        Encoding encoding;
+        double defaultValue;
+        bool materialized = false;
+        std::size_t count = 0;
+        PagedArray<double> f64;
+        PagedArray<float> f32;
+        PagedArray<std::uint16_t> q16;
+    };
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef PARAMETERSYNTHESIZER_H
+#define PARAMETERSYNTHESIZER_H
+
+#include "NetworkTypes.h"
+#include <cstdint>
+
+namespace Domain
+{
+    // синтез правдоподобных параметров связи для графов, где в файле есть только вес.
+    // генератор счетный: значения ребра - хэш от (seed, источник, цель, номер параметра), поэтому
+    // не зависят от порядка разбора, считаются независимо в параллельных кусках и могут быть
+    // получены заново в любой момент без хранения. один seed - один и тот же граф в каждом запуске
+    class ParameterSynthesizer
+    {
+    public:
+        static constexpr std::uint64_t DEFAULT_SEED = 0x6e6574677261ULL;
+
+        explicit ParameterSynthesizer(std::uint64_t seed = DEFAULT_SEED) : seed(seed) {}
+
+        std::uint64_t getSeed() const { return seed; }
+
+        // latency - вес из файла; стоимость пропорциональна ему, остальные параметры от него не зависят
+        LinkParameters synthesize(NodeId source, NodeId target, double latency) const;
+
+        // равномерное значение [0, 1) параметра counter ребра source -> target
+        double uniform(NodeId source, NodeId target, unsigned counter) const;
+
+    private:
+        std::uint64_t edgeKey(NodeId source, NodeId target) const;
+
+        std::uint64_t seed;
+    };
+}
+
+#endif
@@ -2,26 +2,65 @@
 #define WEIGHTCALCULATOR_H
 
 #include "NetworkTypes.h"
+#include "LinkParameterStore.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
 
 namespace Domain
 {
+    class CustomStrategy;
+
     class WeightCalculator
     {
     public:
-        enum Strategy {
+        // значения от CUSTOM_STRATEGY_BASE выдаются пользовательским стратегиям при регистрации
+        enum Strategy : int {
             UNIFORM_WEIGHTS,    // все веса = 1
             MINIMIZE_LATENCY,   // минимизация задержки
             BALANCE_LOAD,       // балансировка нагрузки
             MAXIMIZE_BANDWIDTH, // максимизация пропускной способности
             MINIMIZE_COST,      // минимизация стоимости
-            ADAPTIVE_WEIGHTS    // адаптивная стратегия
+            ADAPTIVE_WEIGHTS,   // адаптивная стратегия
+            CUSTOM_STRATEGY_BASE = 100
+        };
+        static constexpr int MAX_CUSTOM_STRATEGIES = 64;
+
+        // набор инструкций для пакетного расчета весов
+        enum InstructionSet {
+            SCALAR_KERNEL,
+            AVX2_KERNEL,     // 4 значения double за операцию
+            AVX512_KERNEL    // 8 значений double за операцию
+        };
+
+        // столбцы параметров пачки ребер (структура массивов); столбцы, не нужные стратегии, могут быть nullptr
+        struct ParameterColumns {
+            const double *latency = nullptr;
+            const double *bandwidth = nullptr;
+            const double *packet_loss = nullptr;
+            const double *utilization = nullptr;
+            const double *cost = nullptr;
+            const double *reliability = nullptr;
         };
 
         // основная функция агрегации
         static double calculateCompositeWeight(const LinkParameters& params, Strategy strategy);
+
+        // пакетный расчет весов всех ребер хранилища, читаются только нужные стратегии столбцы
+        static void calculateWeights(const LinkParameterStore& store, Strategy strategy, std::vector<double>& weights);
+
+        // веса count ребер по столбцам параметров; результат совпадает с calculateCompositeWeight
+        // побитово при любом наборе инструкций
+        static void calculateBatch(const ParameterColumns& columns, std::size_t count, Strategy strategy, double* out);
+        static void calculateBatch(const ParameterColumns& columns, std::size_t count, Strategy strategy, double* out,
+                                   InstructionSet isa);
+
+        // лучший набор инструкций, поддерживаемый процессором и ОС (определяется один раз)
+        static InstructionSet getSupportedInstructionSet();
+        // набор для calculateBatch без явного указания; не выше поддерживаемого
+        static InstructionSet getInstructionSet();
+        static void setInstructionSet(InstructionSet isa);
+        static std::string getInstructionSetName(InstructionSet isa);
         
         // анализ влияния параметров
         static void analyzeParameterDependencies(const LinkParameters& params);
@@ -30,6 +69,12 @@ namespace Domain
         static std::string getStrategyDescription(Strategy strategy);
         static std::vector<Strategy> getAllStrategies();
 
+        // регистрация скомпилированной пользовательской стратегии; повторная регистрация того же
+        // описания возвращает прежнее значение. std::length_error - исчерпан MAX_CUSTOM_STRATEGIES
+        static Strategy registerStrategy(const CustomStrategy& strategy);
+        // nullptr для встроенных стратегий
+        static const CustomStrategy* getCustomStrategy(Strategy strategy);
+
     private:
         // приватные методы для разных стратегий
         static double calculateUniformWeight();
@@ -38,6 +83,18 @@ namespace Domain
         static double calculateBandwidthWeight(const LinkParameters& params);
         static double calculateCostWeight(const LinkParameters& params);
         static double calculateAdaptiveWeight(const LinkParameters& params);
+
+        // те же формулы над отдельными значениями (для поколоночного расчета)
+        static double calculateBalancedWeight(double latency, double bandwidth, double packet_loss,
+                                              double utilization, double cost);
+        static double calculateAdaptiveWeight(double latency, double bandwidth, double packet_loss,
+                                              double utilization, double cost, double reliability);
+
+        // векторные ядра (WeightKernels.cpp): сравнения и деления над регистрами целиком, без ветвлений по ребрам
+        static void calculateBatchScalar(const ParameterColumns& columns, std::size_t first, std::size_t count,
+                                         Strategy strategy, double* out);
+        static void calculateBatchAvx2(const ParameterColumns& columns, std::size_t count, Strategy strategy, double* out);
+        static void calculateBatchAvx512(const ParameterColumns& columns, std::size_t count, Strategy strategy, double* out);
         
         // функции для моделирования зависимостей
         static double calculateEffectiveLatency(double base_latency, double utilization);
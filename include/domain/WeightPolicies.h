@@ -0,0 +1,254 @@
+#ifndef WEIGHTPOLICIES_H
+#define WEIGHTPOLICIES_H
+
+#include "WeightCalculator.h"
+#include "CustomStrategy.h"
+#include "LinkParameterStore.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Domain
+{
+    // стратегии весов как типы: ядро поиска, параметризованное политикой, считает вес ребра
+    // прямо из столбцов параметров без выбора стратегии на каждом ребре.
+    // формулы здесь - единственный источник, WeightCalculator использует их же
+    namespace WeightPolicy
+    {
+        using Columns = WeightCalculator::ParameterColumns;
+        using EdgeIndex = std::uint32_t;
+
+        constexpr unsigned columnBit(LinkParameterStore::Column column) { return 1u << column; }
+
+        // моделирование взаимовлияния параметров
+        inline double effectiveLatency(double base_latency, double utilization)
+        {
+            // задержка растет нелинейно при высокой загрузке
+            return base_latency * (1.0 + 3.0 * utilization * utilization);
+        }
+
+        inline double currentBandwidth(double max_bandwidth, double packet_loss)
+        {
+            // эффективная пропускная способность уменьшается из-за потерь
+            return max_bandwidth * (1.0 - packet_loss);
+        }
+
+        inline double dynamicReliability(double packet_loss, double utilization)
+        {
+            // надежность падает при высоких потерях и загрузке
+            double penalty = packet_loss * 0.7 + utilization * 0.3;
+            return std::max(0.0, 1.0 - penalty);
+        }
+
+        // столбцы хранилища без копирования для ядер поиска (см. ParameterView):
+        // PagedColumns - таблица начал страниц каждого столбца FLOAT64 (страницы основы, замененные
+        // страницы или одна страница значений по умолчанию для невыделенного столбца);
+        // EncodedColumns - ParameterColumn::get на каждом обращении (хранилище в сжатых кодировках)
+        struct PagedColumns
+        {
+            struct Reader
+            {
+                static constexpr std::size_t PAGE_SHIFT = PagedArray<double>::PAGE_SHIFT;
+                static constexpr std::size_t PAGE_MASK = PagedArray<double>::PAGE_SIZE - 1;
+
+                const double *const *pages = nullptr;
+                double operator[](EdgeIndex e) const { return pages[e >> PAGE_SHIFT][e & PAGE_MASK]; }
+            };
+
+            Reader latency, bandwidth, packet_loss, utilization, cost, reliability;
+        };
+
+        struct EncodedColumns
+        {
+            struct Reader
+            {
+                const ParameterColumn *column = nullptr;
+                double operator[](EdgeIndex e) const { return column->get(e); }
+            };
+
+            Reader latency, bandwidth, packet_loss, utilization, cost, reliability;
+        };
+
+        struct Uniform
+        {
+            static constexpr WeightCalculator::Strategy STRATEGY = WeightCalculator::UNIFORM_WEIGHTS;
+            static constexpr unsigned COLUMNS = 0;
+            template <typename C>
+            static double weight(const C &, EdgeIndex) { return 1.0; }
+        };
+
+        struct Latency
+        {
+            static constexpr WeightCalculator::Strategy STRATEGY = WeightCalculator::MINIMIZE_LATENCY;
+            static constexpr unsigned COLUMNS = columnBit(LinkParameterStore::LATENCY);
+            template <typename C>
+            static double weight(const C &c, EdgeIndex e) { return c.latency[e]; }
+        };
+
+        struct Balanced
+        {
+            static constexpr WeightCalculator::Strategy STRATEGY = WeightCalculator::BALANCE_LOAD;
+            static constexpr unsigned COLUMNS = columnBit(LinkParameterStore::LATENCY) | columnBit(LinkParameterStore::BANDWIDTH) |
+                                                columnBit(LinkParameterStore::PACKET_LOSS) | columnBit(LinkParameterStore::UTILIZATION) |
+                                                columnBit(LinkParameterStore::COST);
+
+            static double evaluate(double latency, double bandwidth, double packet_loss, double utilization, double cost)
+            {
+                // композитный вес с учетом взаимовлияния параметров
+                return effectiveLatency(latency, utilization) * 0.5 +
+                       (1.0 / currentBandwidth(bandwidth, packet_loss)) * 0.2 +
+                       cost * 0.15 +
+                       (1.0 - dynamicReliability(packet_loss, utilization)) * 0.15;
+            }
+
+            template <typename C>
+            static double weight(const C &c, EdgeIndex e)
+            {
+                return evaluate(c.latency[e], c.bandwidth[e], c.packet_loss[e], c.utilization[e], c.cost[e]);
+            }
+        };
+
+        struct Bandwidth
+        {
+            static constexpr WeightCalculator::Strategy STRATEGY = WeightCalculator::MAXIMIZE_BANDWIDTH;
+            static constexpr unsigned COLUMNS = columnBit(LinkParameterStore::BANDWIDTH);
+            template <typename C>
+            static double weight(const C &c, EdgeIndex e) { return 1.0 / c.bandwidth[e]; }
+        };
+
+        struct Cost
+        {
+            static constexpr WeightCalculator::Strategy STRATEGY = WeightCalculator::MINIMIZE_COST;
+            static constexpr unsigned COLUMNS = columnBit(LinkParameterStore::COST);
+            template <typename C>
+            static double weight(const C &c, EdgeIndex e) { return c.cost[e]; }
+        };
+
+        struct Adaptive
+        {
+            static constexpr WeightCalculator::Strategy STRATEGY = WeightCalculator::ADAPTIVE_WEIGHTS;
+            static constexpr unsigned COLUMNS = Balanced::COLUMNS | columnBit(LinkParameterStore::RELIABILITY);
+            static constexpr double HIGH_UTILIZATION = 0.8;
+            static constexpr double HIGH_PACKET_LOSS = 0.1;
+
+            // без ветвлений: считаются все три ветки, затем выбор по условиям
+            // (при высокой загрузке - надежность, при высоких потерях - пропускная способность)
+            static double evaluate(double latency, double bandwidth, double packet_loss,
+                                   double utilization, double cost, double reliability)
+            {
+                double res = Balanced::evaluate(latency, bandwidth, packet_loss, utilization, cost);
+                double lossy = 1.0 / bandwidth;
+                double loaded = (1.0 - reliability) * 100.0;
+                res = packet_loss > HIGH_PACKET_LOSS ? lossy : res;
+                return utilization > HIGH_UTILIZATION ? loaded : res;
+            }
+
+            template <typename C>
+            static double weight(const C &c, EdgeIndex e)
+            {
+                return evaluate(c.latency[e], c.bandwidth[e], c.packet_loss[e], c.utilization[e], c.cost[e], c.reliability[e]);
+            }
+        };
+
+        // значение слагаемого пользовательской стратегии на ребре e
+        template <typename C>
+        double customTerm(const CustomStrategy::Component &component, const C &c, EdgeIndex e)
+        {
+            switch (component.term)
+            {
+            case CustomStrategy::LATENCY: return c.latency[e];
+            case CustomStrategy::BANDWIDTH: return c.bandwidth[e];
+            case CustomStrategy::PACKET_LOSS: return c.packet_loss[e];
+            case CustomStrategy::UTILIZATION: return c.utilization[e];
+            case CustomStrategy::COST: return c.cost[e];
+            case CustomStrategy::RELIABILITY: return c.reliability[e];
+            case CustomStrategy::EFFECTIVE_LATENCY:
+                return effectiveLatency(c.latency[e], c.utilization[e]);
+            case CustomStrategy::INVERSE_BANDWIDTH:
+                return 1.0 / c.bandwidth[e];
+            case CustomStrategy::INVERSE_CURRENT_BANDWIDTH:
+                return 1.0 / currentBandwidth(c.bandwidth[e], c.packet_loss[e]);
+            case CustomStrategy::UNRELIABILITY:
+                return 1.0 - dynamicReliability(c.packet_loss[e], c.utilization[e]);
+            case CustomStrategy::UTILIZATION_EXCESS:
+            default:
+                return std::max(0.0, c.utilization[e] - component.threshold);
+            }
+        }
+
+        // пользовательская стратегия: политика с состоянием - программа слагаемых из реестра,
+        // выполняется на каждом ребре по любым столбцам (указатели, таблицы страниц, кодировки)
+        struct Custom
+        {
+            const CustomStrategy *program = nullptr;
+
+            template <typename C>
+            double weight(const C &c, EdgeIndex e) const
+            {
+                // тот же порядок операций, что у встроенных формул: значение * коэффициент, сумма слева направо
+                const auto &terms = program->getProgram();
+                double res = customTerm(terms[0], c, e) * terms[0].coefficient;
+                for (std::size_t k = 1; k < terms.size(); ++k)
+                    res = res + customTerm(terms[k], c, e) * terms[k].coefficient;
+                return res;
+            }
+        };
+
+        template <typename Policy>
+        constexpr unsigned columnsOf(const Policy &) { return Policy::COLUMNS; }
+        inline unsigned columnsOf(const Custom &policy) { return policy.program->getColumns(); }
+
+        // единственный выбор стратегии во время выполнения: f вызывается с объектом политики
+        // (вес ребра - policy.weight(columns, e))
+        template <typename F>
+        decltype(auto) dispatch(WeightCalculator::Strategy strategy, F &&f)
+        {
+            switch (strategy)
+            {
+            case WeightCalculator::UNIFORM_WEIGHTS: return f(Uniform{});
+            case WeightCalculator::BALANCE_LOAD: return f(Balanced{});
+            case WeightCalculator::MAXIMIZE_BANDWIDTH: return f(Bandwidth{});
+            case WeightCalculator::MINIMIZE_COST: return f(Cost{});
+            case WeightCalculator::ADAPTIVE_WEIGHTS: return f(Adaptive{});
+            case WeightCalculator::MINIMIZE_LATENCY: return f(Latency{});
+            default:
+                if (const CustomStrategy *custom = WeightCalculator::getCustomStrategy(strategy))
+                    return f(Custom{custom});
+                return f(Latency{});
+            }
+        }
+
+        unsigned getColumns(WeightCalculator::Strategy strategy);
+    }
+
+    // столбцы хранилища для политик весов на время запроса, без декодирования в копию:
+    //  - DIRECT: все нужные столбцы лежат подряд в FLOAT64 - указатели прямо в хранилище (getColumns);
+    //  - PAGED: столбцы FLOAT64 с замененными страницами или невыделенные - таблицы страниц
+    //    (getPagedColumns), подготовка - O(число ребер / PagedArray::PAGE_SIZE);
+    //  - ENCODED: нужен столбец в сжатой кодировке - ParameterColumn::get (getEncodedColumns)
+    class ParameterView
+    {
+    public:
+        enum Access { DIRECT, PAGED, ENCODED };
+
+        ParameterView(const LinkParameterStore &store, WeightCalculator::Strategy strategy);
+        ParameterView(const ParameterView &) = delete;
+        ParameterView &operator=(const ParameterView &) = delete;
+
+        Access getAccess() const { return access; }
+        const WeightCalculator::ParameterColumns &getColumns() const { return columns; }
+        const WeightPolicy::PagedColumns &getPagedColumns() const { return pagedColumns; }
+        const WeightPolicy::EncodedColumns &getEncodedColumns() const { return encodedColumns; }
+
+    private:
+        Access access = DIRECT;
+        WeightCalculator::ParameterColumns columns;
+        WeightPolicy::PagedColumns pagedColumns;
+        WeightPolicy::EncodedColumns encodedColumns;
+        std::array<std::vector<const double *>, LinkParameterStore::COLUMN_COUNT> pageTables;
+        std::array<std::vector<double>, LinkParameterStore::COLUMN_COUNT> defaultPages;
+    };
+}
+
+#endif
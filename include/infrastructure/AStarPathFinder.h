@@ -3,20 +3,15 @@
 
 #include "IPathFinder.h"
 #include "../domain/WeightCalculator.h"
-#include <boost/graph/adjacency_list.hpp>
+#include "../domain/GeometricHeuristic.h"
+#include "CompactGraphBGL.h"
 #include <boost/graph/astar_search.hpp>
 #include <vector>
-#include <unordered_map>
 
 namespace Infrastructure
 {
     struct found_goal {};
 
-    using BGLGraph = boost::adjacency_list<
-        boost::vecS, boost::vecS, boost::directedS,
-        boost::no_property,
-        boost::property<boost::edge_weight_t, double>>;
-
     template <class Graph, class CostType = double>
     class AStarHeuristic : public boost::astar_heuristic<Graph, CostType>
     {
@@ -28,19 +23,36 @@ namespace Infrastructure
         Vertex m_goal;
     };
 
+    // оценка по координатам узлов (Domain::GeometricHeuristic), построенная для того же снимка
+    template <class Graph>
+    class GeometricAStarHeuristic : public boost::astar_heuristic<Graph, double>
+    {
+    public:
+        using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+        GeometricAStarHeuristic(const Domain::GeometricHeuristic &heuristic, Vertex goal)
+            : m_heuristic(heuristic), m_goal(goal) {}
+        double operator()(Vertex u) const { return m_heuristic.estimate(u, m_goal); }
+    private:
+        const Domain::GeometricHeuristic &m_heuristic;
+        Vertex m_goal;
+    };
+
+    // остановка на цели; settled считает вершины, извлеченные из очереди
     template <class Vertex>
     class AStarGoalVisitor : public boost::default_astar_visitor
     {
     public:
-        explicit AStarGoalVisitor(Vertex goal) : m_goal(goal) {}
+        AStarGoalVisitor(Vertex goal, std::size_t &settled) : m_goal(goal), m_settled(settled) {}
         template <class Graph>
         void examine_vertex(Vertex u, const Graph&)
         {
+            ++m_settled;
             if (u == m_goal)
                 throw found_goal();
         }
     private:
         Vertex m_goal;
+        std::size_t &m_settled;
     };
 
     class AStarPathFinder : public IPathFinder
@@ -48,19 +60,37 @@ namespace Infrastructure
     public:
         AStarPathFinder(bool useWeights = true,
                         Domain::WeightCalculator::Strategy strategy = Domain::WeightCalculator::MINIMIZE_LATENCY)
-            : useWeights(useWeights), strategy(strategy), useCoordinateHeuristic(false) {}
+            : useWeights(useWeights), strategy(strategy), useCoordinateHeuristic(true) {}
 
         Domain::PathResult findShortestPath(
             const Domain::NetworkGraphPtr &graph,
-            int start_id, int end_id) override;
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
+
+        Domain::PathResult findShortestPath(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
 
+        // useCoordinateHeuristic - оценка по координатам узлов графа, если они заданы
+        // (NetworkGraph::setCoordinates); иначе и без координат оценка нулевая
         static Domain::PathResult findShortestPathStatic(
             const Domain::NetworkGraphPtr &graph,
-            int start_id, int end_id,
+            Domain::NodeId start_id, Domain::NodeId end_id,
+            bool useWeights = true,
+            Domain::WeightCalculator::Strategy strategy = Domain::WeightCalculator::MINIMIZE_LATENCY,
+            bool useCoordinateHeuristic = true);
+
+        // heuristic - построенная для graph и той же стратегии (UNIFORM_WEIGHTS при useWeights = false),
+        // nullptr - нулевая оценка. evaluation - массив весов, встроенная политика стратегии или switch на каждом ребре.
+        // std::invalid_argument - эвристика построена для другого снимка или стратегии
+        static Domain::PathResult findShortestPathStatic(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id,
             bool useWeights = true,
             Domain::WeightCalculator::Strategy strategy = Domain::WeightCalculator::MINIMIZE_LATENCY,
-            bool useCoordinateHeuristic = false);
+            const Domain::GeometricHeuristic *heuristic = nullptr,
+            WeightEvaluation evaluation = PRECOMPUTED_WEIGHTS);
 
+        // false - нулевая оценка и при заданных координатах (для сравнения с Дейкстрой)
         void enableCoordinateHeuristic(bool enable) { useCoordinateHeuristic = enable; }
 
         std::string getAlgorithmName() const override
@@ -6,6 +6,10 @@
 #include "AStarPathFinder.h"
 #include "GeneticAlgorithm.h"
 #include "AntColonyOptimizer.h"
+#include "BoostFlowSolver.h"
+#include "MemoryProbe.h"
+#include "ParetoPathFinder.h"
+#include "../domain/GraphOrdering.h"
 #include "../config/StrategyConfig.h"
 #include <vector>
 #include <map>
@@ -20,6 +24,52 @@ namespace Infrastructure
         int pathLength;
         bool success;
         std::string algorithmType; // exact and heuristic
+        std::size_t scratchMemory = 0;  // рабочая память алгоритма по его оценке (байты)
+        std::size_t peakMemory = 0;     // прирост пика RSS процесса за вызов (байты)
+    };
+
+    // замер одного порядка вершин CSR: локальность и время точных алгоритмов (мс, сумма по маршрутам)
+    struct OrderingBenchmark {
+        std::string orderingName;
+        double buildTime;             // построение и перенумерация CSR
+        double averageGap;
+        double crossLineShare;        // оценка промахов кэша: ребра с концами в разных кэш-линиях
+        double dijkstraTime;
+        double astarTime;
+        double flowTime;
+        bool success;
+    };
+
+    // пересчет весов всех ребер графа одним набором инструкций
+    struct WeightKernelBenchmark {
+        std::string strategyName;
+        std::string instructionSet;
+        double time;                  // мс на полный пересчет
+        double nsPerEdge;
+        bool matchesScalar;           // побитовое совпадение с результатом скалярного ядра
+    };
+
+    // Dijkstra и A* по всем маршрутам при одном способе получения веса ребра (мс, сумма по маршрутам)
+    struct WeightEvaluationBenchmark {
+        std::string strategyName;
+        double precomputedTime;       // массив весов из кэша CSR
+        double inlineTime;            // ядро, специализированное под стратегию
+        double inlinePatchedTime;     // то же на снимке с измененным ребром: столбцы читаются из хранилища
+        double runtimeSwitchTime;     // calculateCompositeWeight на каждом ребре
+        bool costsMatch;              // стоимости путей совпадают во всех режимах
+    };
+
+    // фронт Парето одного маршрута против отдельного Dijkstra по каждой стратегии весов
+    struct ParetoBenchmark {
+        Domain::NodePair route;
+        double paretoTime;            // мс, один многокритериальный поиск
+        double strategiesTime;        // мс, Dijkstra по всем стратегиям
+        std::size_t labelsCreated;
+        bool truncated;
+        std::size_t strategyRoutes;   // различных маршрутов у однокритериальных поисков
+        std::size_t coveredRoutes;    // из них доминируются фронтом (с точностью epsilon)
+        std::size_t newRoutes;        // маршруты фронта, которых не нашла ни одна стратегия
+        std::vector<ParetoRoute> front;
     };
 
     class AlgorithmComparator
@@ -28,17 +78,41 @@ namespace Infrastructure
         // основной метод с конфигурацией стратегий
         static std::vector<AlgorithmComparison> compareAlgorithms(
             const Domain::NetworkGraphPtr &graph,
-            const std::vector<std::pair<int, int>> &test_routes,
+            const std::vector<Domain::NodePair> &test_routes,
             const Config::StrategySettings& strategies = Config::StrategySettings());
         
         // старый метод для обратной совместимости
         static std::vector<AlgorithmComparison> compareAlgorithms(
             const Domain::NetworkGraphPtr &graph,
-            const std::vector<std::pair<int, int>> &test_routes) {
+            const std::vector<Domain::NodePair> &test_routes) {
             return compareAlgorithms(graph, test_routes, Config::StrategySettings());
         }
         
         static void printComparisonTable(const std::vector<AlgorithmComparison> &results);
+
+        // Dijkstra, A* и максимальный поток при каждом порядке вершин; порядок графа восстанавливается
+        static std::vector<OrderingBenchmark> benchmarkOrderings(
+            const Domain::NetworkGraphPtr &graph,
+            const std::vector<Domain::NodePair> &test_routes);
+
+        static void printOrderingTable(const std::vector<OrderingBenchmark> &results);
+
+        // пакетный расчет весов для каждой стратегии всеми наборами инструкций, доступными процессору
+        static std::vector<WeightKernelBenchmark> benchmarkWeightKernels(const Domain::NetworkGraphPtr &graph);
+
+        static void printWeightKernelTable(const std::vector<WeightKernelBenchmark> &results);
+
+        static std::vector<WeightEvaluationBenchmark> benchmarkWeightEvaluation(
+            const Domain::NetworkGraphPtr &graph,
+            const std::vector<Domain::NodePair> &test_routes);
+
+        static void printWeightEvaluationTable(const std::vector<WeightEvaluationBenchmark> &results);
+
+        static std::vector<ParetoBenchmark> benchmarkParetoSearch(
+            const Domain::NetworkGraphPtr &graph,
+            const std::vector<Domain::NodePair> &test_routes);
+
+        static void printParetoTable(const std::vector<ParetoBenchmark> &results);
     };
 }
 
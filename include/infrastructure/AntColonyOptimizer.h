@@ -3,9 +3,9 @@
 
 #include "IHeuristicSolver.h"
 #include "../domain/WeightCalculator.h"
+#include "../domain/CompactGraph.h"
 #include <random>
 #include <vector>
-#include <unordered_map>
 #include <memory>
 
 namespace Infrastructure
@@ -25,12 +25,15 @@ namespace Infrastructure
               strategy(strategy), gen(std::random_device{}()) {}
 
         HeuristicResult optimize(const Domain::NetworkGraphPtr &graph,
-                                const std::vector<std::pair<int, int>> &demands) override;
+                                const std::vector<Domain::NodePair> &demands) override;
 
     private:
+        using NodeIndex = Domain::CompactGraph::NodeIndex;
+        using EdgeIndex = Domain::CompactGraph::EdgeIndex;
+
         struct Ant {
-            std::vector<int> path;
-            std::unordered_set<int> visited;
+            std::vector<NodeIndex> path;
+            std::vector<EdgeIndex> edges; // ребра CSR между соседними узлами пути
             double path_cost;
         };
 
@@ -43,22 +46,22 @@ namespace Infrastructure
         Domain::WeightCalculator::Strategy strategy;
         std::mt19937 gen;
 
-        // матрицы феромонов и эвристической информации
-        std::unordered_map<int, std::unordered_map<int, double>> pheromone;
-        std::unordered_map<int, std::unordered_map<int, double>> heuristic;
+        // веса, феромоны и эвристическая информация по индексу ребра CSR
+        Domain::CompactGraph::WeightArray weights;
+        std::vector<double> pheromone;
+        std::vector<double> heuristic;
+
+        // отметки посещения: узел посещен текущим муравьем, если visitStamp[u] == currentStamp
+        std::vector<std::uint32_t> visitStamp;
+        std::uint32_t currentStamp = 0;
+        std::vector<double> probabilities;
 
         // основные методы муравьиной колонии
-        void initializePheromones(const Domain::NetworkGraphPtr &graph);
-        void initializeHeuristics(const Domain::NetworkGraphPtr &graph);
-        Ant constructSolution(const Domain::NetworkGraphPtr &graph, int start, int end);
-        int selectNextNode(const Ant& ant, const Domain::NetworkGraphPtr &graph, int end);
+        void initializePheromones(const Domain::CompactGraph &graph);
+        void initializeHeuristics(const Domain::CompactGraph &graph);
+        Ant constructSolution(const Domain::CompactGraph &graph, NodeIndex start, NodeIndex end);
+        EdgeIndex selectNextEdge(const Domain::CompactGraph &graph, NodeIndex current);
         void updatePheromones(std::vector<Ant>& ants);
-        double calculateTransitionProbability(const Ant& ant, int current, int next, const Domain::NetworkGraphPtr &graph);
-        
-        // вспомогательные методы
-        std::vector<int> getAvailableNeighbors(const Ant& ant, const Domain::NetworkGraphPtr &graph, int current);
-        bool isValidPath(const std::vector<int>& path, const Domain::NetworkGraphPtr &graph);
-        double calculatePathCost(const std::vector<int>& path, const Domain::NetworkGraphPtr &graph);
     };
 }
 
@@ -2,9 +2,11 @@
 #define BGLSHORTESTPATH_H
 
 #include "../domain/NetworkGraph.h"
+#include "../domain/GraphSnapshot.h"
 #include "../domain/NetworkTypes.h"
 #include "../domain/WeightCalculator.h"
 #include "IPathFinder.h"
+#include "CompactGraphBGL.h"
 #include <chrono>
 
 namespace Infrastructure
@@ -20,7 +22,11 @@ namespace Infrastructure
 
         Domain::PathResult findShortestPath(
             const Domain::NetworkGraphPtr &graph,
-            int start_id, int end_id) override;
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
+
+        Domain::PathResult findShortestPath(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
 
         std::string getAlgorithmName() const override {
             if (!useWeights) {
@@ -32,7 +38,22 @@ namespace Infrastructure
         // статический метод с параметрами
         static Domain::PathResult findShortestPathStatic(
             const Domain::NetworkGraphPtr &graph,
-            int start_id, int end_id,
+            Domain::NodeId start_id, Domain::NodeId end_id,
+            bool useWeights = true,
+            Domain::WeightCalculator::Strategy strategy = Domain::WeightCalculator::MINIMIZE_LATENCY);
+
+        // evaluation - массив весов, встроенная политика стратегии или switch на каждом ребре
+        static Domain::PathResult findShortestPathStatic(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id,
+            bool useWeights = true,
+            Domain::WeightCalculator::Strategy strategy = Domain::WeightCalculator::MINIMIZE_LATENCY,
+            WeightEvaluation evaluation = PRECOMPUTED_WEIGHTS);
+
+        // поиск по снимку с копированием при записи без материализации графа
+        static Domain::PathResult findShortestPathStatic(
+            const Domain::GraphSnapshot &snapshot,
+            Domain::NodeId start_id, Domain::NodeId end_id,
             bool useWeights = true,
             Domain::WeightCalculator::Strategy strategy = Domain::WeightCalculator::MINIMIZE_LATENCY);
 
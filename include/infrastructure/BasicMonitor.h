@@ -21,10 +21,14 @@ namespace Infrastructure
         };
         
         static NetworkMetrics collectBasicMetrics(const Domain::NetworkGraphPtr& graph);
-        static void simulateNodeFailure(const Domain::NetworkGraphPtr& graph, int node_id);
-        static void simulateEdgeFailure(const Domain::NetworkGraphPtr& graph, int from, int to);
+        // байт на ребро под параметры связей в каждом режиме хранения
+        static void printParameterMemoryReport(const Domain::NetworkGraphPtr& graph);
+        // память по структурам графа, итог и байт на ребро, затем отчет по параметрам
+        static void printMemoryReport(const Domain::NetworkGraphPtr& graph);
+        static void simulateNodeFailure(const Domain::NetworkGraphPtr& graph, Domain::NodeId node_id);
+        static void simulateEdgeFailure(const Domain::NetworkGraphPtr& graph, Domain::NodeId from, Domain::NodeId to);
         static void analyzeConnectivity(const Domain::NetworkGraphPtr& graph, 
-                                      const std::vector<std::pair<int, int>>& test_pairs);
+                                      const std::vector<Domain::NodePair>& test_pairs);
     };
 }
 
@@ -0,0 +1,121 @@
+#ifndef BINARYGRAPHFORMAT_H
+#define BINARYGRAPHFORMAT_H
+
+#include "../domain/LinkParameterStore.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Infrastructure
+{
+    // раскладка двоичного файла графа (см. BinaryGraphRepository):
+    // FileHeader, таблица из SECTION_COUNT записей SectionEntry, затем разделы, каждый с адреса,
+    // кратного SECTION_ALIGNMENT. между разделами допустимы промежутки (запись во внешней памяти
+    // резервирует место под ребра до удаления повторов)
+    namespace BinaryGraphFormat
+    {
+        constexpr std::uint32_t VERSION = 1;
+        constexpr char MAGIC[8] = {'N', 'E', 'T', 'G', 'R', 'A', 'P', 'H'};
+        constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;   // в файле другого порядка байт читается иначе
+        constexpr std::uint64_t SECTION_ALIGNMENT = 64;         // разделы выровнены под строку кэша
+        constexpr std::uint64_t CHECKSUM_SEED = 0xcbf29ce484222325ULL;
+
+        // разделы идут в таблице в этом порядке, столбцы параметров - в порядке LinkParameterStore::Column
+        enum SectionKind {
+            NODE_IDS,
+            SORTED_IDS,
+            SORTED_INDEX,
+            OFFSETS,
+            TARGETS,
+            PARAMETERS,
+            SECTION_COUNT = PARAMETERS + Domain::LinkParameterStore::COLUMN_COUNT
+        };
+
+        struct FileHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byteOrder;
+            std::uint64_t nodeCount;
+            std::uint64_t edgeCount;
+            std::uint32_t parameterEncoding;   // LinkParameterStore::Encoding
+            std::uint32_t sectionCount;
+            std::uint64_t dataChecksum;        // содержимое разделов подряд, без промежутков
+            std::uint64_t headerChecksum;      // заголовок (с нулем в этом поле) и таблица разделов
+        };
+
+        struct SectionEntry
+        {
+            std::uint32_t kind;
+            std::uint32_t elementSize;    // байт на элемент
+            std::uint32_t encoding;       // ParameterColumn::Encoding для столбцов параметров
+            std::uint32_t materialized;   // 0 - столбец не выделен, все значения равны defaultValue
+            double defaultValue;
+            std::uint64_t offset;         // от начала файла, кратно SECTION_ALIGNMENT
+            std::uint64_t count;          // элементов
+
+            std::uint64_t getBytes() const { return materialized ? count * elementSize : 0; }
+        };
+
+        static_assert(sizeof(FileHeader) == 56 && sizeof(SectionEntry) == 40, "Binary graph layout changed");
+
+        // FNV-1a по 8-байтовым словам (хвост - по байтам); seed продолжает сумму предыдущего блока
+        inline std::uint64_t checksum(const void *data, std::size_t size, std::uint64_t seed)
+        {
+            constexpr std::uint64_t PRIME = 0x100000001b3ULL;
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            std::uint64_t hash = seed;
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+            {
+                std::uint64_t word;
+                std::memcpy(&word, bytes + i, sizeof(word));
+                hash = (hash ^ word) * PRIME;
+            }
+            for (; i < size; ++i)
+                hash = (hash ^ bytes[i]) * PRIME;
+            return hash;
+        }
+
+        inline std::uint64_t headerChecksum(FileHeader header, const std::vector<SectionEntry> &sections)
+        {
+            header.headerChecksum = 0;
+            return checksum(sections.data(), sections.size() * sizeof(SectionEntry),
+                            checksum(&header, sizeof(header), CHECKSUM_SEED));
+        }
+
+        // сумма разделов файла, начинающегося с адреса base
+        inline std::uint64_t dataChecksum(const char *base, const std::vector<SectionEntry> &sections)
+        {
+            std::uint64_t sum = CHECKSUM_SEED;
+            for (const auto &entry : sections)
+                sum = checksum(base + entry.offset, entry.getBytes(), sum);
+            return sum;
+        }
+
+        inline std::uint64_t alignUp(std::uint64_t value)
+        {
+            return (value + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+        }
+
+        // заголовок с заполненными сигнатурой, версией и порядком байт
+        inline FileHeader makeHeader()
+        {
+            FileHeader header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.byteOrder = BYTE_ORDER_MARK;
+            header.sectionCount = SECTION_COUNT;
+            return header;
+        }
+
+        // начало таблицы разделов и первого раздела
+        constexpr std::uint64_t TABLE_OFFSET = sizeof(FileHeader);
+        inline std::uint64_t firstSectionOffset()
+        {
+            return alignUp(TABLE_OFFSET + SECTION_COUNT * sizeof(SectionEntry));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef BINARYGRAPHREPOSITORY_H
+#define BINARYGRAPHREPOSITORY_H
+
+#include "../domain/NetworkGraph.h"
+#include "../domain/CompactGraph.h"
+#include "../domain/IGraphRepository.h"
+#include "BinaryGraphFormat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Infrastructure
+{
+    // собственный двоичный формат графа (BinaryGraphFormat): заголовок, таблица разделов (массивы CSR,
+    // id вершин, столбцы параметров в кодировке хранилища) и контрольные суммы. разделы выровнены,
+    // поэтому граф открывается отображением файла в память без разбора и копирования,
+    // а страницы файла разделяются всеми процессами, открывшими тот же файл
+    class BinaryGraphRepository : public Domain::IGraphRepository
+    {
+    public:
+        static constexpr std::uint32_t FORMAT_VERSION = BinaryGraphFormat::VERSION;
+        static constexpr const char *FILE_EXTENSION = ".ngb";
+
+        // NetworkGraph из файла: хэш-таблицы смежности строятся из CSR без разбора текста,
+        // а CSR-снимком графа становится сам отображенный файл
+        Domain::NetworkGraphPtr loadGraph(const std::string &filename) override;
+
+        // CSR поверх отображенного файла: время открытия не зависит от размера графа;
+        // файл остается отображенным, пока жив граф или его копии с измененными параметрами.
+        // std::runtime_error - не тот формат, версия или поврежденный заголовок
+        Domain::CompactGraphPtr openCompactGraph(const std::string &filename) const;
+
+        // запись через временный файл с заменой: открытые отображения старого файла не портятся
+        static void save(const Domain::CompactGraph &graph, const std::string &filename);
+        static void save(const Domain::NetworkGraph &graph, const std::string &filename)
+        {
+            save(*graph.getCompactGraph(), filename);
+        }
+
+        // NetworkGraph поверх CSR, который становится его снимком. node_order - порядок добавления
+        // вершин (как у исходного графа); пустой - порядок CSR
+        static Domain::NetworkGraphPtr buildNetworkGraph(const Domain::CompactGraphPtr &compact, const std::string &name,
+                                                         const std::vector<Domain::NodeId> &node_order = {});
+
+        // начинается ли файл с сигнатуры формата
+        static bool isBinaryGraphFile(const std::string &filename);
+
+        // сверка контрольной суммы данных при открытии: требует прочитать весь файл,
+        // поэтому по умолчанию проверяются только заголовок и таблица разделов
+        void setVerifyChecksum(bool verify) { verifyChecksum = verify; }
+
+    private:
+        bool verifyChecksum = false;
+    };
+}
+
+#endif
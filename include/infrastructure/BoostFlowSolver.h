@@ -10,11 +10,11 @@
 namespace std
 {
     template <>
-    struct hash<std::pair<int, int>>
+    struct hash<Domain::NodePair>
     {
-        size_t operator()(const std::pair<int, int> &p) const
+        size_t operator()(const Domain::NodePair &p) const
         {
-            return hash<int>()(p.first) ^ (hash<int>()(p.second) << 1);
+            return hash<Domain::NodeId>()(p.first) ^ (hash<Domain::NodeId>()(p.second) << 1);
         }
     };
 }
@@ -24,8 +24,8 @@ namespace Infrastructure
     class BoostFlowSolver : public IFlowSolver
     {
     public:
-        FlowResult solveMaxFlow(const Domain::NetworkGraphPtr &graph, int source, int sink) override;
-        FlowResult solveMinCostMaxFlow(const Domain::NetworkGraphPtr &graph, int source, int sink) override;
+        FlowResult solveMaxFlow(const Domain::NetworkGraphPtr &graph, Domain::NodeId source, Domain::NodeId sink) override;
+        FlowResult solveMinCostMaxFlow(const Domain::NetworkGraphPtr &graph, Domain::NodeId source, Domain::NodeId sink) override;
     };
 }
 
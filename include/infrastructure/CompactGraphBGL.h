@@ -0,0 +1,227 @@
+#ifndef COMPACTGRAPHBGL_H
+#define COMPACTGRAPHBGL_H
+
+#include "../domain/CompactGraph.h"
+#include "../domain/WeightPolicies.h"
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <string>
+#include <utility>
+
+// адаптер Domain::CompactGraph к концепциям BGL (IncidenceGraph + VertexListGraph),
+// чтобы алгоритмы boost работали прямо по CSR-массивам без копирования графа
+namespace Infrastructure
+{
+    struct CompactEdge
+    {
+        Domain::CompactGraph::NodeIndex source = 0;
+        Domain::CompactGraph::EdgeIndex index = 0;
+
+        bool operator==(const CompactEdge &other) const { return index == other.index; }
+        bool operator!=(const CompactEdge &other) const { return index != other.index; }
+    };
+
+    class CompactOutEdgeIterator
+        : public boost::iterator_facade<CompactOutEdgeIterator, CompactEdge,
+                                        boost::random_access_traversal_tag, CompactEdge>
+    {
+    public:
+        CompactOutEdgeIterator() = default;
+        CompactOutEdgeIterator(Domain::CompactGraph::NodeIndex source, Domain::CompactGraph::EdgeIndex index)
+            : edge{source, index} {}
+
+    private:
+        friend class boost::iterator_core_access;
+
+        CompactEdge dereference() const { return edge; }
+        bool equal(const CompactOutEdgeIterator &other) const { return edge.index == other.edge.index; }
+        void increment() { ++edge.index; }
+        void decrement() { --edge.index; }
+        void advance(std::ptrdiff_t n) { edge.index = static_cast<Domain::CompactGraph::EdgeIndex>(edge.index + n); }
+        std::ptrdiff_t distance_to(const CompactOutEdgeIterator &other) const
+        {
+            return static_cast<std::ptrdiff_t>(other.edge.index) - static_cast<std::ptrdiff_t>(edge.index);
+        }
+
+        CompactEdge edge;
+    };
+
+    // read-only карта весов по индексу ребра
+    struct CompactWeightMap
+    {
+        using key_type = CompactEdge;
+        using value_type = double;
+        using reference = double;
+        using category = boost::readable_property_map_tag;
+
+        const Domain::PagedArray<double> *weights = nullptr;
+    };
+
+    inline double get(const CompactWeightMap &map, const CompactEdge &e) { return (*map.weights)[e.index]; }
+
+    // вес считается при релаксации по столбцам параметров; политика известна при компиляции,
+    // поэтому формула стратегии встраивается в цикл поиска. Columns - указатели на массивы
+    // (ParameterColumns) или чтение из хранилища (WeightPolicy::PagedColumns, EncodedColumns)
+    template <typename Policy, typename Columns = Domain::WeightCalculator::ParameterColumns>
+    struct CompactPolicyWeightMap
+    {
+        using key_type = CompactEdge;
+        using value_type = double;
+        using reference = double;
+        using category = boost::readable_property_map_tag;
+
+        const Columns *columns = nullptr;
+        Policy policy{};
+    };
+
+    template <typename Policy, typename Columns>
+    inline double get(const CompactPolicyWeightMap<Policy, Columns> &map, const CompactEdge &e)
+    {
+        return map.policy.weight(*map.columns, e.index);
+    }
+
+    // вес через calculateCompositeWeight: стратегия выбирается на каждом ребре (для сравнения)
+    struct CompactRuntimeWeightMap
+    {
+        using key_type = CompactEdge;
+        using value_type = double;
+        using reference = double;
+        using category = boost::readable_property_map_tag;
+
+        const Domain::LinkParameterStore *parameters = nullptr;
+        Domain::WeightCalculator::Strategy strategy = Domain::WeightCalculator::MINIMIZE_LATENCY;
+    };
+
+    inline double get(const CompactRuntimeWeightMap &map, const CompactEdge &e)
+    {
+        return Domain::WeightCalculator::calculateCompositeWeight(map.parameters->get(e.index), map.strategy);
+    }
+
+    // как ядро поиска получает вес ребра
+    enum WeightEvaluation {
+        PRECOMPUTED_WEIGHTS,   // массив весов CSR (строится при первом запросе и кэшируется)
+        INLINE_POLICY,         // по столбцам параметров, ядро специализировано под стратегию
+        RUNTIME_SWITCH         // по параметрам ребра через switch по стратегии
+    };
+
+    inline std::string getWeightEvaluationName(WeightEvaluation evaluation)
+    {
+        switch (evaluation)
+        {
+        case INLINE_POLICY: return "Inline policy";
+        case RUNTIME_SWITCH: return "Runtime switch";
+        default: return "Precomputed";
+        }
+    }
+
+    // единственный выбор во время выполнения на входе запроса: kernel вызывается с картой весов
+    // конкретного типа и инстанцируется отдельно для каждой стратегии
+    template <typename Kernel>
+    decltype(auto) withWeightMap(const Domain::CompactGraph &graph, Domain::WeightCalculator::Strategy strategy,
+                                 WeightEvaluation evaluation, Kernel &&kernel)
+    {
+        switch (evaluation)
+        {
+        case INLINE_POLICY:
+        {
+            Domain::ParameterView view(graph.getParameterStore(), strategy);
+            return Domain::WeightPolicy::dispatch(strategy, [&](auto policy) {
+                using Policy = decltype(policy);
+                switch (view.getAccess())
+                {
+                case Domain::ParameterView::PAGED:
+                    return kernel(CompactPolicyWeightMap<Policy, Domain::WeightPolicy::PagedColumns>{&view.getPagedColumns(), policy});
+                case Domain::ParameterView::ENCODED:
+                    return kernel(CompactPolicyWeightMap<Policy, Domain::WeightPolicy::EncodedColumns>{&view.getEncodedColumns(), policy});
+                default:
+                    return kernel(CompactPolicyWeightMap<Policy>{&view.getColumns(), policy});
+                }
+            });
+        }
+        case RUNTIME_SWITCH:
+            return kernel(CompactRuntimeWeightMap{&graph.getParameterStore(), strategy});
+        case PRECOMPUTED_WEIGHTS:
+        default:
+        {
+            auto weights = graph.getEdgeWeights(strategy);
+            return kernel(CompactWeightMap{weights.get()});
+        }
+        }
+    }
+}
+
+namespace boost
+{
+    template <>
+    struct graph_traits<Domain::CompactGraph>
+    {
+        using vertex_descriptor = Domain::CompactGraph::NodeIndex;
+        using edge_descriptor = Infrastructure::CompactEdge;
+        using directed_category = directed_tag;
+        using edge_parallel_category = disallow_parallel_edge_tag;
+        struct traversal_category : incidence_graph_tag, vertex_list_graph_tag {};
+
+        using vertex_iterator = counting_iterator<vertex_descriptor>;
+        using out_edge_iterator = Infrastructure::CompactOutEdgeIterator;
+        using vertices_size_type = std::size_t;
+        using edges_size_type = std::size_t;
+        using degree_size_type = std::size_t;
+
+        using adjacency_iterator = void;
+        using in_edge_iterator = void;
+        using edge_iterator = void;
+
+        static vertex_descriptor null_vertex() { return Domain::CompactGraph::INVALID_NODE; }
+    };
+
+    template <>
+    struct property_map<Domain::CompactGraph, vertex_index_t>
+    {
+        using type = typed_identity_property_map<Domain::CompactGraph::NodeIndex>;
+        using const_type = type;
+    };
+}
+
+// свободные функции BGL ищутся через ADL по типу графа
+namespace Domain
+{
+    inline std::pair<boost::counting_iterator<CompactGraph::NodeIndex>,
+                     boost::counting_iterator<CompactGraph::NodeIndex>>
+    vertices(const CompactGraph &g)
+    {
+        return {boost::counting_iterator<CompactGraph::NodeIndex>(0),
+                boost::counting_iterator<CompactGraph::NodeIndex>(
+                    static_cast<CompactGraph::NodeIndex>(g.getNodeCount()))};
+    }
+
+    inline std::size_t num_vertices(const CompactGraph &g) { return g.getNodeCount(); }
+
+    inline std::pair<Infrastructure::CompactOutEdgeIterator, Infrastructure::CompactOutEdgeIterator>
+    out_edges(CompactGraph::NodeIndex u, const CompactGraph &g)
+    {
+        return {Infrastructure::CompactOutEdgeIterator(u, g.edgesBegin(u)),
+                Infrastructure::CompactOutEdgeIterator(u, g.edgesEnd(u))};
+    }
+
+    inline std::size_t out_degree(CompactGraph::NodeIndex u, const CompactGraph &g) { return g.getOutDegree(u); }
+
+    inline CompactGraph::NodeIndex source(const Infrastructure::CompactEdge &e, const CompactGraph &)
+    {
+        return e.source;
+    }
+
+    inline CompactGraph::NodeIndex target(const Infrastructure::CompactEdge &e, const CompactGraph &g)
+    {
+        return g.getTarget(e.index);
+    }
+
+    inline boost::typed_identity_property_map<CompactGraph::NodeIndex> get(boost::vertex_index_t, const CompactGraph &)
+    {
+        return {};
+    }
+}
+
+#endif
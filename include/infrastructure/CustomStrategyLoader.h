@@ -0,0 +1,33 @@
+#ifndef CUSTOMSTRATEGYLOADER_H
+#define CUSTOMSTRATEGYLOADER_H
+
+#include "../domain/CustomStrategy.h"
+#include "../domain/WeightCalculator.h"
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace Infrastructure
+{
+    // загрузка пользовательских стратегий весов из текстового файла:
+    //
+    //   # комментарий
+    //   [Latency+Cost]                        - начало стратегии, в скобках имя
+    //   description = задержка и стоимость    - описание (необязательно); в кавычках "..." может содержать #
+    //   latency = 0.7                         - слагаемое: имя = коэффициент
+    //   cost = 0.3
+    //   utilization_excess = 5 @ 0.8          - после @ порог (только utilization_excess)
+    //
+    // имена слагаемых - CustomStrategy::getTermName; слагаемые суммируются в порядке файла
+    class CustomStrategyLoader
+    {
+    public:
+        // std::runtime_error с источником и номером строки при ошибке разбора
+        static std::vector<Domain::CustomStrategy::Spec> parse(std::istream &in, const std::string &source);
+
+        // разбор, компиляция и регистрация в WeightCalculator; значения Strategy в порядке файла
+        static std::vector<Domain::WeightCalculator::Strategy> loadFile(const std::string &filename);
+    };
+}
+
+#endif
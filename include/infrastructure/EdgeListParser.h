@@ -0,0 +1,65 @@
+#ifndef EDGELISTPARSER_H
+#define EDGELISTPARSER_H
+
+#include "../domain/NetworkTypes.h"
+#include "../domain/ParameterSynthesizer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Infrastructure
+{
+    class LinkMetricsTable;
+
+    // разбор строк ребер текстового файла графа по кускам памяти (куски независимы,
+    // поэтому разбираются параллельно или по очереди при обработке во внешней памяти);
+    // заголовки форматов разбирает GraphFileFormat
+    class EdgeListParser
+    {
+    public:
+        // результат разбора одного куска файла
+        struct Chunk
+        {
+            std::vector<Domain::EdgeRecord> records;
+            std::size_t lines = 0;
+            int unparsable = 0;
+            Domain::NodeId maxNodeId = 0;
+            std::vector<std::pair<std::size_t, std::string>> warnings;  // номер строки в куске, строка
+            std::size_t joined = 0;      // связей с измеренными метриками (Options::metrics)
+            std::size_t unjoined = 0;
+            std::vector<std::pair<Domain::NodeId, Domain::NodeId>> unjoinedLinks;   // первые связи без метрик
+        };
+
+        // вид строк ребер
+        enum Dialect {
+            EDGE_LIST,   // "u v [weight]"; комментарии начинаются с #, % или /
+            DIMACS       // "a u v weight"; строки c (комментарий) и p (задача) пропускаются
+        };
+
+        struct Options
+        {
+            Dialect dialect = EDGE_LIST;
+            bool symmetric = false;    // строка задает связь в обе стороны с общими параметрами
+            bool synthesize = true;
+            std::uint64_t seed = Domain::ParameterSynthesizer::DEFAULT_SEED;
+            const LinkMetricsTable *metrics = nullptr;   // измеренные значения поверх файловых и синтезированных
+        };
+
+        static constexpr std::size_t WARNING_LINES = 20;   // предупреждения только для первых строк файла
+
+        // строки [begin, end) с разделителями пробел, табуляция или запятая; пустые строки пропускаются.
+        // вес из файла становится задержкой, при synthesize остальные параметры -
+        // ParameterSynthesizer(seed): зависят только от ребра, а не от куска
+        static Chunk parse(const char *begin, const char *end, const Options &options);
+
+        // число с позиции p, как вес ребра; nullptr - число не разобрано
+        static const char *parseValue(const char *p, const char *end, double &value);
+
+        // начало первой строки после position (end, если перевода строки больше нет)
+        static const char *nextLine(const char *position, const char *end);
+    };
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef EXTERNALGRAPHBUILDER_H
+#define EXTERNALGRAPHBUILDER_H
+
+#include "../domain/LinkParameterStore.h"
+#include "../domain/ParameterSynthesizer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Infrastructure
+{
+    // построение двоичного файла графа (BinaryGraphFormat) из списка ребер, не помещающегося в память:
+    // файл читается потоком, записи копятся в буфере в пределах бюджета памяти, сортируются по (источник,
+    // цель) и сбрасываются на диск прогонами; затем прогоны сливаются сразу в разделы CSR выходного файла.
+    // результат открывается BinaryGraphRepository отображением в память. повторы ребра схлопываются
+    // (побеждает последняя запись), нумерация вершин - по возрастанию id, как у CompactGraph::build
+    class ExternalGraphBuilder
+    {
+    public:
+        struct Settings
+        {
+            std::size_t memoryBudget = std::size_t(256) << 20;   // байт на записи прогона и буферы слияния
+            std::string temporaryDirectory;                      // пусто - рядом с выходным файлом
+            Domain::LinkParameterStore::Encoding encoding = Domain::LinkParameterStore::FULL_PRECISION;
+            bool synthesizeParameters = true;                    // как у FileGraphRepository
+            std::uint64_t seed = Domain::ParameterSynthesizer::DEFAULT_SEED;   // тот же граф, что и из текста
+            std::string metricsFile;                             // LinkMetricsTable; таблица держится в памяти
+        };
+
+        struct Stats
+        {
+            std::size_t records = 0;          // разобранных записей ребер
+            std::size_t runs = 0;             // отсортированных прогонов на диске
+            std::size_t nodes = 0;
+            std::size_t edges = 0;            // после схлопывания повторов
+            int unparsable = 0;
+            std::size_t joined = 0;           // связей с измеренными метриками
+            std::size_t unjoined = 0;         // связей без метрик (значения из списка ребер)
+            std::uint64_t temporaryBytes = 0; // объем прогонов на диске
+            double runTime = 0.0;             // ms, разбор, сортировка и запись прогонов
+            double mergeTime = 0.0;           // ms, слияние и запись выходного файла
+        };
+
+        ExternalGraphBuilder() : ExternalGraphBuilder(Settings()) {}
+        explicit ExternalGraphBuilder(const Settings &settings) : settings(settings) {}
+
+        // std::runtime_error - ошибка чтения или записи; выходной файл появляется только целиком,
+        // временные файлы удаляются и при ошибке
+        Stats build(const std::string &edge_list, const std::string &output) const;
+
+    private:
+        Settings settings;
+    };
+}
+
+#endif
@@ -3,6 +3,9 @@
 
 #include "../domain/NetworkGraph.h"
 #include "../domain/IGraphRepository.h"
+#include "../domain/ParameterSynthesizer.h"
+#include "GraphCache.h"
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -12,7 +15,44 @@ namespace Infrastructure
     {
     public:
         FileGraphRepository() = default;
+        // encoding - режим хранения параметров графа; synthesize_parameters = false оставляет
+        // у ребер только задержку из файла, остальные столбцы тогда не занимают памяти
+        FileGraphRepository(Domain::LinkParameterStore::Encoding encoding, bool synthesize_parameters)
+            : encoding(encoding), synthesizeParameters(synthesize_parameters) {}
+
+        // файл отображается в память и разбирается кусками по границам строк в нескольких потоках.
+        // разобранный граф сохраняется в кэш (GraphCache); при тех же содержимом файла и параметрах
+        // разбора следующая загрузка берет его из кэша без разбора
         Domain::NetworkGraphPtr loadGraph(const std::string &filename) override;
+
+        // verbose - показ первых строк файла и демонстрация параметров первого ребра
+        void setVerbose(bool verbose) { this->verbose = verbose; }
+
+        // seed синтеза параметров (ParameterSynthesizer): с одним seed загрузки дают одинаковые графы
+        void setSeed(std::uint64_t seed) { this->seed = seed; }
+
+        // файл измеренных метрик связей (LinkMetricsTable), присоединяемый при разборе;
+        // пустая строка - только значения из списка ребер
+        void setMetricsFile(const std::string &filename) { metricsFile = filename; }
+
+        // файл координат узлов (NodeCoordinateFile) для геометрической эвристики A*; читается при каждой
+        // загрузке, в том числе из кэша. пустая строка - без координат
+        void setCoordinateFile(const std::string &filename) { coordinateFile = filename; }
+
+        // каталог кэша разобранных графов; пустая строка отключает кэш
+        void setCacheDirectory(const std::string &directory) { cacheDirectory = directory; }
+
+    private:
+        // координаты из coordinateFile и проверка эвристики для задержки
+        void attachCoordinates(Domain::NetworkGraph &graph) const;
+
+        Domain::LinkParameterStore::Encoding encoding = Domain::LinkParameterStore::FULL_PRECISION;
+        bool synthesizeParameters = true;
+        bool verbose = false;
+        std::uint64_t seed = Domain::ParameterSynthesizer::DEFAULT_SEED;
+        std::string cacheDirectory = GraphCache::DEFAULT_DIRECTORY;
+        std::string metricsFile;
+        std::string coordinateFile;
     };
 
 }
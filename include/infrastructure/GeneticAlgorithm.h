@@ -6,9 +6,9 @@
 #include <random>
 #include <algorithm>
 #include <functional>
-#include <unordered_set>
 #include <queue>
 #include <unordered_map>
+#include <cstdint>
 
 namespace Infrastructure
 {
@@ -25,11 +25,14 @@ namespace Infrastructure
               gen(std::random_device{}()) {}
 
         HeuristicResult optimize(const Domain::NetworkGraphPtr &graph,
-                                 const std::vector<std::pair<int, int>> &demands) override;
+                                 const std::vector<Domain::NodePair> &demands) override;
 
     private:
+        // путь хранится в плотных индексах графа, внешние id нужны только в результате
+        using Path = std::vector<Domain::NodeIndex>;
+
         struct Chromosome {
-            std::vector<int> path;
+            Path path;
             double fitness;
             bool valid;
             
@@ -47,19 +50,28 @@ namespace Infrastructure
 
         // генетические операторы
         std::vector<Chromosome> initializePopulation(const Domain::NetworkGraphPtr &graph, 
-                                                   int start, int end);
-        double calculateFitness(const Chromosome &chromosome, const Domain::NetworkGraphPtr &graph, int start, int end);
-        Chromosome crossover(const Chromosome &parent1, const Chromosome &parent2, const Domain::NetworkGraphPtr &graph, int start, int end);
-        void mutate(Chromosome &chromosome, const Domain::NetworkGraphPtr &graph, int start, int end);
+                                                   Domain::NodeIndex start, Domain::NodeIndex end);
+        static std::size_t getPopulationBytes(const std::vector<Chromosome> &population);
+        double calculateFitness(const Chromosome &chromosome, const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end);
+        Chromosome crossover(const Chromosome &parent1, const Chromosome &parent2, const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end);
+        void mutate(Chromosome &chromosome, const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end);
         
         // методы генерации путей
-        std::vector<int> generateRandomPathBFS(const Domain::NetworkGraphPtr &graph, int start, int end);
-        std::vector<int> generateRandomPathDFS(const Domain::NetworkGraphPtr &graph, int start, int end);
-        std::vector<int> generateGreedyPath(const Domain::NetworkGraphPtr &graph, int start, int end);
+        Path generateRandomPathBFS(const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end);
+        Path generateRandomPathDFS(const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end);
+        Path generateGreedyPath(const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end);
         
         // Вспомогательные методы
-        bool isValidPath(const std::vector<int>& path, const Domain::NetworkGraphPtr &graph, int start, int end);
-        double calculatePathCost(const std::vector<int>& path, const Domain::NetworkGraphPtr &graph);
+        bool isValidPath(const Path& path, const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end);
+        double calculatePathCost(const Path& path, const Domain::NetworkGraphPtr &graph);
+
+        // отметки посещения по плотному индексу вместо unordered_set на каждый вызов
+        void resetVisited(const Domain::NetworkGraphPtr &graph);
+        bool isVisited(Domain::NodeIndex node) const { return visitStamp[node] == currentStamp; }
+        void markVisited(Domain::NodeIndex node) { visitStamp[node] = currentStamp; }
+
+        std::vector<std::uint32_t> visitStamp;
+        std::uint32_t currentStamp = 0;
     };
 }
 
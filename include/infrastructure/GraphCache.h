@@ -0,0 +1,40 @@
+#ifndef GRAPHCACHE_H
+#define GRAPHCACHE_H
+
+#include "../domain/NetworkGraph.h"
+#include <cstdint>
+#include <string>
+
+namespace Infrastructure
+{
+    // кэш разобранных графов с адресацией по содержимому: запись - двоичный файл графа (BinaryGraphFormat)
+    // и порядок вершин исходного графа под ключом из хэша содержимого входного файла и параметров разбора.
+    // хэш содержимого запоминается вместе с размером и временем изменения файла, поэтому для неизменного
+    // файла повторный запуск не читает его вовсе; переименованный или скопированный файл находит ту же запись
+    class GraphCache
+    {
+    public:
+        static constexpr const char *DEFAULT_DIRECTORY = ".graph_cache";
+
+        explicit GraphCache(const std::string &directory = DEFAULT_DIRECTORY) : directory(directory) {}
+
+        const std::string &getDirectory() const { return directory; }
+
+        // ключ записи для файла; options - отпечаток параметров разбора.
+        // std::runtime_error, если файл не открывается
+        std::uint64_t getKey(const std::string &filename, std::uint64_t options) const;
+
+        // граф из кэша; nullptr - записи нет или она повреждена
+        Domain::NetworkGraphPtr load(std::uint64_t key, const std::string &name) const;
+
+        // std::runtime_error - каталог или файл записи не создается
+        void store(std::uint64_t key, const Domain::NetworkGraph &graph) const;
+
+        std::string getEntryPath(std::uint64_t key) const;
+
+    private:
+        std::string directory;
+    };
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef GRAPHFILEFORMAT_H
+#define GRAPHFILEFORMAT_H
+
+#include "EdgeListParser.h"
+#include <cstddef>
+#include <string>
+
+namespace Infrastructure
+{
+    // текстовые форматы файлов графа и разбор их заголовков; строки ребер после заголовка
+    // разбирает EdgeListParser кусками, так же как простой список ребер
+    struct GraphFileFormat
+    {
+        enum Kind {
+            EDGE_LIST,       // "u v [weight]" через пробел, табуляцию или запятую
+            SNAP,            // список ребер SNAP: комментарии "# Nodes: N Edges: M", "# Undirected graph"
+            DIMACS,          // DIMACS shortest path (.gr): "p sp N M", дуги "a u v weight"
+            MATRIX_MARKET    // Matrix Market (.mtx): "%%MatrixMarket matrix coordinate ...", размер, "i j [value]"
+        };
+
+        Kind kind = EDGE_LIST;
+        bool symmetric = false;           // каждая строка задает связь в обе стороны
+        std::size_t headerBytes = 0;      // строки ребер начинаются после заголовка
+        std::size_t headerLines = 0;
+        std::size_t declaredNodes = 0;    // из заголовка, 0 - не указано
+        std::size_t declaredEdges = 0;    // строк ребер по заголовку
+
+        // формат по расширению (.gr, .mtx) или по началу текста [begin, end).
+        // std::runtime_error - заголовок не соответствует формату или вариант формата не поддерживается
+        static GraphFileFormat detect(const std::string &filename, const char *begin, const char *end);
+
+        // формат, заданный расширением файла; EDGE_LIST - расширение формата не задает
+        static Kind fromExtension(const std::string &filename);
+
+        static const char *getName(Kind kind);
+
+        EdgeListParser::Options getParserOptions(bool synthesize, std::uint64_t seed) const;
+    };
+}
+
+#endif
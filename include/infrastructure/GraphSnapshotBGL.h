@@ -0,0 +1,50 @@
+#ifndef GRAPHSNAPSHOTBGL_H
+#define GRAPHSNAPSHOTBGL_H
+
+#include "CompactGraphBGL.h"
+#include "../domain/GraphSnapshot.h"
+#include <boost/graph/filtered_graph.hpp>
+#include <unordered_map>
+
+// представление Domain::GraphSnapshot для BGL: базовый CSR-граф,
+// отфильтрованный по удаленным ребрам и узлам снимка
+namespace Infrastructure
+{
+    struct SnapshotEdgeFilter
+    {
+        const Domain::GraphSnapshot *snapshot = nullptr;
+
+        bool operator()(const CompactEdge &e) const { return snapshot->isEdgeActive(e.source, e.index); }
+    };
+
+    using SnapshotGraphView = boost::filtered_graph<Domain::CompactGraph, SnapshotEdgeFilter>;
+
+    inline SnapshotGraphView makeSnapshotView(const Domain::GraphSnapshot &snapshot)
+    {
+        return SnapshotGraphView(snapshot.getBase(), SnapshotEdgeFilter{&snapshot});
+    }
+
+    // веса базиса с подменой для ребер, чьи параметры переопределены в снимке
+    struct SnapshotWeightMap
+    {
+        using key_type = CompactEdge;
+        using value_type = double;
+        using reference = double;
+        using category = boost::readable_property_map_tag;
+
+        const Domain::PagedArray<double> *weights = nullptr;
+        const std::unordered_map<Domain::CompactGraph::EdgeIndex, double> *overrides = nullptr;
+    };
+
+    inline double get(const SnapshotWeightMap &map, const CompactEdge &e)
+    {
+        if (!map.overrides->empty())
+        {
+            auto it = map.overrides->find(e.index);
+            if (it != map.overrides->end()) return it->second;
+        }
+        return (*map.weights)[e.index];
+    }
+}
+
+#endif
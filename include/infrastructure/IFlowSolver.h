@@ -13,7 +13,7 @@ namespace Infrastructure
         double maxFlow = 0.0;                              // объем максимального потока
         double totalCost = 0.0;                            // время выполнения алгоритма (мс)
         double flowCost = 0.0;                             // суммарная стоимость потока (только для MinCostFlow)
-        std::map<std::pair<int, int>, double> flowPerEdge; // поток по каждому ребру
+        std::map<Domain::NodePair, double> flowPerEdge; // поток по каждому ребру
         std::string algorithmName;
         bool success = false;
         std::string errorMessage;
@@ -24,9 +24,9 @@ namespace Infrastructure
     public:
         virtual ~IFlowSolver() = default;
         virtual FlowResult solveMaxFlow(const Domain::NetworkGraphPtr &graph,
-                                        int source, int sink) = 0;
+                                        Domain::NodeId source, Domain::NodeId sink) = 0;
         virtual FlowResult solveMinCostMaxFlow(const Domain::NetworkGraphPtr &graph,
-                                               int source, int sink) = 0;
+                                               Domain::NodeId source, Domain::NodeId sink) = 0;
     };
 
     using IFlowSolverPtr = std::unique_ptr<IFlowSolver>;
@@ -13,10 +13,11 @@ namespace Infrastructure
     {
         bool success = false;
         double objective = 0.0;
-        std::vector<std::pair<int, int>> path;
-        std::map<std::pair<int, int>, double> flows;
+        std::vector<Domain::NodePair> path;
+        std::map<Domain::NodePair, double> flows;
         double executionTime = 0.0;
         std::string algorithmName;
+        std::size_t scratchBytes = 0;  // рабочие массивы решателя (байты, оценка)
     };
 
     class IHeuristicSolver
@@ -24,7 +25,7 @@ namespace Infrastructure
     public:
         virtual ~IHeuristicSolver() = default;
         virtual HeuristicResult optimize(const Domain::NetworkGraphPtr &graph,
-                                         const std::vector<std::pair<int, int>> &demands) = 0;
+                                         const std::vector<Domain::NodePair> &demands) = 0;
     };
 
     using IHeuristicSolverPtr = std::unique_ptr<IHeuristicSolver>;
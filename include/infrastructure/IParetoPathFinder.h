@@ -0,0 +1,76 @@
+#ifndef IPARETOPATHFINDER_H
+#define IPARETOPATHFINDER_H
+
+#include "../domain/NetworkTypes.h"
+#include "../domain/NetworkGraph.h"
+#include "../domain/CompactGraph.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Infrastructure
+{
+    // критерии маршрута, все минимизируются
+    struct RouteObjectives
+    {
+        enum Criterion {
+            LATENCY,            // сумма задержек
+            COST,               // сумма стоимостей
+            INVERSE_BANDWIDTH,  // 1 / пропускная способность узкого места
+            UNRELIABILITY,      // 1 - произведение надежностей
+            CRITERION_COUNT
+        };
+
+        std::array<double, CRITERION_COUNT> values{};
+
+        double getBandwidth() const { return 1.0 / values[INVERSE_BANDWIDTH]; }
+        double getReliability() const { return 1.0 - values[UNRELIABILITY]; }
+
+        // эпсилон-доминирование: не хуже other в (1 + epsilon) раз по каждому критерию;
+        // при epsilon = 0 - обычное нестрогое доминирование
+        bool dominates(const RouteObjectives &other, double epsilon = 0.0) const
+        {
+            for (int i = 0; i < CRITERION_COUNT; ++i)
+                if (values[i] > other.values[i] * (1.0 + epsilon))
+                    return false;
+            return true;
+        }
+    };
+
+    struct ParetoRoute
+    {
+        std::vector<Domain::NodeId> pathNodes;
+        RouteObjectives objectives;
+    };
+
+    struct ParetoResult
+    {
+        bool success = false;
+        std::string errorMessage;
+        std::vector<ParetoRoute> routes;   // фронт Парето, по возрастанию задержки
+        std::size_t labelsCreated = 0;     // меток поставлено в очередь
+        std::size_t labelsPruned = 0;      // отброшено доминированием
+        bool truncated = false;            // сработало ограничение числа меток (фронт неполный)
+        double executionTime = 0.0;        // ms
+        std::string algorithmName;
+        std::size_t scratchBytes = 0;      // метки, множества меток вершин и очередь (байты)
+    };
+
+    // многокритериальный поиск: все недоминируемые маршруты за один проход
+    class IParetoPathFinder
+    {
+    public:
+        virtual ~IParetoPathFinder() = default;
+        virtual ParetoResult findParetoFront(
+            const Domain::NetworkGraphPtr &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) = 0;
+        virtual ParetoResult findParetoFront(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) = 0;
+        virtual std::string getAlgorithmName() const = 0;
+    };
+    using IParetoPathFinderPtr = std::unique_ptr<IParetoPathFinder>;
+}
+
+#endif
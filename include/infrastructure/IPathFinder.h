@@ -3,6 +3,7 @@
 
 #include "../domain/NetworkTypes.h"
 #include "../domain/NetworkGraph.h"
+#include "../domain/CompactGraph.h"
 #include <memory>
 
 namespace Infrastructure
@@ -13,7 +14,11 @@ namespace Infrastructure
         virtual ~IPathFinder() = default;
         virtual Domain::PathResult findShortestPath(
             const Domain::NetworkGraphPtr &graph,
-            int start_id, int end_id) = 0;
+            Domain::NodeId start_id, Domain::NodeId end_id) = 0;
+        // поиск по готовому CSR-снимку (без перестроения графа на каждый запрос)
+        virtual Domain::PathResult findShortestPath(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) = 0;
         virtual std::string getAlgorithmName() const = 0;
     };
     using IPathFinderPtr = std::unique_ptr<IPathFinder>;
@@ -0,0 +1,58 @@
+#ifndef LINKMETRICSTABLE_H
+#define LINKMETRICSTABLE_H
+
+#include "../domain/NetworkTypes.h"
+#include "../domain/LinkParameterStore.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Infrastructure
+{
+    // измеренные параметры связей из отдельного файла (выгрузки метрик), присоединяемые к ребрам
+    // при разборе списка ребер по ключу (источник, цель). файл - CSV с заголовком "source,target,<столбцы>",
+    // столбцы - любое подмножество параметров связи (имена или номера, как у TelemetryIngestor),
+    // разделитель - запятая, табуляция или пробелы. пустое поле оставляет значение из списка ребер,
+    // повтор ключа перезаписывает строку, неизвестные столбцы пропускаются
+    class LinkMetricsTable
+    {
+    public:
+        // файл метрик, лежащий рядом со списком ребер: <список ребер>.metrics.csv
+        static constexpr const char *SIDECAR_SUFFIX = ".metrics.csv";
+        // путь к такому файлу или пустая строка, если его нет
+        static std::string findSidecar(const std::string &edge_list);
+
+        // std::runtime_error - файл не открывается или в заголовке нет столбцов параметров
+        explicit LinkMetricsTable(const std::string &filename);
+
+        // заполнение параметров связи u -> v измеренными значениями; symmetric - строка ищется
+        // и по ключу (v, u). false - метрик для связи нет, params не меняются. безопасно из нескольких потоков
+        bool apply(Domain::NodeId u, Domain::NodeId v, bool symmetric, Domain::LinkParameters &params) const;
+
+        std::size_t getRowCount() const { return sources.size(); }
+        int getUnparsable() const { return unparsable; }
+        const std::vector<Domain::LinkParameterStore::Column> &getColumns() const { return columns; }
+        const std::vector<std::string> &getSkippedColumns() const { return skippedColumns; }
+
+        // строки, не присоединенные ни к одному ребру
+        std::size_t getUnusedRowCount() const;
+
+    private:
+        std::size_t find(Domain::NodeId u, Domain::NodeId v) const;   // NOT_FOUND - нет строки
+
+        static constexpr std::size_t NOT_FOUND = ~std::size_t(0);
+
+        std::vector<Domain::LinkParameterStore::Column> columns;
+        std::vector<std::string> skippedColumns;
+        std::vector<Domain::NodeId> sources, targets;
+        std::vector<double> values;            // по строкам, columns.size() на строку; NaN - поле пусто
+        std::vector<std::uint32_t> slots;      // открытая адресация: номер строки + 1, 0 - пусто
+        std::unique_ptr<std::atomic<bool>[]> used;
+        int unparsable = 0;
+    };
+}
+
+#endif
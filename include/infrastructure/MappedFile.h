@@ -0,0 +1,42 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace Infrastructure
+{
+    // файл, отображенный в память только для чтения: страницы подгружаются ОС по мере чтения,
+    // содержимое не копируется в буферы процесса
+    class MappedFile
+    {
+    public:
+        // подсказка ОС о порядке чтения страниц
+        enum Access {
+            SEQUENTIAL,   // один проход от начала к концу (разбор текста)
+            RANDOM        // обращения вразнобой (структуры графа поверх файла)
+        };
+
+        // std::runtime_error, если файл не открывается или не отображается
+        explicit MappedFile(const std::string &filename, Access access = SEQUENTIAL);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const char *data() const { return view; }
+        std::size_t size() const { return length; }
+
+    private:
+        const char *view = nullptr;   // nullptr для пустого файла
+        std::size_t length = 0;
+#ifdef _WIN32
+        void *file = nullptr;
+        void *mapping = nullptr;
+#else
+        int descriptor = -1;
+#endif
+    };
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef MEMORYPROBE_H
+#define MEMORYPROBE_H
+
+#include <cstddef>
+
+namespace Infrastructure
+{
+    // замер резидентной памяти процесса (RSS) вокруг вызова решателя
+    class MemoryProbe
+    {
+    public:
+        struct Sample {
+            std::size_t currentRss = 0;   // байты, 0 - платформа не поддерживается
+            std::size_t peakRss = 0;      // пик процесса с запуска или с последнего resetPeak()
+        };
+
+        static Sample sample();
+        // сброс пика процесса (Linux); false - пик не сбрасывается и замер дает нижнюю оценку
+        static bool resetPeak();
+
+        // начало замера: пик сбрасывается, если платформа позволяет
+        MemoryProbe();
+
+        // прирост пика RSS над уровнем в начале замера
+        std::size_t getPeakIncrease() const;
+        // изменение RSS от начала замера (память, оставшаяся занятой)
+        long long getRetained() const;
+
+    private:
+        Sample start;
+        bool exactPeak;
+    };
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef NODECOORDINATEFILE_H
+#define NODECOORDINATEFILE_H
+
+#include "../domain/NodeCoordinates.h"
+#include <string>
+
+namespace Infrastructure
+{
+    // файл координат узлов для геометрической эвристики A*:
+    //  - CSV "id,x,y" (разделитель - запятая, табуляция или пробелы, комментарии #). заголовок необязателен;
+    //    столбцы lat/latitude и lon/lng/longitude задают географические координаты, x и y - плоские,
+    //    без заголовка или без этих имен - плоские, второй и третий столбцы;
+    //  - DIMACS (.co): строки "v id x y", долгота и широта в миллионных долях градуса
+    class NodeCoordinateFile
+    {
+    public:
+        static constexpr const char *SIDECAR_SUFFIX = ".nodes.csv";
+        static constexpr const char *DIMACS_EXTENSION = ".co";
+
+        // файл координат рядом со списком ребер: <список ребер>.nodes.csv, для DIMACS .gr - одноименный .co;
+        // пустая строка - такого файла нет
+        static std::string findSidecar(const std::string &edge_list);
+
+        // std::runtime_error - файл не открывается или в нем нет ни одной точки;
+        // std::invalid_argument - координата вне допустимого диапазона
+        explicit NodeCoordinateFile(const std::string &filename);
+
+        const Domain::NodeCoordinatesPtr &getCoordinates() const { return coordinates; }
+        int getUnparsable() const { return unparsable; }
+
+    private:
+        Domain::NodeCoordinatesPtr coordinates;
+        int unparsable = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef PARETOPATHFINDER_H
+#define PARETOPATHFINDER_H
+
+#include "../domain/NetworkGraph.h"
+#include "../domain/CompactGraph.h"
+#include "IPathFinder.h"
+#include "IParetoPathFinder.h"
+
+namespace Infrastructure
+{
+    // поиск с расстановкой меток (Martins): метки извлекаются в лексикографическом порядке критериев,
+    // у каждой вершины хранится множество недоминируемых меток. для управляемости - эпсилон-доминирование,
+    // отсечение по уже найденным меткам цели и ограничения числа меток на вершину и всего
+    class ParetoPathFinder : public IPathFinder, public IParetoPathFinder
+    {
+    public:
+        struct Settings
+        {
+            double epsilon = 0.01;               // относительная точность фронта (0 - точный фронт)
+            std::size_t maxLabelsPerNode = 32;   // новые метки сверх предела отбрасываются
+            std::size_t maxLabels = 1000000;     // всего меток за поиск
+        };
+
+        ParetoPathFinder() : ParetoPathFinder(Settings()) {}
+        explicit ParetoPathFinder(const Settings &settings) : settings(settings) {}
+
+        ParetoResult findParetoFront(
+            const Domain::NetworkGraphPtr &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
+
+        ParetoResult findParetoFront(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
+
+        // как IPathFinder: маршрут фронта с наименьшей задержкой, totalCost - его задержка
+        Domain::PathResult findShortestPath(
+            const Domain::NetworkGraphPtr &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
+
+        Domain::PathResult findShortestPath(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id) override;
+
+        std::string getAlgorithmName() const override { return "Pareto Label-Setting"; }
+
+        static ParetoResult findParetoFrontStatic(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id,
+            const Settings &settings);
+        static ParetoResult findParetoFrontStatic(
+            const Domain::CompactGraph &graph,
+            Domain::NodeId start_id, Domain::NodeId end_id)
+        {
+            return findParetoFrontStatic(graph, start_id, end_id, Settings());
+        }
+
+        // критерии готового маршрута (для сравнения с однокритериальными поисками);
+        // false - в графе нет одного из ребер маршрута
+        static bool evaluateRoute(const Domain::CompactGraph &graph, const std::vector<Domain::NodeId> &path,
+                                  RouteObjectives &objectives);
+
+    private:
+        Settings settings;
+    };
+}
+
+#endif
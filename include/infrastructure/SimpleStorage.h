@@ -17,6 +17,10 @@ namespace Infrastructure
                                         const std::vector<AlgorithmComparison>& results);
         static void logEvent(const std::string& event);
         static void saveGraphInfo(const Domain::NetworkGraphPtr& graph, const std::string& filename);
+        // разбивка памяти графа по структурам и память алгоритмов (CSV)
+        static void saveMemoryReport(const Domain::NetworkGraphPtr& graph,
+                                     const std::vector<AlgorithmComparison>& results,
+                                     const std::string& filename);
         static void saveComparisonTable(const std::vector<AlgorithmComparison>& results, 
                                       const std::string& filename);
     };
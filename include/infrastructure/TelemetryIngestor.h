@@ -0,0 +1,123 @@
+#ifndef TELEMETRYINGESTOR_H
+#define TELEMETRYINGESTOR_H
+
+#include "../domain/NetworkGraph.h"
+#include "../domain/ConcurrentGraph.h"
+#include "../domain/LinkParameterStore.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Infrastructure
+{
+    // изменение одного параметра связи из потока телеметрии
+    struct TelemetryUpdate
+    {
+        Domain::NodeId source;
+        Domain::NodeId target;
+        Domain::LinkParameterStore::Column column;
+        double value;
+    };
+
+    // потоковое применение телеметрии к графу: обновления накапливаются в пакет,
+    // повторы одного параметра схлопываются (побеждает последнее значение), пакет
+    // применяется целиком. кэши весов и CSR-снимок пересчитываются только по измененным ребрам
+    class TelemetryIngestor
+    {
+    public:
+        // CSV: "source,target,column,value", column - имя (latency, utilization, ...) или номер;
+        // BINARY: записи по 32 байта: int64 source, int64 target, uint32 column, 4 байта выравнивания, double value
+        enum Format { CSV, BINARY };
+
+        struct Settings
+        {
+            Format format = CSV;
+            std::size_t batchSize = 4096;                  // пакет применяется при наборе этого числа обновлений
+            std::chrono::milliseconds maxDelay{100};       // или по истечении этого времени с первого обновления пакета
+        };
+
+        struct Stats
+        {
+            std::size_t received = 0;      // обновлений прочитано
+            std::size_t coalesced = 0;     // схлопнуто внутри пакетов
+            std::size_t applied = 0;       // применено к графу
+            std::size_t rejected = 0;      // неизвестное ребро или неразборная запись
+            std::size_t batches = 0;
+            double elapsedSeconds = 0.0;
+            double updatesPerSecond = 0.0; // применение по прочитанным обновлениям за все время работы
+            double avgApplyMs = 0.0;       // время применения пакета (включая публикацию версии)
+            double p95ApplyMs = 0.0;
+            double maxApplyMs = 0.0;
+            double avgBatchDelayMs = 0.0;  // от первого обновления пакета до его применения
+        };
+
+        TelemetryIngestor(const Domain::NetworkGraphPtr &graph, const Settings &settings);
+        explicit TelemetryIngestor(const Domain::NetworkGraphPtr &graph) : TelemetryIngestor(graph, Settings()) {}
+        // для графа с параллельными читателями: после каждого пакета публикуется новая версия
+        TelemetryIngestor(Domain::ConcurrentGraph &graph, const Settings &settings);
+        explicit TelemetryIngestor(Domain::ConcurrentGraph &graph) : TelemetryIngestor(graph, Settings()) {}
+
+        // чтение потока (файл, канал) до конца
+        Stats run(std::istream &in);
+        // чтение растущего файла (tail -f) до установки stop
+        Stats follow(const std::string &filename, const std::atomic<bool> &stop,
+                     std::chrono::milliseconds poll_interval = std::chrono::milliseconds(50));
+
+        // ручная подача обновлений
+        void push(const TelemetryUpdate &update);
+        void flush();
+
+        Stats getStats() const;
+        static void printStats(const Stats &stats);
+
+        static bool parseColumn(const std::string &name, Domain::LinkParameterStore::Column &column);
+
+    private:
+        struct UpdateKey
+        {
+            Domain::NodeId source;
+            Domain::NodeId target;
+            int column;
+            bool operator==(const UpdateKey &other) const
+            {
+                return source == other.source && target == other.target && column == other.column;
+            }
+        };
+
+        struct UpdateKeyHash
+        {
+            std::size_t operator()(const UpdateKey &key) const
+            {
+                std::size_t h = std::hash<Domain::NodeId>()(key.source);
+                h ^= std::hash<Domain::NodeId>()(key.target) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+                return h * 8 + static_cast<std::size_t>(key.column);
+            }
+        };
+
+        using Clock = std::chrono::steady_clock;
+
+        // чтение всех доступных записей; при tail недочитанная запись остается в потоке
+        void readAvailable(std::istream &in, bool tail);
+        bool parseLine(const std::string &line, TelemetryUpdate &update) const;
+        bool applyUpdate(const TelemetryUpdate &update);
+
+        Domain::NetworkGraph *graph = nullptr;
+        Domain::ConcurrentGraph *concurrent = nullptr;
+        Settings settings;
+
+        std::unordered_map<UpdateKey, double, UpdateKeyHash> pending;
+        Clock::time_point batchStart;
+        Clock::time_point started;
+        bool startedSet = false;
+
+        Stats stats;
+        std::vector<double> applyTimes;
+        double totalBatchDelayMs = 0.0;
+    };
+}
+
+#endif
@@ -1,5 +1,8 @@
 #include "application/GraphAnalysisFactory.h"
 #include "infrastructure/FileGraphRepository.h"
+#include "infrastructure/BinaryGraphRepository.h"
+#include "infrastructure/LinkMetricsTable.h"
+#include "infrastructure/NodeCoordinateFile.h"
 #include "infrastructure/BGLShortestPath.h"
 #include "infrastructure/AStarPathFinder.h"
 #include "infrastructure/BoostFlowSolver.h"
@@ -13,6 +16,17 @@ namespace Application
         return std::make_unique<Infrastructure::FileGraphRepository>();
     }
 
+    std::unique_ptr<Domain::IGraphRepository> GraphAnalysisFactory::createRepository(const std::string &filename)
+    {
+        if (Infrastructure::BinaryGraphRepository::isBinaryGraphFile(filename))
+            return std::make_unique<Infrastructure::BinaryGraphRepository>();
+        // измеренные метрики связей и координаты узлов из файлов рядом со списком ребер
+        auto repository = std::make_unique<Infrastructure::FileGraphRepository>();
+        repository->setMetricsFile(Infrastructure::LinkMetricsTable::findSidecar(filename));
+        repository->setCoordinateFile(Infrastructure::NodeCoordinateFile::findSidecar(filename));
+        return repository;
+    }
+
     Infrastructure::IPathFinderPtr GraphAnalysisFactory::createPathFinder()
     {
         return createAStarPathFinder(true, Domain::WeightCalculator::BALANCE_LOAD);
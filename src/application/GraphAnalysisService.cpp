@@ -1,6 +1,7 @@
 #include "application/GraphAnalysisService.h"
 #include "application/GraphAnalysisFactory.h"
 #include "infrastructure/ThreadPool.h"
+#include "domain/ConcurrentGraph.h"
 #include <chrono>
 
 namespace Application
@@ -8,7 +9,7 @@ namespace Application
 
     Domain::PathResult GraphAnalysisService::analyzeShortestPath(
         const Domain::NetworkGraphPtr &graph,
-        int start_id, int end_id)
+        Domain::NodeId start_id, Domain::NodeId end_id)
     {
         auto finder = GraphAnalysisFactory::createPathFinder();
         return finder->findShortestPath(graph, start_id, end_id);
@@ -16,7 +17,7 @@ namespace Application
 
     std::vector<Domain::PathResult> GraphAnalysisService::analyzePathsParallel(
         const Domain::NetworkGraphPtr &graph,
-        const std::vector<std::pair<int, int>> &routes)
+        const std::vector<Domain::NodePair> &routes)
     {
         Infrastructure::ThreadPool pool(4);
         std::vector<std::future<Domain::PathResult>> futures;
@@ -39,4 +40,30 @@ namespace Application
         return results;
     }
 
+    std::vector<Domain::PathResult> GraphAnalysisService::analyzePathsParallel(
+        const Domain::ConcurrentGraph &graph,
+        const std::vector<Domain::NodePair> &routes)
+    {
+        Infrastructure::ThreadPool pool(4);
+        std::vector<std::future<Domain::PathResult>> futures;
+
+        for (const auto &[start, end] : routes)
+        {
+            futures.push_back(pool.enqueue(
+                [&graph, start, end]()
+                {
+                    auto pinned = graph.pin();
+                    auto finder = Application::GraphAnalysisFactory::createPathFinder();
+                    return finder->findShortestPath(*pinned, start, end);
+                }));
+        }
+
+        std::vector<Domain::PathResult> results;
+        for (auto &fut : futures)
+        {
+            results.push_back(fut.get());
+        }
+        return results;
+    }
+
 }
\ No newline at end of file
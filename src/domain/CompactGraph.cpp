@@ -0,0 +1,244 @@
+#include "domain/CompactGraph.h"
+#include "domain/NetworkGraph.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Domain
+{
+    CompactGraphPtr CompactGraph::build(const NetworkGraph &graph, std::vector<EdgeIndex> *edge_index)
+    {
+        auto compact = std::make_shared<CompactGraph>();
+
+        // упорядоченные id дают детерминированную нумерацию вершин
+        std::vector<std::pair<NodeId, NodeIndex>> order;
+        order.reserve(graph.indexById.size());
+        for (NodeIndex i = 0; i < graph.nodeIds.size(); ++i)
+            if (graph.active[i]) order.emplace_back(graph.nodeIds[i], i);
+        std::sort(order.begin(), order.end());
+
+        const std::size_t n = order.size();
+        if (n >= INVALID_NODE)
+            throw std::length_error("Graph too large for CompactGraph");
+
+        // перевод плотных индексов графа в индексы CSR без поиска по id
+        std::vector<NodeIndex> compactIndex(graph.nodeIds.size(), INVALID_NODE);
+        compact->nodeIds.reserve(n);
+        for (NodeIndex u = 0; u < n; ++u)
+        {
+            compact->nodeIds.push_back(order[u].first);
+            compactIndex[order[u].second] = u;
+        }
+
+        compact->parameters = LinkParameterStore(graph.parameters.getEncoding());
+        compact->offsets.assign(n + 1, 0);
+        compact->targets.reserve(graph.parameters.getActiveCount());
+        compact->parameters.reserve(graph.parameters.getActiveCount());
+        std::vector<std::pair<NodeIndex, LinkParameterStore::EdgeId>> row;
+        if (edge_index) edge_index->assign(graph.parameters.size(), INVALID_EDGE);
+
+        for (NodeIndex u = 0; u < n; ++u)
+        {
+            compact->offsets[u] = static_cast<EdgeIndex>(compact->targets.size());
+            const auto &out = graph.adjacency[order[u].second];
+
+            row.clear();
+            row.reserve(out.size());
+            for (const auto &kv : out)
+                row.emplace_back(compactIndex[kv.first], kv.second);
+            std::sort(row.begin(), row.end(),
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+
+            for (const auto &[v, id] : row)
+            {
+                if (edge_index) (*edge_index)[id] = static_cast<EdgeIndex>(compact->targets.size());
+                compact->targets.push_back(v);
+                compact->parameters.add(graph.parameters.get(id));
+            }
+        }
+        if (compact->targets.size() >= INVALID_EDGE)
+            throw std::length_error("Too many edges for CompactGraph");
+        compact->offsets[n] = static_cast<EdgeIndex>(compact->targets.size());
+
+        compact->share();
+        return compact;
+    }
+
+    CompactGraphPtr CompactGraph::withParameters(const CompactGraph &base,
+                                                 const std::vector<std::pair<EdgeIndex, LinkParameters>> &changes)
+    {
+        auto compact = std::make_shared<CompactGraph>();
+        compact->nodeIds = base.nodeIds;
+        compact->sortedIds = base.sortedIds;
+        compact->sortedIndex = base.sortedIndex;
+        compact->offsets = base.offsets;
+        compact->targets = base.targets;
+        compact->parameters = base.parameters;
+        for (const auto &[e, params] : changes)
+            compact->parameters.set(e, params);
+
+        std::lock_guard<std::mutex> lock(base.weightsMutex);
+        for (const auto &[key, cached] : base.weightsCache)
+        {
+            if (!cached) continue;
+            auto strategy = static_cast<WeightCalculator::Strategy>(key);
+            auto weights = std::make_shared<PagedArray<double>>(*cached);
+            // веса - от значений, как они сохранены (с округлением режима хранения), как при полном построении
+            for (const auto &change : changes)
+                weights->set(change.first,
+                             WeightCalculator::calculateCompositeWeight(compact->parameters.get(change.first), strategy));
+            compact->weightsCache.emplace(key, std::move(weights));
+        }
+        return compact;
+    }
+
+    CompactGraphPtr CompactGraph::fromArrays(Arrays arrays)
+    {
+        const std::size_t n = arrays.nodeIds.size();
+        const std::size_t m = arrays.targets.size();
+        if (arrays.offsets.size() != n + 1 || arrays.offsets[0] != 0 || arrays.offsets[n] != m)
+            throw std::invalid_argument("CSR offsets do not match node and edge counts");
+        if (m >= INVALID_EDGE)
+            throw std::length_error("Too many edges for CompactGraph");
+        if (arrays.parameters.size() != m || arrays.parameters.getActiveCount() != m)
+            throw std::invalid_argument("Edge parameters do not match edge count");
+        if (arrays.sortedIds.size() != arrays.sortedIndex.size() || (!arrays.sortedIds.empty() && arrays.sortedIds.size() != n))
+            throw std::invalid_argument("Sorted id index does not match node count");
+
+        auto compact = std::make_shared<CompactGraph>();
+        compact->nodeIds = std::move(arrays.nodeIds);
+        compact->sortedIds = std::move(arrays.sortedIds);
+        compact->sortedIndex = std::move(arrays.sortedIndex);
+        compact->offsets = std::move(arrays.offsets);
+        compact->targets = std::move(arrays.targets);
+        compact->parameters = std::move(arrays.parameters);
+        compact->share();
+        return compact;
+    }
+
+    CompactGraphPtr CompactGraph::permute(const CompactGraph &base, const std::vector<NodeIndex> &order,
+                                          std::vector<EdgeIndex> *edge_map)
+    {
+        const std::size_t n = base.getNodeCount();
+        if (order.size() != n)
+            throw std::invalid_argument("Node order does not match graph size");
+
+        std::vector<NodeIndex> position(n, INVALID_NODE);
+        for (NodeIndex i = 0; i < n; ++i)
+        {
+            if (order[i] >= n || position[order[i]] != INVALID_NODE)
+                throw std::invalid_argument("Node order is not a permutation");
+            position[order[i]] = i;
+        }
+
+        auto compact = std::make_shared<CompactGraph>();
+        compact->parameters = LinkParameterStore(base.parameters.getEncoding());
+        compact->nodeIds.reserve(n);
+        for (NodeIndex i = 0; i < n; ++i)
+            compact->nodeIds.push_back(base.nodeIds[order[i]]);
+
+        // поиск по id идет через отдельный отсортированный массив
+        std::vector<std::pair<NodeId, NodeIndex>> byId;
+        byId.reserve(n);
+        for (NodeIndex i = 0; i < n; ++i)
+            byId.emplace_back(compact->nodeIds[i], i);
+        std::sort(byId.begin(), byId.end());
+        compact->sortedIds.reserve(n);
+        compact->sortedIndex.reserve(n);
+        for (const auto &[id, index] : byId)
+        {
+            compact->sortedIds.push_back(id);
+            compact->sortedIndex.push_back(index);
+        }
+
+        compact->offsets.assign(n + 1, 0);
+        compact->targets.reserve(base.getEdgeCount());
+        compact->parameters.reserve(base.getEdgeCount());
+        if (edge_map) edge_map->assign(base.getEdgeCount(), INVALID_EDGE);
+        std::vector<std::pair<NodeIndex, EdgeIndex>> row;
+
+        for (NodeIndex u = 0; u < n; ++u)
+        {
+            compact->offsets[u] = static_cast<EdgeIndex>(compact->targets.size());
+            NodeIndex old = order[u];
+
+            row.clear();
+            for (auto e = base.edgesBegin(old); e != base.edgesEnd(old); ++e)
+                row.emplace_back(position[base.targets[e]], e);
+            std::sort(row.begin(), row.end());
+
+            for (const auto &[v, e] : row)
+            {
+                if (edge_map) (*edge_map)[e] = static_cast<EdgeIndex>(compact->targets.size());
+                compact->targets.push_back(v);
+                compact->parameters.add(base.parameters.get(e));
+            }
+        }
+        compact->offsets[n] = static_cast<EdgeIndex>(compact->targets.size());
+        compact->share();
+        return compact;
+    }
+
+    void CompactGraph::share()
+    {
+        nodeIds.share();
+        sortedIds.share();
+        sortedIndex.share();
+        offsets.share();
+        targets.share();
+        parameters.share();
+    }
+
+    CompactGraph::NodeIndex CompactGraph::findIndex(NodeId id) const
+    {
+        // в исходном порядке индексы упорядочены по id, после перенумерации - через sortedIds
+        const auto &ids = sortedIds.empty() ? nodeIds : sortedIds;
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it == ids.end() || *it != id)
+            return INVALID_NODE;
+        auto pos = static_cast<std::size_t>(it - ids.begin());
+        return sortedIds.empty() ? static_cast<NodeIndex>(pos) : sortedIndex[pos];
+    }
+
+    CompactGraph::EdgeIndex CompactGraph::findEdge(NodeIndex u, NodeIndex v) const
+    {
+        auto first = targets.begin() + offsets[u];
+        auto last = targets.begin() + offsets[u + 1];
+        auto it = std::lower_bound(first, last, v);
+        if (it == last || *it != v)
+            return INVALID_EDGE;
+        return static_cast<EdgeIndex>(it - targets.begin());
+    }
+
+    CompactGraph::WeightArray CompactGraph::getEdgeWeights(WeightCalculator::Strategy strategy) const
+    {
+        std::lock_guard<std::mutex> lock(weightsMutex);
+        auto &cached = weightsCache[static_cast<int>(strategy)];
+        if (!cached)
+        {
+            std::vector<double> values;
+            WeightCalculator::calculateWeights(parameters, strategy, values);
+            auto weights = std::make_shared<PagedArray<double>>(ArrayStorage<double>(std::move(values)));
+            weights->share();
+            cached = std::move(weights);
+        }
+        return cached;
+    }
+
+    MemoryUsage CompactGraph::getMemoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.add("node ids", nodeIds.getMemoryUsage() + sortedIds.getMemoryUsage() + sortedIndex.getMemoryUsage());
+        usage.add("offsets", offsets.getMemoryUsage());
+        usage.add("targets", targets.getMemoryUsage());
+        usage.add("parameters", parameters.getMemoryUsage());
+
+        std::size_t weights = 0;
+        {
+            std::lock_guard<std::mutex> lock(weightsMutex);
+            for (const auto &entry : weightsCache)
+                if (entry.second) weights += entry.second->getMemoryUsage();
+        }
+        usage.add("weight arrays", weights);
+        return usage;
+    }
+}
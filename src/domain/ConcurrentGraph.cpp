@@ -0,0 +1,108 @@
+#include "domain/ConcurrentGraph.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace Domain
+{
+    ConcurrentGraph::ReadGuard &ConcurrentGraph::ReadGuard::operator=(ReadGuard &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            slot = std::exchange(other.slot, nullptr);
+            graph = std::exchange(other.graph, nullptr);
+            epoch = other.epoch;
+        }
+        return *this;
+    }
+
+    void ConcurrentGraph::ReadGuard::release()
+    {
+        if (slot)
+        {
+            slot->store(0);
+            slot = nullptr;
+        }
+    }
+
+    ConcurrentGraph::ConcurrentGraph(NetworkGraphPtr graph, std::size_t reader_slots)
+        : graph(std::move(graph))
+    {
+        if (!this->graph)
+            throw std::invalid_argument("ConcurrentGraph requires a graph");
+        if (reader_slots == 0)
+            reader_slots = std::max<std::size_t>(64, 4 * std::thread::hardware_concurrency());
+        slotCount = reader_slots;
+        slots.reset(new ReaderSlot[slotCount]);
+
+        currentOwner = this->graph->getCompactGraph();
+        current.store(currentOwner.get());
+    }
+
+    ConcurrentGraph::~ConcurrentGraph() = default;
+
+    ConcurrentGraph::ReadGuard ConcurrentGraph::pin() const
+    {
+        // поток начинает поиск свободного слота с того, что занимал в прошлый раз
+        thread_local std::size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+        for (;;)
+        {
+            for (std::size_t i = 0; i < slotCount; ++i)
+            {
+                std::size_t index = (hint + i) % slotCount;
+                auto &slot = slots[index].epoch;
+                if (slot.load(std::memory_order_relaxed) != 0) continue;
+
+                // эпоха объявляется до чтения указателя: писатель не освободит версию,
+                // которую читатель мог увидеть после этого объявления
+                std::uint64_t pinned = epoch.load();
+                std::uint64_t expected = 0;
+                if (!slot.compare_exchange_strong(expected, pinned)) continue;
+
+                hint = index;
+                return ReadGuard(&slot, current.load(), pinned);
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    std::uint64_t ConcurrentGraph::publish()
+    {
+        CompactGraphPtr next = graph->getCompactGraph();
+        if (next == currentOwner) return epoch.load();
+
+        current.store(next.get());
+        std::uint64_t published = epoch.fetch_add(1) + 1;
+        retired.push_back({published, std::move(currentOwner)});
+        currentOwner = std::move(next);
+
+        reclaim();
+        return published;
+    }
+
+    std::size_t ConcurrentGraph::reclaim()
+    {
+        // версию, снятую в эпоху r, может удерживать только читатель, закрепившийся раньше r
+        std::uint64_t oldest = getOldestPinnedEpoch();
+        auto alive = std::remove_if(retired.begin(), retired.end(),
+                                    [oldest](const RetiredVersion &version) { return version.epoch <= oldest; });
+        std::size_t freed = static_cast<std::size_t>(retired.end() - alive);
+        retired.erase(alive, retired.end());
+        return freed;
+    }
+
+    std::uint64_t ConcurrentGraph::getOldestPinnedEpoch() const
+    {
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t i = 0; i < slotCount; ++i)
+        {
+            std::uint64_t pinned = slots[i].epoch.load();
+            if (pinned != 0) oldest = std::min(oldest, pinned);
+        }
+        return oldest;
+    }
+}
@@ -0,0 +1,95 @@
+#include "domain/CustomStrategy.h"
+#include "domain/WeightPolicies.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Domain
+{
+    namespace
+    {
+        const char *const TERM_NAMES[CustomStrategy::TERM_COUNT] = {
+            "latency", "bandwidth", "packet_loss", "utilization", "cost", "reliability",
+            "effective_latency", "inverse_bandwidth", "inverse_current_bandwidth", "unreliability",
+            "utilization_excess"};
+
+        unsigned termColumns(CustomStrategy::Term term)
+        {
+            using WeightPolicy::columnBit;
+            switch (term)
+            {
+            case CustomStrategy::EFFECTIVE_LATENCY:
+                return columnBit(LinkParameterStore::LATENCY) | columnBit(LinkParameterStore::UTILIZATION);
+            case CustomStrategy::INVERSE_BANDWIDTH:
+                return columnBit(LinkParameterStore::BANDWIDTH);
+            case CustomStrategy::INVERSE_CURRENT_BANDWIDTH:
+                return columnBit(LinkParameterStore::BANDWIDTH) | columnBit(LinkParameterStore::PACKET_LOSS);
+            case CustomStrategy::UNRELIABILITY:
+                return columnBit(LinkParameterStore::PACKET_LOSS) | columnBit(LinkParameterStore::UTILIZATION);
+            case CustomStrategy::UTILIZATION_EXCESS:
+                return columnBit(LinkParameterStore::UTILIZATION);
+            default:
+                // линейное слагаемое читает свой столбец
+                return columnBit(static_cast<LinkParameterStore::Column>(term));
+            }
+        }
+    }
+
+    CustomStrategy::CustomStrategy(const Spec &spec) : spec(spec)
+    {
+        if (spec.name.empty())
+            throw std::invalid_argument("Custom strategy without a name");
+
+        for (const auto &component : spec.components)
+        {
+            if (component.term < 0 || component.term >= TERM_COUNT)
+                throw std::invalid_argument("Unknown term in custom strategy: " + spec.name);
+            if (!std::isfinite(component.coefficient) || !std::isfinite(component.threshold))
+                throw std::invalid_argument("Non-finite coefficient in custom strategy: " + spec.name);
+            if (component.coefficient == 0.0)
+                continue;
+            program.push_back(component);
+            columns |= termColumns(component.term);
+            if (component.term >= EFFECTIVE_LATENCY && component.term != UTILIZATION_EXCESS)
+                sharedTerms |= 1u << component.term;
+        }
+
+        if (program.empty())
+            throw std::invalid_argument("Custom strategy has no non-zero terms: " + spec.name);
+    }
+
+    double CustomStrategy::evaluate(const LinkParameters &params) const
+    {
+        WeightCalculator::ParameterColumns c;
+        c.latency = &params.latency;
+        c.bandwidth = &params.bandwidth;
+        c.packet_loss = &params.packet_loss;
+        c.utilization = &params.utilization;
+        c.cost = &params.cost;
+        c.reliability = &params.reliability;
+        return weight(c, 0);
+    }
+
+    double CustomStrategy::weight(const WeightCalculator::ParameterColumns &c, std::size_t e) const
+    {
+        return WeightPolicy::Custom{this}.weight(c, static_cast<WeightPolicy::EdgeIndex>(e));
+    }
+
+    std::string CustomStrategy::getTermName(Term term)
+    {
+        return term >= 0 && term < TERM_COUNT ? TERM_NAMES[term] : "unknown";
+    }
+
+    bool CustomStrategy::findTerm(const std::string &name, Term &term)
+    {
+        for (int t = 0; t < TERM_COUNT; ++t)
+        {
+            if (name == TERM_NAMES[t])
+            {
+                term = static_cast<Term>(t);
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,54 @@
+#include "domain/GeometricHeuristic.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Domain
+{
+    namespace
+    {
+        // запас на округление: scale * расстояние не должно превысить вес ребра, по которому scale найден
+        constexpr double SCALE_MARGIN = 1.0 - 1e-9;
+    }
+
+    GeometricHeuristic::GeometricHeuristic(const CompactGraph &graph, const NodeCoordinates &coordinates,
+                                           WeightCalculator::Strategy strategy)
+        : strategy(strategy)
+    {
+        const std::size_t n = graph.getNodeCount();
+        positions.resize(n);
+        for (CompactGraph::NodeIndex u = 0; u < n; ++u)
+        {
+            const auto *point = coordinates.find(graph.getNodeId(u));
+            if (point)
+                positions[u] = coordinates.toPosition(*point);
+            else
+                ++missingNodes;
+        }
+
+        const auto weights = graph.getEdgeWeights(strategy);
+        double ratio = std::numeric_limits<double>::infinity();
+        for (CompactGraph::NodeIndex u = 0; u < n; ++u)
+        {
+            for (auto e = graph.edgesBegin(u); e < graph.edgesEnd(u); ++e)
+            {
+                const double weight = (*weights)[e];
+                if (!(weight >= 0.0) || std::isinf(weight))
+                {
+                    ++invalidEdges;
+                    continue;
+                }
+                // ребро между совпадающими точками масштаб не ограничивает
+                const double length = NodeCoordinates::distance(positions[u], positions[graph.getTarget(e)]);
+                if (length <= 0.0)
+                    continue;
+                if (weight == 0.0)
+                    ++zeroWeightEdges;
+                ratio = std::min(ratio, weight / length);
+            }
+        }
+
+        if (missingNodes == 0 && invalidEdges == 0 && zeroWeightEdges == 0 && std::isfinite(ratio))
+            scale = ratio * SCALE_MARGIN;
+    }
+}
@@ -0,0 +1,261 @@
+#include "domain/GraphOrdering.h"
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+namespace Domain
+{
+    namespace
+    {
+        // неориентированная смежность (исходящие + входящие ребра) в формате CSR
+        struct UndirectedAdjacency
+        {
+            std::vector<std::size_t> offsets;
+            std::vector<NodeIndex> neighbors;
+
+            explicit UndirectedAdjacency(const CompactGraph &graph)
+            {
+                const std::size_t n = graph.getNodeCount();
+                offsets.assign(n + 1, 0);
+                for (NodeIndex u = 0; u < n; ++u)
+                {
+                    for (auto e = graph.edgesBegin(u); e != graph.edgesEnd(u); ++e)
+                    {
+                        ++offsets[u + 1];
+                        ++offsets[graph.getTarget(e) + 1];
+                    }
+                }
+                for (std::size_t u = 0; u < n; ++u)
+                    offsets[u + 1] += offsets[u];
+
+                neighbors.resize(offsets[n]);
+                std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+                for (NodeIndex u = 0; u < n; ++u)
+                {
+                    for (auto e = graph.edgesBegin(u); e != graph.edgesEnd(u); ++e)
+                    {
+                        NodeIndex v = graph.getTarget(e);
+                        neighbors[fill[u]++] = v;
+                        neighbors[fill[v]++] = u;
+                    }
+                }
+            }
+
+            std::size_t size() const { return offsets.size() - 1; }
+            std::size_t degree(NodeIndex u) const { return offsets[u + 1] - offsets[u]; }
+        };
+
+        // обход в ширину из start с дописыванием вершин в order; by_degree - соседи по возрастанию степени
+        void appendBfs(const UndirectedAdjacency &adj, NodeIndex start, bool by_degree,
+                       std::vector<std::uint8_t> &visited, std::vector<NodeIndex> &order)
+        {
+            std::size_t head = order.size();
+            visited[start] = 1;
+            order.push_back(start);
+            std::vector<NodeIndex> level;
+            while (head < order.size())
+            {
+                NodeIndex u = order[head++];
+                level.clear();
+                for (auto i = adj.offsets[u]; i < adj.offsets[u + 1]; ++i)
+                {
+                    NodeIndex v = adj.neighbors[i];
+                    if (visited[v]) continue;
+                    visited[v] = 1;
+                    level.push_back(v);
+                }
+                if (by_degree)
+                    std::stable_sort(level.begin(), level.end(),
+                                     [&adj](NodeIndex a, NodeIndex b) { return adj.degree(a) < adj.degree(b); });
+                order.insert(order.end(), level.begin(), level.end());
+            }
+        }
+
+        // псевдопериферийная вершина компоненты (эвристика Джорджа-Лю): конец самого длинного
+        // найденного обхода в ширину с минимальной степенью
+        // depth - рабочий массив нулей размера графа, возвращается обнуленным
+        NodeIndex findPeripheral(const UndirectedAdjacency &adj, NodeIndex start, std::vector<std::uint32_t> &depth)
+        {
+            std::vector<NodeIndex> queue;
+            std::uint32_t best_depth = 0;
+            for (int round = 0; round < 4; ++round)
+            {
+                for (NodeIndex v : queue) depth[v] = 0;
+                queue.assign(1, start);
+                depth[start] = 1;
+                for (std::size_t head = 0; head < queue.size(); ++head)
+                {
+                    NodeIndex u = queue[head];
+                    for (auto i = adj.offsets[u]; i < adj.offsets[u + 1]; ++i)
+                    {
+                        NodeIndex v = adj.neighbors[i];
+                        if (depth[v]) continue;
+                        depth[v] = depth[u] + 1;
+                        queue.push_back(v);
+                    }
+                }
+                std::uint32_t ecc = depth[queue.back()];
+                if (round > 0 && ecc <= best_depth) break;
+                best_depth = ecc;
+
+                NodeIndex candidate = queue.back();
+                for (NodeIndex v : queue)
+                    if (depth[v] == ecc && adj.degree(v) < adj.degree(candidate)) candidate = v;
+                start = candidate;
+            }
+            for (NodeIndex v : queue) depth[v] = 0;
+            return start;
+        }
+
+        std::vector<NodeIndex> bfsOrder(const UndirectedAdjacency &adj)
+        {
+            std::vector<NodeIndex> order;
+            order.reserve(adj.size());
+            std::vector<std::uint8_t> visited(adj.size(), 0);
+            for (NodeIndex u = 0; u < adj.size(); ++u)
+                if (!visited[u]) appendBfs(adj, u, false, visited, order);
+            return order;
+        }
+
+        std::vector<NodeIndex> rcmOrder(const UndirectedAdjacency &adj)
+        {
+            std::vector<NodeIndex> order;
+            order.reserve(adj.size());
+            std::vector<std::uint8_t> visited(adj.size(), 0);
+            std::vector<std::uint32_t> depth(adj.size(), 0);
+            for (NodeIndex u = 0; u < adj.size(); ++u)
+                if (!visited[u]) appendBfs(adj, findPeripheral(adj, u, depth), true, visited, order);
+            std::reverse(order.begin(), order.end());
+            return order;
+        }
+
+        std::vector<NodeIndex> degreeOrder(const UndirectedAdjacency &adj)
+        {
+            std::vector<NodeIndex> order(adj.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(),
+                             [&adj](NodeIndex a, NodeIndex b) { return adj.degree(a) > adj.degree(b); });
+            return order;
+        }
+
+        std::vector<NodeIndex> communityOrder(const UndirectedAdjacency &adj)
+        {
+            const std::size_t n = adj.size();
+
+            // распространение меток: вершина берет самую частую метку соседей (при равенстве - меньшую)
+            std::vector<NodeIndex> label(n);
+            std::iota(label.begin(), label.end(), 0);
+            std::vector<std::uint32_t> counts(n, 0);
+            std::vector<NodeIndex> touched;
+            for (int iteration = 0; iteration < 20; ++iteration)
+            {
+                bool changed = false;
+                for (NodeIndex u = 0; u < n; ++u)
+                {
+                    touched.clear();
+                    for (auto i = adj.offsets[u]; i < adj.offsets[u + 1]; ++i)
+                    {
+                        NodeIndex l = label[adj.neighbors[i]];
+                        if (counts[l]++ == 0) touched.push_back(l);
+                    }
+                    NodeIndex best = label[u];
+                    std::uint32_t best_count = counts[best];
+                    for (NodeIndex l : touched)
+                    {
+                        if (counts[l] > best_count || (counts[l] == best_count && l < best))
+                        {
+                            best = l;
+                            best_count = counts[l];
+                        }
+                    }
+                    for (NodeIndex l : touched) counts[l] = 0;
+                    if (best != label[u])
+                    {
+                        label[u] = best;
+                        changed = true;
+                    }
+                }
+                if (!changed) break;
+            }
+
+            // сообщества по убыванию размера, внутри сообщества - порядок обхода в ширину
+            std::vector<std::uint32_t> size(n, 0);
+            for (NodeIndex u = 0; u < n; ++u) ++size[label[u]];
+            std::vector<NodeIndex> bfs = bfsOrder(adj);
+            std::vector<std::uint32_t> rank(n);
+            for (std::size_t i = 0; i < n; ++i) rank[bfs[i]] = static_cast<std::uint32_t>(i);
+
+            std::vector<NodeIndex> order(bfs);
+            std::stable_sort(order.begin(), order.end(), [&](NodeIndex a, NodeIndex b) {
+                if (label[a] == label[b]) return false;
+                if (size[label[a]] != size[label[b]]) return size[label[a]] > size[label[b]];
+                return rank[label[a]] < rank[label[b]];
+            });
+            return order;
+        }
+    }
+
+    std::vector<NodeIndex> GraphOrdering::compute(const CompactGraph &graph, Method method)
+    {
+        if (method == ID_ORDER)
+        {
+            std::vector<NodeIndex> order(graph.getNodeCount());
+            std::iota(order.begin(), order.end(), 0);
+            return order;
+        }
+
+        UndirectedAdjacency adj(graph);
+        switch (method)
+        {
+        case BFS_ORDER: return bfsOrder(adj);
+        case RCM_ORDER: return rcmOrder(adj);
+        case DEGREE_ORDER: return degreeOrder(adj);
+        default: return communityOrder(adj);
+        }
+    }
+
+    GraphOrdering::Locality GraphOrdering::measure(const CompactGraph &graph)
+    {
+        // в 64-байтной кэш-линии помещается 8 расстояний типа double
+        constexpr std::size_t LINE = 64 / sizeof(double);
+
+        Locality res;
+        const std::size_t m = graph.getEdgeCount();
+        if (m == 0) return res;
+
+        double total_gap = 0.0;
+        std::size_t cross = 0;
+        for (NodeIndex u = 0; u < graph.getNodeCount(); ++u)
+        {
+            for (auto e = graph.edgesBegin(u); e != graph.edgesEnd(u); ++e)
+            {
+                NodeIndex v = graph.getTarget(e);
+                std::size_t gap = u > v ? u - v : v - u;
+                total_gap += static_cast<double>(gap);
+                res.maxGap = std::max(res.maxGap, gap);
+                if (u / LINE != v / LINE) ++cross;
+            }
+        }
+        res.averageGap = total_gap / m;
+        res.crossLineShare = static_cast<double>(cross) / m;
+        return res;
+    }
+
+    std::string GraphOrdering::getMethodName(Method method)
+    {
+        switch (method)
+        {
+        case ID_ORDER: return "Id";
+        case BFS_ORDER: return "BFS";
+        case RCM_ORDER: return "Reverse Cuthill-McKee";
+        case DEGREE_ORDER: return "Degree";
+        case COMMUNITY_ORDER: return "Community";
+        default: return "Unknown Ordering";
+        }
+    }
+
+    std::vector<GraphOrdering::Method> GraphOrdering::getAllMethods()
+    {
+        return {ID_ORDER, BFS_ORDER, RCM_ORDER, DEGREE_ORDER, COMMUNITY_ORDER};
+    }
+}
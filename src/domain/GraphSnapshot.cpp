@@ -0,0 +1,111 @@
+#include "domain/GraphSnapshot.h"
+#include <stdexcept>
+
+namespace Domain
+{
+    GraphSnapshot::GraphSnapshot(CompactGraphPtr base) : base(std::move(base))
+    {
+        if (!this->base)
+            throw std::invalid_argument("Snapshot requires a base graph");
+    }
+
+    bool GraphSnapshot::hasNode(NodeId id) const
+    {
+        return isNodeActive(base->findIndex(id));
+    }
+
+    bool GraphSnapshot::hasEdge(NodeId source, NodeId target) const
+    {
+        NodeIndex u = base->findIndex(source);
+        NodeIndex v = base->findIndex(target);
+        if (!isNodeActive(u) || !isNodeActive(v)) return false;
+        EdgeIndex e = base->findEdge(u, v);
+        return e != CompactGraph::INVALID_EDGE && isEdgeActive(u, e);
+    }
+
+    int GraphSnapshot::getNodeCount() const
+    {
+        return static_cast<int>(base->getNodeCount() - removedNodes.size());
+    }
+
+    std::vector<NodeId> GraphSnapshot::getAllNodeIds() const
+    {
+        std::vector<NodeId> res;
+        res.reserve(getNodeCount());
+        for (NodeIndex u = 0; u < base->getNodeCount(); ++u)
+            if (removedNodes.empty() || isNodeActive(u))
+                res.push_back(base->getNodeId(u));
+        return res;
+    }
+
+    std::optional<LinkParameters> GraphSnapshot::tryGetEdgeParameters(NodeId source, NodeId target) const
+    {
+        NodeIndex u = base->findIndex(source);
+        NodeIndex v = base->findIndex(target);
+        if (!isNodeActive(u) || !isNodeActive(v)) return std::nullopt;
+        EdgeIndex e = base->findEdge(u, v);
+        if (e == CompactGraph::INVALID_EDGE || !isEdgeActive(u, e)) return std::nullopt;
+        auto it = overrides.find(e);
+        if (it != overrides.end()) return it->second;
+        return base->getEdgeParameters(e);
+    }
+
+    bool GraphSnapshot::removeNode(NodeId id)
+    {
+        NodeIndex u = base->findIndex(id);
+        if (!isNodeActive(u)) return false;
+        // инцидентные ребра не перечисляются: они скрываются проверкой концов в isEdgeActive
+        removedNodes.insert(u);
+        return true;
+    }
+
+    bool GraphSnapshot::removeEdge(NodeId source, NodeId target)
+    {
+        NodeIndex u = base->findIndex(source);
+        NodeIndex v = base->findIndex(target);
+        if (!isNodeActive(u) || !isNodeActive(v)) return false;
+        EdgeIndex e = base->findEdge(u, v);
+        if (e == CompactGraph::INVALID_EDGE || !removedEdges.insert(e).second) return false;
+        overrides.erase(e);
+        return true;
+    }
+
+    bool GraphSnapshot::setEdgeParameters(NodeId source, NodeId target, const LinkParameters &params)
+    {
+        NodeIndex u = base->findIndex(source);
+        NodeIndex v = base->findIndex(target);
+        if (!isNodeActive(u) || !isNodeActive(v)) return false;
+        EdgeIndex e = base->findEdge(u, v);
+        if (e == CompactGraph::INVALID_EDGE || !isEdgeActive(u, e)) return false;
+        overrides[e] = params;
+        return true;
+    }
+
+    std::size_t GraphSnapshot::getChangeCount() const
+    {
+        return removedNodes.size() + removedEdges.size() + overrides.size();
+    }
+
+    bool GraphSnapshot::isNodeActive(NodeIndex u) const
+    {
+        return u != CompactGraph::INVALID_NODE && removedNodes.find(u) == removedNodes.end();
+    }
+
+    bool GraphSnapshot::isEdgeActive(NodeIndex source, EdgeIndex e) const
+    {
+        // пустой снимок не платит за поиск в хэш-таблицах
+        if (removedEdges.empty() && removedNodes.empty()) return true;
+        if (removedEdges.find(e) != removedEdges.end()) return false;
+        return isNodeActive(source) && isNodeActive(base->getTarget(e));
+    }
+
+    std::unordered_map<GraphSnapshot::EdgeIndex, double>
+    GraphSnapshot::getWeightOverrides(WeightCalculator::Strategy strategy) const
+    {
+        std::unordered_map<EdgeIndex, double> res;
+        res.reserve(overrides.size());
+        for (const auto &[e, params] : overrides)
+            res.emplace(e, WeightCalculator::calculateCompositeWeight(params, strategy));
+        return res;
+    }
+}
@@ -0,0 +1,169 @@
+#include "domain/LinkParameterStore.h"
+#include <limits>
+#include <stdexcept>
+
+namespace Domain
+{
+    namespace
+    {
+        const LinkParameters DEFAULT_PARAMETERS;
+
+        double getDefaultValue(LinkParameterStore::Column column)
+        {
+            switch (column)
+            {
+            case LinkParameterStore::LATENCY: return DEFAULT_PARAMETERS.latency;
+            case LinkParameterStore::BANDWIDTH: return DEFAULT_PARAMETERS.bandwidth;
+            case LinkParameterStore::PACKET_LOSS: return DEFAULT_PARAMETERS.packet_loss;
+            case LinkParameterStore::UTILIZATION: return DEFAULT_PARAMETERS.utilization;
+            case LinkParameterStore::COST: return DEFAULT_PARAMETERS.cost;
+            default: return DEFAULT_PARAMETERS.reliability;
+            }
+        }
+    }
+
+    LinkParameterStore::LinkParameterStore(Encoding encoding) : encoding(encoding)
+    {
+        for (int c = 0; c < COLUMN_COUNT; ++c)
+        {
+            auto column = static_cast<Column>(c);
+            columns[c] = ParameterColumn(getColumnEncoding(encoding, column), getDefaultValue(column));
+        }
+    }
+
+    LinkParameterStore LinkParameterStore::fromColumns(Encoding encoding, std::array<ParameterColumn, COLUMN_COUNT> columns)
+    {
+        LinkParameterStore store(encoding);
+        for (int c = 0; c < COLUMN_COUNT; ++c)
+        {
+            if (columns[c].getEncoding() != getColumnEncoding(encoding, static_cast<Column>(c)))
+                throw std::invalid_argument("Parameter column encoding does not match store encoding");
+            if (columns[c].size() != columns[LATENCY].size())
+                throw std::invalid_argument("Parameter columns have different sizes");
+            store.columns[c] = std::move(columns[c]);
+        }
+        return store;
+    }
+
+    void LinkParameterStore::setEncoding(Encoding encoding)
+    {
+        if (encoding == this->encoding) return;
+        for (int c = 0; c < COLUMN_COUNT; ++c)
+            columns[c] = columns[c].reencode(getColumnEncoding(encoding, static_cast<Column>(c)));
+        this->encoding = encoding;
+    }
+
+    ParameterColumn::Encoding LinkParameterStore::getColumnEncoding(Encoding encoding, Column column)
+    {
+        switch (encoding)
+        {
+        case FLOAT32:
+            return ParameterColumn::FLOAT32;
+        case QUANTIZED:
+            // доли 0..1 квантуются, величины с размерностью остаются в float
+            if (column == PACKET_LOSS || column == UTILIZATION || column == RELIABILITY)
+                return ParameterColumn::FRACTION16;
+            return ParameterColumn::FLOAT32;
+        default:
+            return ParameterColumn::FLOAT64;
+        }
+    }
+
+    const char *LinkParameterStore::getEncodingName(Encoding encoding)
+    {
+        switch (encoding)
+        {
+        case FLOAT32: return "float32";
+        case QUANTIZED: return "quantized";
+        default: return "full precision";
+        }
+    }
+
+    std::size_t LinkParameterStore::getBytesPerEdge(Encoding encoding) const
+    {
+        std::size_t bytes = 0;
+        for (int c = 0; c < COLUMN_COUNT; ++c)
+            if (columns[c].isMaterialized())
+                bytes += ParameterColumn::getEncodedSize(getColumnEncoding(encoding, static_cast<Column>(c)));
+        return bytes;
+    }
+
+    std::size_t LinkParameterStore::getMemoryUsage() const
+    {
+        std::size_t bytes = freeIds.capacity() * sizeof(EdgeId);
+        for (const auto &column : columns)
+            bytes += column.getMemoryUsage();
+        return bytes;
+    }
+
+    LinkParameterStore::EdgeId LinkParameterStore::add(const LinkParameters &params)
+    {
+        EdgeId id;
+        if (!freeIds.empty())
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            if (size() >= std::numeric_limits<EdgeId>::max())
+                throw std::length_error("Too many edges in LinkParameterStore");
+            id = static_cast<EdgeId>(size());
+            columns[LATENCY].push(params.latency);
+            columns[BANDWIDTH].push(params.bandwidth);
+            columns[PACKET_LOSS].push(params.packet_loss);
+            columns[UTILIZATION].push(params.utilization);
+            columns[COST].push(params.cost);
+            columns[RELIABILITY].push(params.reliability);
+            return id;
+        }
+        set(id, params);
+        return id;
+    }
+
+    void LinkParameterStore::release(EdgeId id)
+    {
+        freeIds.push_back(id);
+    }
+
+    void LinkParameterStore::reserve(std::size_t count)
+    {
+        for (auto &column : columns)
+            column.reserve(count);
+    }
+
+    void LinkParameterStore::clear()
+    {
+        for (auto &column : columns)
+            column.clear();
+        freeIds.clear();
+    }
+
+    void LinkParameterStore::share()
+    {
+        for (auto &column : columns)
+            column.share();
+    }
+
+    void LinkParameterStore::set(EdgeId id, const LinkParameters &params)
+    {
+        columns[LATENCY].set(id, params.latency);
+        columns[BANDWIDTH].set(id, params.bandwidth);
+        columns[PACKET_LOSS].set(id, params.packet_loss);
+        columns[UTILIZATION].set(id, params.utilization);
+        columns[COST].set(id, params.cost);
+        columns[RELIABILITY].set(id, params.reliability);
+    }
+
+    LinkParameters LinkParameterStore::get(EdgeId id) const
+    {
+        LinkParameters params;
+        params.latency = columns[LATENCY].get(id);
+        params.bandwidth = columns[BANDWIDTH].get(id);
+        params.packet_loss = columns[PACKET_LOSS].get(id);
+        params.utilization = columns[UTILIZATION].get(id);
+        params.cost = columns[COST].get(id);
+        params.reliability = columns[RELIABILITY].get(id);
+        return params;
+    }
+}
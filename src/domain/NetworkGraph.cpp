@@ -1,22 +1,44 @@
 #include "domain/NetworkGraph.h"
 #include <sstream>
 #include <stdexcept>
+#include <algorithm>
 
 namespace Domain
 {
-    NetworkGraph::NetworkGraph(const std::string &name) : name(name) {}
+    // минимальный размер журнала изменений весов, после которого он может быть сброшен
+    static const std::size_t MIN_JOURNAL_CAPACITY = 1024;
 
-    void NetworkGraph::addNode(int id, const std::string &) {
-        nodes.insert(id);
-        adjacency.try_emplace(id, std::unordered_map<int, LinkParameters>{});
+    NetworkGraph::NetworkGraph(const std::string &name, LinkParameterStore::Encoding encoding)
+        : name(name), parameters(encoding) {}
+
+    void NetworkGraph::setNodeOrdering(GraphOrdering::Method method) {
+        if (method == nodeOrdering) return;
+        nodeOrdering = method;
+        // меняется только нумерация CSR-снимка, как при структурном изменении
+        markChanged();
+    }
+
+    void NetworkGraph::setParameterEncoding(LinkParameterStore::Encoding encoding) {
+        if (encoding == parameters.getEncoding()) return;
+        parameters.setEncoding(encoding);
+        // меняются все веса сразу: журнал сбрасывается, кэши пересчитываются целиком
+        markChanged();
+        weightJournal.clear();
+        journalStart = version;
     }
 
-    void NetworkGraph::ensureNode(int id) {
+    void NetworkGraph::addNode(NodeId id, const std::string &) {
+        if (indexById.find(id) != indexById.end()) return;
+        acquireIndex(id);
+        markChanged();
+    }
+
+    void NetworkGraph::ensureNode(NodeId id) {
         if (!hasNode(id)) addNode(id);
     }
 
     // версия с простым весом (для совместимости)
-    void NetworkGraph::addEdge(int source, int target, double weight) {
+    void NetworkGraph::addEdge(NodeId source, NodeId target, double weight) {
         LinkParameters params;
         params.latency = weight;
         params.cost = weight;
@@ -25,50 +47,235 @@ namespace Domain
     }
 
     // версия с полными параметрами
-    void NetworkGraph::addEdge(int source, int target, const LinkParameters &params) {
+    void NetworkGraph::addEdge(NodeId source, NodeId target, const LinkParameters &params) {
         addNode(source);
         addNode(target);
-        adjacency[source][target] = params;
+        NodeIndex u = indexById.find(source)->second;
+        NodeIndex v = indexById.find(target)->second;
+        auto &out = adjacency[u];
+        auto it = out.find(v);
+        if (it != out.end()) {
+            parameters.set(it->second, params);
+            markEdgeChanged(it->second);
+        } else {
+            const std::size_t known = parameters.size();
+            EdgeId id = parameters.add(params);
+            out.emplace(v, id);
+            reverseAdjacency[v].emplace(u, id);
+            markChanged();
+            // новое ребро в конце хранилища кэши весов досчитывают сами, в журнал идет только повторно занятый id
+            if (id < known) markEdgeChanged(id);
+        }
     }
 
-    bool NetworkGraph::hasNode(int id) const {
-        return nodes.find(id) != nodes.end();
+    void NetworkGraph::addEdges(const EdgeRecord *edges, std::size_t count) {
+        if (count == 0) return;
+
+        // перевод id в индексы: новые узлы получают индексы в порядке появления
+        indexById.reserve(indexById.size() + count);
+        std::vector<std::pair<NodeIndex, NodeIndex>> ends;
+        ends.reserve(count);
+        NodeId lastId = 0;
+        NodeIndex lastIndex = INVALID_NODE_INDEX;
+        auto indexOf = [&](NodeId id) {
+            // соседние записи часто имеют общий источник
+            if (lastIndex != INVALID_NODE_INDEX && id == lastId) return lastIndex;
+            auto it = indexById.find(id);
+            NodeIndex index = it != indexById.end() ? it->second : acquireIndex(id);
+            lastId = id;
+            lastIndex = index;
+            return index;
+        };
+        for (std::size_t i = 0; i < count; ++i) {
+            NodeIndex u = indexOf(edges[i].source);
+            NodeIndex v = indexOf(edges[i].target);
+            ends.emplace_back(u, v);
+        }
+        markChanged();
+
+        // строки смежности резервируются один раз под все ребра пакета
+        std::vector<std::uint32_t> outCount(nodeIds.size(), 0), inCount(nodeIds.size(), 0);
+        for (const auto &[u, v] : ends) {
+            ++outCount[u];
+            ++inCount[v];
+        }
+        for (NodeIndex u = 0; u < nodeIds.size(); ++u) {
+            if (outCount[u]) adjacency[u].reserve(adjacency[u].size() + outCount[u]);
+            if (inCount[u]) reverseAdjacency[u].reserve(reverseAdjacency[u].size() + inCount[u]);
+        }
+        parameters.reserve(parameters.size() + count);
+        const std::size_t known = parameters.size();
+
+        // устойчивая сортировка подсчетом по источнику: строка смежности заполняется целиком,
+        // а внутри строки записи сохраняют исходный порядок (повтор ребра перезаписывает параметры)
+        std::vector<std::size_t> start(nodeIds.size() + 1, 0);
+        for (NodeIndex u = 0; u < nodeIds.size(); ++u) start[u + 1] = start[u] + outCount[u];
+        std::vector<std::uint32_t> order(count);
+        for (std::size_t i = 0; i < count; ++i) order[start[ends[i].first]++] = static_cast<std::uint32_t>(i);
+
+        for (std::size_t i : order) {
+            const auto [u, v] = ends[i];
+            auto inserted = adjacency[u].try_emplace(v, 0);
+            if (!inserted.second) {
+                parameters.set(inserted.first->second, edges[i].params);
+                markEdgeChanged(inserted.first->second);
+                continue;
+            }
+            EdgeId id = parameters.add(edges[i].params);
+            inserted.first->second = id;
+            reverseAdjacency[v].emplace(u, id);
+            if (id < known) markEdgeChanged(id);
+        }
+    }
+
+    void NetworkGraph::reserve(std::size_t node_count, std::size_t edge_count) {
+        indexById.reserve(node_count);
+        nodeIds.reserve(node_count);
+        active.reserve(node_count);
+        adjacency.reserve(node_count);
+        reverseAdjacency.reserve(node_count);
+        parameters.reserve(edge_count);
+    }
+
+    bool NetworkGraph::hasNode(NodeId id) const {
+        return indexById.find(id) != indexById.end();
     }
 
-    std::vector<int> NetworkGraph::getNeighbors(int node_id) const {
-        std::vector<int> res;
-        auto it = adjacency.find(node_id);
-        if (it == adjacency.end()) return res;
-        
-        res.reserve(it->second.size());
-        for (const auto &kv : it->second)
-            res.push_back(kv.first);
+    std::vector<NodeId> NetworkGraph::getNeighbors(NodeId node_id) const {
+        std::vector<NodeId> res;
+        auto range = neighbors(node_id);
+        res.reserve(range.size());
+        for (const auto &edge : range)
+            res.push_back(edge.getTarget());
         return res;
     }
 
     // простая версия (для совместимости) - возвращает latency по умолчанию
-    double NetworkGraph::getEdgeWeight(int source, int target) const {
-        return getEdgeParameters(source, target).latency;
+    double NetworkGraph::getEdgeWeight(NodeId source, NodeId target) const {
+        return parameters.getValue(LinkParameterStore::LATENCY, findEdgeId(source, target));
+    }
+
+    // сложная версия с стратегией агрегации - чтение из предрасчитанного массива весов
+    double NetworkGraph::getEdgeWeight(NodeId source, NodeId target, WeightCalculator::Strategy strategy) const {
+        EdgeId id = findEdgeId(source, target);
+        return getEdgeWeights(strategy)[id];
+    }
+
+    LinkParameters NetworkGraph::getEdgeParameters(NodeId source, NodeId target) const {
+        return parameters.get(findEdgeId(source, target));
+    }
+
+    bool NetworkGraph::setEdgeParameters(NodeId source, NodeId target, const LinkParameters &params) {
+        auto id = findEdge(source, target);
+        if (!id) return false;
+        parameters.set(*id, params);
+        markEdgeChanged(*id);
+        return true;
+    }
+
+    bool NetworkGraph::setEdgeParameter(NodeId source, NodeId target, LinkParameterStore::Column column, double value) {
+        auto id = findEdge(source, target);
+        if (!id) return false;
+        parameters.setValue(column, *id, value);
+        markEdgeChanged(*id);
+        return true;
+    }
+
+    const std::vector<double> &NetworkGraph::getEdgeWeights(WeightCalculator::Strategy strategy) const {
+        std::lock_guard<std::mutex> lock(weightsMutex);
+        auto &cache = weightCaches[static_cast<int>(strategy)];
+        if (cache.built && cache.version == version) return cache.weights;
+
+        if (!cache.built || cache.version < journalStart) {
+            // кэш слишком старый для журнала - полный поколоночный пересчет
+            WeightCalculator::calculateWeights(parameters, strategy, cache.weights);
+        } else {
+            // догоняем кэш по журналу: пересчитываются только измененные ребра и добавленные в конец
+            const std::size_t known = cache.weights.size();
+            cache.weights.resize(parameters.size());
+            for (EdgeId id = static_cast<EdgeId>(known); id < parameters.size(); ++id)
+                cache.weights[id] = WeightCalculator::calculateCompositeWeight(parameters.get(id), strategy);
+            auto first = std::upper_bound(weightJournal.begin(), weightJournal.end(), cache.version,
+                                          [](std::uint64_t v, const WeightChange &c) { return v < c.version; });
+            for (auto it = first; it != weightJournal.end(); ++it)
+                cache.weights[it->edge] =
+                    WeightCalculator::calculateCompositeWeight(parameters.get(it->edge), strategy);
+        }
+        cache.built = true;
+        cache.version = version;
+        return cache.weights;
     }
 
-    // сложная версия с стратегией агрегации
-    double NetworkGraph::getEdgeWeight(int source, int target, WeightCalculator::Strategy strategy) const {
-        auto params = getEdgeParameters(source, target);
-        return WeightCalculator::calculateCompositeWeight(params, strategy);
+    NetworkGraph::NeighborRange NetworkGraph::neighbors(NodeId node_id) const noexcept {
+        return neighborsAt(findIndex(node_id));
     }
 
-    LinkParameters NetworkGraph::getEdgeParameters(int source, int target) const {
-        auto it = adjacency.find(source);
-        if (it == adjacency.end())
+    std::size_t NetworkGraph::getOutDegree(NodeId node_id) const noexcept {
+        return neighbors(node_id).size();
+    }
+
+    NetworkGraph::NeighborRange NetworkGraph::inNeighbors(NodeId node_id) const noexcept {
+        return inNeighborsAt(findIndex(node_id));
+    }
+
+    std::size_t NetworkGraph::getInDegree(NodeId node_id) const noexcept {
+        return inNeighbors(node_id).size();
+    }
+
+    std::vector<NodeId> NetworkGraph::getPredecessors(NodeId node_id) const {
+        std::vector<NodeId> res;
+        auto range = inNeighbors(node_id);
+        res.reserve(range.size());
+        for (const auto &edge : range)
+            res.push_back(edge.getNeighbor());
+        return res;
+    }
+
+    NodeIndex NetworkGraph::findIndex(NodeId id) const noexcept {
+        auto it = indexById.find(id);
+        return it == indexById.end() ? INVALID_NODE_INDEX : it->second;
+    }
+
+    NetworkGraph::NeighborRange NetworkGraph::neighborsAt(NodeIndex index) const noexcept {
+        if (!isActiveIndex(index)) return NeighborRange();
+        return NeighborRange(&adjacency[index], this);
+    }
+
+    NetworkGraph::NeighborRange NetworkGraph::inNeighborsAt(NodeIndex index) const noexcept {
+        if (!isActiveIndex(index)) return NeighborRange();
+        return NeighborRange(&reverseAdjacency[index], this);
+    }
+
+    std::optional<NetworkGraph::EdgeId> NetworkGraph::findEdgeAt(NodeIndex source, NodeIndex target) const noexcept {
+        if (!isActiveIndex(source)) return std::nullopt;
+        const auto &out = adjacency[source];
+        auto it = out.find(target);
+        if (it == out.end()) return std::nullopt;
+        return it->second;
+    }
+
+    std::optional<NetworkGraph::EdgeId> NetworkGraph::findEdge(NodeId source, NodeId target) const noexcept {
+        return findEdgeAt(findIndex(source), findIndex(target));
+    }
+
+    std::optional<LinkParameters> NetworkGraph::tryGetEdgeParameters(NodeId source, NodeId target) const noexcept {
+        auto id = findEdge(source, target);
+        if (!id) return std::nullopt;
+        return parameters.get(*id);
+    }
+
+    NetworkGraph::EdgeId NetworkGraph::findEdgeId(NodeId source, NodeId target) const {
+        NodeIndex u = findIndex(source);
+        if (u == INVALID_NODE_INDEX)
             throw std::out_of_range("Source node not found");
-        auto it2 = it->second.find(target);
-        if (it2 == it->second.end())
+        auto id = findEdgeAt(u, findIndex(target));
+        if (!id)
             throw std::out_of_range("Edge not found");
-        return it2->second;
+        return *id;
     }
 
     int NetworkGraph::getNodeCount() const {
-        return static_cast<int>(nodes.size());
+        return static_cast<int>(indexById.size());
     }
 
     std::string NetworkGraph::getInfo() const {
@@ -77,38 +284,225 @@ namespace Domain
         return oss.str();
     }
 
-    std::vector<int> NetworkGraph::getAllNodeIds() const {
-        std::vector<int> res;
-        res.reserve(nodes.size());
-        for (int id : nodes) res.push_back(id);
+    MemoryUsage NetworkGraph::getMemoryUsage() const {
+        MemoryUsage usage;
+        usage.add("node ids", MemoryEstimate::of(nodeIds) + MemoryEstimate::of(active) + MemoryEstimate::of(freeIndices));
+        usage.add("id index", MemoryEstimate::of(indexById));
+
+        std::size_t rows = MemoryEstimate::of(adjacency);
+        for (const auto &row : adjacency) rows += MemoryEstimate::of(row);
+        usage.add("adjacency", rows);
+        rows = MemoryEstimate::of(reverseAdjacency);
+        for (const auto &row : reverseAdjacency) rows += MemoryEstimate::of(row);
+        usage.add("reverse adjacency", rows);
+
+        usage.add("parameters", parameters.getMemoryUsage());
+        usage.add("weight journal", MemoryEstimate::of(weightJournal));
+        {
+            std::lock_guard<std::mutex> lock(weightsMutex);
+            std::size_t weights = 0;
+            for (const auto &entry : weightCaches) weights += MemoryEstimate::of(entry.second.weights);
+            usage.add("weight caches", weights);
+        }
+        {
+            std::lock_guard<std::mutex> lock(compactMutex);
+            usage.add("CSR snapshot", compactCache ? compactCache->getMemoryUsage().getTotal() + MemoryEstimate::of(compactEdgeIndex) : 0);
+        }
+        return usage;
+    }
+
+    // узлы в порядке плотных индексов
+    std::vector<NodeId> NetworkGraph::getAllNodeIds() const {
+        std::vector<NodeId> res;
+        res.reserve(indexById.size());
+        for (NodeIndex i = 0; i < nodeIds.size(); ++i)
+            if (active[i]) res.push_back(nodeIds[i]);
         return res;
     }
 
-    bool NetworkGraph::removeNode(int id) {
-        adjacency.erase(id);
-        for (auto &kv : adjacency) {
-            kv.second.erase(id);
+    // затрагиваются только инцидентные ребра: O(степени узла), а не O(V)
+    bool NetworkGraph::removeNode(NodeId id) {
+        auto found = indexById.find(id);
+        if (found == indexById.end()) return false;
+        NodeIndex u = found->second;
+
+        for (const auto &kv : reverseAdjacency[u]) {
+            if (kv.first == u) continue;   // петля удаляется вместе с исходящими
+            adjacency[kv.first].erase(u);
+            parameters.release(kv.second);
+        }
+        for (const auto &kv : adjacency[u]) {
+            parameters.release(kv.second);
+            if (kv.first != u) reverseAdjacency[kv.first].erase(u);
         }
-        auto it = nodes.find(id);
-        if (it == nodes.end()) return false;
-        nodes.erase(it);
+        // строки заменяются пустыми, чтобы освободить память хэш-таблиц
+        AdjRow().swap(adjacency[u]);
+        AdjRow().swap(reverseAdjacency[u]);
+
+        indexById.erase(found);
+        active[u] = 0;
+        freeIndices.push_back(u);
+        markChanged();
         return true;
     }
 
-    bool NetworkGraph::removeEdge(int from, int to) {
-        auto it = adjacency.find(from);
-        if (it == adjacency.end()) return false;
-        auto it2 = it->second.find(to);
-        if (it2 == it->second.end()) return false;
-        it->second.erase(it2);
-        if (it->second.empty()) adjacency.erase(it);
+    bool NetworkGraph::removeEdge(NodeId from, NodeId to) {
+        NodeIndex u = findIndex(from);
+        NodeIndex v = findIndex(to);
+        auto id = findEdgeAt(u, v);
+        if (!id) return false;
+        parameters.release(*id);
+        adjacency[u].erase(v);
+        reverseAdjacency[v].erase(u);
+        markChanged();
         return true;
     }
 
     NetworkGraphPtr NetworkGraph::createSnapshot() const {
-        auto snap = std::make_shared<NetworkGraph>(this->name);
-        snap->nodes = this->nodes;
+        auto snap = std::make_shared<NetworkGraph>(this->name, parameters.getEncoding());
+        snap->nodeOrdering = this->nodeOrdering;
+        snap->nodeIds = this->nodeIds;
+        snap->active = this->active;
+        snap->indexById = this->indexById;
+        snap->freeIndices = this->freeIndices;
         snap->adjacency = this->adjacency;
+        snap->reverseAdjacency = this->reverseAdjacency;
+        snap->parameters = this->parameters;
+        snap->coordinates = getCoordinates();
         return snap;
     }
-}
\ No newline at end of file
+
+    GraphSnapshotPtr NetworkGraph::createOverlaySnapshot() const {
+        return std::make_shared<GraphSnapshot>(getCompactGraph());
+    }
+
+    CompactGraphPtr NetworkGraph::getCompactGraph() const {
+        std::lock_guard<std::mutex> lock(compactMutex);
+        if (compactCache && compactVersion == version) return compactCache;
+
+        if (compactCache && structureVersion <= compactVersion && compactVersion >= journalStart) {
+            // с прошлого снимка менялись только параметры: изменения берутся из журнала весов
+            std::vector<std::pair<CompactGraph::EdgeIndex, LinkParameters>> changes;
+            auto first = std::upper_bound(weightJournal.begin(), weightJournal.end(), compactVersion,
+                                          [](std::uint64_t v, const WeightChange &c) { return v < c.version; });
+            for (auto it = first; it != weightJournal.end(); ++it)
+                changes.emplace_back(compactEdgeIndex[it->edge], parameters.get(it->edge));
+            compactCache = CompactGraph::withParameters(*compactCache, changes);
+        } else {
+            compactCache = CompactGraph::build(*this, &compactEdgeIndex);
+            if (nodeOrdering != GraphOrdering::ID_ORDER) {
+                std::vector<CompactGraph::EdgeIndex> edgeMap;
+                compactCache = CompactGraph::permute(*compactCache, GraphOrdering::compute(*compactCache, nodeOrdering), &edgeMap);
+                for (auto &index : compactEdgeIndex)
+                    if (index != CompactGraph::INVALID_EDGE) index = edgeMap[index];
+            }
+        }
+        compactVersion = version;
+        return compactCache;
+    }
+
+    // готовый снимок становится кэшем CSR после сверки с вершинами и ребрами графа
+    void NetworkGraph::adoptCompactGraph(CompactGraphPtr compact) {
+        if (!compact || compact->getNodeCount() != indexById.size() || compact->getEdgeCount() != getEdgeCount())
+            throw std::invalid_argument("CSR snapshot does not match graph size");
+
+        std::vector<CompactGraph::EdgeIndex> edgeIndex(parameters.size(), CompactGraph::INVALID_EDGE);
+        for (CompactGraph::NodeIndex u = 0; u < compact->getNodeCount(); ++u) {
+            NodeIndex source = findIndex(compact->getNodeId(u));
+            if (source == INVALID_NODE_INDEX)
+                throw std::invalid_argument("CSR snapshot has an unknown node");
+            const auto &row = adjacency[source];
+            for (auto e = compact->edgesBegin(u); e != compact->edgesEnd(u); ++e) {
+                auto edge = row.find(findIndex(compact->getNodeId(compact->getTarget(e))));
+                if (edge == row.end())
+                    throw std::invalid_argument("CSR snapshot has an unknown edge");
+                edgeIndex[edge->second] = e;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(compactMutex);
+        compactCache = std::move(compact);
+        compactEdgeIndex = std::move(edgeIndex);
+        compactVersion = version;
+    }
+
+    void NetworkGraph::setCoordinates(NodeCoordinatesPtr coordinates) {
+        std::lock_guard<std::mutex> lock(heuristicMutex);
+        this->coordinates = std::move(coordinates);
+        heuristicCaches.clear();
+    }
+
+    NodeCoordinatesPtr NetworkGraph::getCoordinates() const {
+        std::lock_guard<std::mutex> lock(heuristicMutex);
+        return coordinates;
+    }
+
+    GeometricHeuristicPtr NetworkGraph::getGeometricHeuristic(const CompactGraphPtr &compact,
+                                                              WeightCalculator::Strategy strategy) const {
+        std::lock_guard<std::mutex> lock(heuristicMutex);
+        if (!coordinates || !compact) return nullptr;
+        // снимок, для которого построена эвристика, не удерживается: после его удаления запись строится заново
+        auto &cache = heuristicCaches[static_cast<int>(strategy)];
+        if (cache.heuristic && cache.graph.lock() == compact) return cache.heuristic;
+        cache.heuristic = std::make_shared<GeometricHeuristic>(*compact, *coordinates, strategy);
+        cache.graph = compact;
+        return cache.heuristic;
+    }
+
+    // выдача плотного индекса новому узлу, освободившиеся индексы используются повторно
+    NodeIndex NetworkGraph::acquireIndex(NodeId id) {
+        NodeIndex index;
+        if (!freeIndices.empty()) {
+            index = freeIndices.back();
+            freeIndices.pop_back();
+            nodeIds[index] = id;
+            active[index] = 1;
+        } else {
+            if (nodeIds.size() >= INVALID_NODE_INDEX)
+                throw std::length_error("Too many nodes in graph");
+            index = static_cast<NodeIndex>(nodeIds.size());
+            nodeIds.push_back(id);
+            active.push_back(1);
+            adjacency.emplace_back();
+            reverseAdjacency.emplace_back();
+        }
+        indexById.emplace(id, index);
+        return index;
+    }
+
+    void NetworkGraph::markChanged() {
+        structureVersion = ++version;
+    }
+
+    void NetworkGraph::markEdgeChanged(EdgeId edge) {
+        ++version;
+        // записи, уже учтенные всеми кэшами, отбрасываются; если кэши отстают, журнал ограничен
+        // размером графа: при переполнении отстающие кэши пересчитаются целиком
+        if (!weightJournal.empty() && weightJournal.size() % MIN_JOURNAL_CAPACITY == 0) trimJournal();
+        if (weightJournal.size() >= std::max(MIN_JOURNAL_CAPACITY, parameters.size())) {
+            weightJournal.clear();
+            journalStart = version - 1;
+        }
+        weightJournal.push_back({version, edge});
+    }
+
+    void NetworkGraph::trimJournal() {
+        // кэши старше начала журнала пересчитываются целиком и записей не ждут
+        std::uint64_t consumed = version;
+        {
+            std::lock_guard<std::mutex> lock(weightsMutex);
+            for (const auto &entry : weightCaches)
+                if (entry.second.built && entry.second.version >= journalStart)
+                    consumed = std::min(consumed, entry.second.version);
+        }
+        {
+            std::lock_guard<std::mutex> lock(compactMutex);
+            if (compactCache && compactVersion >= journalStart) consumed = std::min(consumed, compactVersion);
+        }
+        if (consumed <= journalStart) return;
+        auto first = std::upper_bound(weightJournal.begin(), weightJournal.end(), consumed,
+                                      [](std::uint64_t v, const WeightChange &c) { return v < c.version; });
+        weightJournal.erase(weightJournal.begin(), first);
+        journalStart = consumed;
+    }
+}
@@ -0,0 +1,55 @@
+#include "domain/NodeCoordinates.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace Domain
+{
+    NodeCoordinates::NodeCoordinates(System system, std::vector<std::pair<NodeId, Point>> source)
+        : system(system)
+    {
+        for (const auto &[id, point] : source)
+        {
+            if (!std::isfinite(point.x) || !std::isfinite(point.y))
+                throw std::invalid_argument("Non-finite coordinate of node " + std::to_string(id));
+            if (system == GEOGRAPHIC && (std::abs(point.y) > 90.0 || std::abs(point.x) > 180.0))
+                throw std::invalid_argument("Latitude or longitude out of range for node " + std::to_string(id));
+        }
+
+        // устойчивая сортировка сохраняет порядок повторов: последний из них остается
+        std::stable_sort(source.begin(), source.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        ids.reserve(source.size());
+        points.reserve(source.size());
+        for (std::size_t i = 0; i < source.size(); ++i)
+        {
+            if (i + 1 < source.size() && source[i + 1].first == source[i].first) continue;
+            ids.push_back(source[i].first);
+            points.push_back(source[i].second);
+        }
+    }
+
+    const NodeCoordinates::Point *NodeCoordinates::find(NodeId id) const
+    {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it == ids.end() || *it != id) return nullptr;
+        return &points[it - ids.begin()];
+    }
+
+    NodeCoordinates::Position NodeCoordinates::toPosition(const Point &point) const
+    {
+        if (system == PLANAR)
+            return {point.x, point.y, 0.0};
+        const double degree = std::acos(-1.0) / 180.0;
+        const double lon = point.x * degree, lat = point.y * degree;
+        return {EARTH_RADIUS_KM * std::cos(lat) * std::cos(lon), EARTH_RADIUS_KM * std::cos(lat) * std::sin(lon),
+                EARTH_RADIUS_KM * std::sin(lat)};
+    }
+
+    double NodeCoordinates::distance(const Position &a, const Position &b)
+    {
+        const double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+}
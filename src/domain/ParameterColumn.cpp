@@ -0,0 +1,162 @@
+#include "domain/ParameterColumn.h"
+#include <algorithm>
+
+namespace Domain
+{
+    void ParameterColumn::push(double value)
+    {
+        if (!materialized && value == defaultValue)
+        {
+            ++count;
+            return;
+        }
+        resize(count + 1);
+        set(count - 1, value);
+    }
+
+    void ParameterColumn::resize(std::size_t size)
+    {
+        count = size;
+        if (!materialized) return;
+        switch (encoding)
+        {
+        case FLOAT32: f32.resize(size, static_cast<float>(defaultValue)); break;
+        case FRACTION16: q16.resize(size, quantize(defaultValue)); break;
+        default: f64.resize(size, defaultValue); break;
+        }
+    }
+
+    void ParameterColumn::reserve(std::size_t size)
+    {
+        if (!materialized) return;
+        switch (encoding)
+        {
+        case FLOAT32: f32.reserve(size); break;
+        case FRACTION16: q16.reserve(size); break;
+        default: f64.reserve(size); break;
+        }
+    }
+
+    void ParameterColumn::clear()
+    {
+        count = 0;
+        materialized = false;
+        f64.reset();
+        f32.reset();
+        q16.reset();
+    }
+
+    void ParameterColumn::share()
+    {
+        f64.share();
+        f32.share();
+        q16.share();
+    }
+
+    ParameterColumn ParameterColumn::view(Encoding encoding, double default_value, const void *data,
+                                          std::size_t count, std::shared_ptr<const void> backing)
+    {
+        ParameterColumn res(encoding, default_value);
+        res.materialized = true;
+        res.count = count;
+        switch (encoding)
+        {
+        case FLOAT32: res.f32 = PagedArray<float>::view(static_cast<const float *>(data), count, std::move(backing)); break;
+        case FRACTION16:
+            res.q16 = PagedArray<std::uint16_t>::view(static_cast<const std::uint16_t *>(data), count, std::move(backing));
+            break;
+        default: res.f64 = PagedArray<double>::view(static_cast<const double *>(data), count, std::move(backing)); break;
+        }
+        return res;
+    }
+
+    const void *ParameterColumn::getData() const
+    {
+        if (!materialized) return nullptr;
+        switch (encoding)
+        {
+        case FLOAT32: return f32.data();
+        case FRACTION16: return q16.data();
+        default: return f64.data();
+        }
+    }
+
+    void ParameterColumn::materialize()
+    {
+        materialized = true;
+        std::size_t size = count;
+        count = 0;
+        resize(size);
+    }
+
+    const double *ParameterColumn::read(std::size_t first, std::size_t n, double *buffer) const
+    {
+        if (!materialized)
+        {
+            std::fill(buffer, buffer + n, defaultValue);
+            return buffer;
+        }
+        switch (encoding)
+        {
+        case FLOAT32:
+            if (const float *values = f32.range(first, n))
+                for (std::size_t i = 0; i < n; ++i) buffer[i] = values[i];
+            else
+                for (std::size_t i = 0; i < n; ++i) buffer[i] = f32[first + i];
+            return buffer;
+        case FRACTION16:
+            if (const std::uint16_t *values = q16.range(first, n))
+                for (std::size_t i = 0; i < n; ++i) buffer[i] = values[i] * (1.0 / FRACTION_SCALE);
+            else
+                for (std::size_t i = 0; i < n; ++i) buffer[i] = q16[first + i] * (1.0 / FRACTION_SCALE);
+            return buffer;
+        default:
+            if (const double *values = f64.range(first, n))
+                return values;
+            for (std::size_t i = 0; i < n; ++i) buffer[i] = f64[first + i];
+            return buffer;
+        }
+    }
+
+    ParameterColumn ParameterColumn::reencode(Encoding target) const
+    {
+        ParameterColumn res(target, defaultValue);
+        res.count = count;
+        if (!materialized) return res;
+        res.materialize();
+        for (std::size_t i = 0; i < count; ++i)
+            res.store(i, get(i));
+        return res;
+    }
+
+    std::size_t ParameterColumn::getMemoryUsage() const
+    {
+        return f64.getMemoryUsage() + f32.getMemoryUsage() + q16.getMemoryUsage();
+    }
+
+    std::size_t ParameterColumn::getEncodedSize(Encoding encoding)
+    {
+        switch (encoding)
+        {
+        case FLOAT32: return sizeof(float);
+        case FRACTION16: return sizeof(std::uint16_t);
+        default: return sizeof(double);
+        }
+    }
+
+    void ParameterColumn::encode(Encoding encoding, const double *values, std::size_t count, void *out)
+    {
+        switch (encoding)
+        {
+        case FLOAT32:
+            for (std::size_t i = 0; i < count; ++i) static_cast<float *>(out)[i] = static_cast<float>(values[i]);
+            break;
+        case FRACTION16:
+            for (std::size_t i = 0; i < count; ++i) static_cast<std::uint16_t *>(out)[i] = quantize(values[i]);
+            break;
+        default:
+            std::copy(values, values + count, static_cast<double *>(out));
+            break;
+        }
+    }
+}
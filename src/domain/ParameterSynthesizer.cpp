@@ -0,0 +1,56 @@
+#include "domain/ParameterSynthesizer.h"
+
+namespace Domain
+{
+    namespace
+    {
+        // финализатор SplitMix64: биективное перемешивание 64-битного слова
+        std::uint64_t mix(std::uint64_t x)
+        {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+
+        // [0, 1) из старших 53 бит (мантисса double)
+        double toUnit(std::uint64_t h)
+        {
+            return static_cast<double>(h >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        // номера параметров в потоке ребра
+        enum Draw {
+            COST,
+            BANDWIDTH,
+            PACKET_LOSS,
+            UTILIZATION,
+            RELIABILITY
+        };
+    }
+
+    std::uint64_t ParameterSynthesizer::edgeKey(NodeId source, NodeId target) const
+    {
+        return mix(mix(seed ^ mix(static_cast<std::uint64_t>(source))) ^ static_cast<std::uint64_t>(target));
+    }
+
+    double ParameterSynthesizer::uniform(NodeId source, NodeId target, unsigned counter) const
+    {
+        return toUnit(mix(edgeKey(source, target) + counter));
+    }
+
+    LinkParameters ParameterSynthesizer::synthesize(NodeId source, NodeId target, double latency) const
+    {
+        const std::uint64_t key = edgeKey(source, target);
+        auto draw = [key](Draw counter, double lo, double hi) { return lo + (hi - lo) * toUnit(mix(key + counter)); };
+
+        LinkParameters params;
+        params.latency = latency;
+        params.cost = latency * draw(COST, 0.5, 5.0);               // стоимость 0.5-5.0 на единицу задержки
+        params.bandwidth = draw(BANDWIDTH, 50.0, 500.0);            // пропускная способность 50-500 Мбит/с
+        params.packet_loss = draw(PACKET_LOSS, 0.0, 0.05);          // потери пакетов 0-5%
+        params.utilization = draw(UTILIZATION, 0.1, 0.8);           // загрузка канала 10-80%
+        params.reliability = draw(RELIABILITY, 0.85, 0.99);         // надежность 85-99%
+        return params;
+    }
+}
@@ -1,8 +1,62 @@
 #include "domain/WeightCalculator.h"
+#include "domain/WeightPolicies.h"
+#include "domain/CustomStrategy.h"
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
 
 namespace Domain
 {
+    namespace
+    {
+        // реестр пользовательских стратегий: записи не удаляются и не перемещаются,
+        // поэтому поиск по значению Strategy идет без блокировки
+        std::mutex registryMutex;
+        std::atomic<const CustomStrategy *> customStrategies[WeightCalculator::MAX_CUSTOM_STRATEGIES];
+        std::atomic<int> customCount{0};
+
+        bool sameSpec(const CustomStrategy::Spec &a, const CustomStrategy::Spec &b)
+        {
+            if (a.name != b.name || a.description != b.description || a.components.size() != b.components.size())
+                return false;
+            for (std::size_t i = 0; i < a.components.size(); ++i)
+            {
+                const auto &x = a.components[i];
+                const auto &y = b.components[i];
+                if (x.term != y.term || x.coefficient != y.coefficient || x.threshold != y.threshold)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    WeightCalculator::Strategy WeightCalculator::registerStrategy(const CustomStrategy &strategy)
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        const int count = customCount.load(std::memory_order_relaxed);
+        for (int i = 0; i < count; ++i)
+        {
+            if (sameSpec(customStrategies[i].load(std::memory_order_relaxed)->getSpec(), strategy.getSpec()))
+                return static_cast<Strategy>(CUSTOM_STRATEGY_BASE + i);
+        }
+        if (count >= MAX_CUSTOM_STRATEGIES)
+            throw std::length_error("Too many custom strategies: " + strategy.getName());
+
+        customStrategies[count].store(new CustomStrategy(strategy), std::memory_order_release);
+        customCount.store(count + 1, std::memory_order_release);
+        return static_cast<Strategy>(CUSTOM_STRATEGY_BASE + count);
+    }
+
+    const CustomStrategy *WeightCalculator::getCustomStrategy(Strategy strategy)
+    {
+        const int index = static_cast<int>(strategy) - CUSTOM_STRATEGY_BASE;
+        if (index < 0 || index >= customCount.load(std::memory_order_acquire))
+            return nullptr;
+        return customStrategies[index].load(std::memory_order_acquire);
+    }
+
     std::string WeightCalculator::getStrategyName(Strategy strategy)
     {
         static const std::unordered_map<Strategy, std::string> strategyNames = {
@@ -14,7 +68,10 @@ namespace Domain
             {ADAPTIVE_WEIGHTS, "Adaptive"}};
 
         auto it = strategyNames.find(strategy);
-        return it != strategyNames.end() ? it->second : "Unknown Strategy";
+        if (it != strategyNames.end())
+            return it->second;
+        const CustomStrategy *custom = getCustomStrategy(strategy);
+        return custom ? custom->getName() : "Unknown Strategy";
     }
 
     std::string WeightCalculator::getStrategyDescription(Strategy strategy)
@@ -28,12 +85,20 @@ namespace Domain
             {ADAPTIVE_WEIGHTS, "Dynamically adjust weights based on network conditions"}};
 
         auto it = strategyDescriptions.find(strategy);
-        return it != strategyDescriptions.end() ? it->second : "No description available";
+        if (it != strategyDescriptions.end())
+            return it->second;
+        const CustomStrategy *custom = getCustomStrategy(strategy);
+        return custom && !custom->getDescription().empty() ? custom->getDescription() : "No description available";
     }
 
     std::vector<WeightCalculator::Strategy> WeightCalculator::getAllStrategies()
     {
-        return {UNIFORM_WEIGHTS, MINIMIZE_LATENCY, BALANCE_LOAD, MAXIMIZE_BANDWIDTH, MINIMIZE_COST, ADAPTIVE_WEIGHTS};
+        std::vector<Strategy> strategies = {UNIFORM_WEIGHTS, MINIMIZE_LATENCY, BALANCE_LOAD, MAXIMIZE_BANDWIDTH,
+                                            MINIMIZE_COST, ADAPTIVE_WEIGHTS};
+        const int custom = customCount.load(std::memory_order_acquire);
+        for (int i = 0; i < custom; ++i)
+            strategies.push_back(static_cast<Strategy>(CUSTOM_STRATEGY_BASE + i));
+        return strategies;
     }
 
     double WeightCalculator::calculateCompositeWeight(const LinkParameters &params, Strategy strategy)
@@ -53,7 +118,72 @@ namespace Domain
         case ADAPTIVE_WEIGHTS:
             return calculateAdaptiveWeight(params);
         default:
-            return calculateLatencyWeight(params);
+        {
+            const CustomStrategy *custom = getCustomStrategy(strategy);
+            return custom ? custom->evaluate(params) : calculateLatencyWeight(params);
+        }
+        }
+    }
+
+    void WeightCalculator::calculateWeights(const LinkParameterStore &store, Strategy strategy,
+                                            std::vector<double> &weights)
+    {
+        const std::size_t n = store.size();
+        weights.resize(n);
+        if (strategy == UNIFORM_WEIGHTS)
+        {
+            std::fill(weights.begin(), weights.end(), calculateUniformWeight());
+            return;
+        }
+
+        // столбцы читаются блоками: в полной точности это указатели прямо в хранилище,
+        // в сжатых режимах блок декодируется в буфер на стеке
+        constexpr std::size_t BLOCK = 512;
+        double buffers[LinkParameterStore::COLUMN_COUNT][BLOCK];
+        const CustomStrategy *custom = getCustomStrategy(strategy);
+
+        for (std::size_t first = 0; first < n; first += BLOCK)
+        {
+            const std::size_t count = std::min(BLOCK, n - first);
+            auto column = [&](LinkParameterStore::Column c) { return store.readColumn(c, first, count, buffers[c]); };
+
+            ParameterColumns columns;
+            if (custom)
+            {
+                // пользовательской стратегии читаются только столбцы ее слагаемых
+                const double **targets[LinkParameterStore::COLUMN_COUNT] = {
+                    &columns.latency, &columns.bandwidth, &columns.packet_loss,
+                    &columns.utilization, &columns.cost, &columns.reliability};
+                for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+                    if (custom->getColumns() & WeightPolicy::columnBit(static_cast<LinkParameterStore::Column>(c)))
+                        *targets[c] = column(static_cast<LinkParameterStore::Column>(c));
+                custom->calculateBatch(columns, count, weights.data() + first, getInstructionSet());
+                continue;
+            }
+            switch (strategy)
+            {
+            case MAXIMIZE_BANDWIDTH:
+                columns.bandwidth = column(LinkParameterStore::BANDWIDTH);
+                break;
+            case MINIMIZE_COST:
+                columns.cost = column(LinkParameterStore::COST);
+                break;
+            case ADAPTIVE_WEIGHTS:
+                columns.reliability = column(LinkParameterStore::RELIABILITY);
+                [[fallthrough]];
+            case BALANCE_LOAD:
+                columns.latency = column(LinkParameterStore::LATENCY);
+                columns.bandwidth = column(LinkParameterStore::BANDWIDTH);
+                columns.packet_loss = column(LinkParameterStore::PACKET_LOSS);
+                columns.utilization = column(LinkParameterStore::UTILIZATION);
+                columns.cost = column(LinkParameterStore::COST);
+                break;
+            case MINIMIZE_LATENCY:
+            default:
+                columns.latency = column(LinkParameterStore::LATENCY);
+                break;
+            }
+            calculateBatch(columns, count, strategy, weights.data() + first);
         }
     }
 
@@ -69,16 +199,14 @@ namespace Domain
 
     double WeightCalculator::calculateBalancedWeight(const LinkParameters &params)
     {
-        // нелинейные зависимости между параметрами
-        double effective_latency = calculateEffectiveLatency(params.latency, params.utilization);
-        double current_bandwidth = calculateCurrentBandwidth(params.bandwidth, params.packet_loss);
-        double dynamic_reliability = calculateDynamicReliability(params.packet_loss, params.utilization);
+        return calculateBalancedWeight(params.latency, params.bandwidth, params.packet_loss,
+                                       params.utilization, params.cost);
+    }
 
-        // композитный вес с учетом взаимовлияния параметров
-        return effective_latency * 0.5 +
-               (1.0 / current_bandwidth) * 0.2 +
-               params.cost * 0.15 +
-               (1.0 - dynamic_reliability) * 0.15;
+    double WeightCalculator::calculateBalancedWeight(double latency, double bandwidth, double packet_loss,
+                                                     double utilization, double cost)
+    {
+        return WeightPolicy::Balanced::evaluate(latency, bandwidth, packet_loss, utilization, cost);
     }
 
     double WeightCalculator::calculateBandwidthWeight(const LinkParameters &params)
@@ -92,43 +220,32 @@ namespace Domain
     }
 
     double WeightCalculator::calculateAdaptiveWeight(const LinkParameters &params)
+    {
+        return calculateAdaptiveWeight(params.latency, params.bandwidth, params.packet_loss,
+                                       params.utilization, params.cost, params.reliability);
+    }
+
+    double WeightCalculator::calculateAdaptiveWeight(double latency, double bandwidth, double packet_loss,
+                                                     double utilization, double cost, double reliability)
     {
         // адаптивная стратегия на основе текущих условий сети
-        if (params.utilization > 0.8)
-        {
-            // при высокой загрузке надежность
-            return (1.0 - params.reliability) * 100.0;
-        }
-        else if (params.packet_loss > 0.1)
-        {
-            // при высоких потерях пропускная способность
-            return 1.0 / params.bandwidth;
-        }
-        else
-        {
-            // в нормальных условиях - сбалансированный подход
-            return calculateBalancedWeight(params);
-        }
+        return WeightPolicy::Adaptive::evaluate(latency, bandwidth, packet_loss, utilization, cost, reliability);
     }
 
-    // моделирование взаимовлияния параметров
+    // моделирование взаимовлияния параметров (формулы в WeightPolicies.h)
     double WeightCalculator::calculateEffectiveLatency(double base_latency, double utilization)
     {
-        // задержка растет нелинейно при высокой загрузке
-        return base_latency * (1.0 + 3.0 * utilization * utilization);
+        return WeightPolicy::effectiveLatency(base_latency, utilization);
     }
 
     double WeightCalculator::calculateCurrentBandwidth(double max_bandwidth, double packet_loss)
     {
-        // эффективная пропускная способность уменьшается из-за потерь
-        return max_bandwidth * (1.0 - packet_loss);
+        return WeightPolicy::currentBandwidth(max_bandwidth, packet_loss);
     }
 
     double WeightCalculator::calculateDynamicReliability(double packet_loss, double utilization)
     {
-        // надежность падает при высоких потерях и загрузке
-        double penalty = packet_loss * 0.7 + utilization * 0.3;
-        return std::max(0.0, 1.0 - penalty);
+        return WeightPolicy::dynamicReliability(packet_loss, utilization);
     }
 
     void WeightCalculator::analyzeParameterDependencies(const LinkParameters& params) {
@@ -0,0 +1,639 @@
+#include "domain/WeightCalculator.h"
+#include "domain/WeightPolicies.h"
+#include "domain/CustomStrategy.h"
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+// векторные ядра собираются только для x86; набор инструкций задается атрибутом функции,
+// поэтому отдельные флаги компиляции не нужны, а выбор ядра делается во время выполнения
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define WEIGHT_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define KERNEL_TARGET(isa)
+#else
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace Domain
+{
+    namespace
+    {
+        constexpr double HIGH_UTILIZATION = WeightPolicy::Adaptive::HIGH_UTILIZATION;
+        constexpr double HIGH_PACKET_LOSS = WeightPolicy::Adaptive::HIGH_PACKET_LOSS;
+
+        std::atomic<int> selectedIsa{-1};
+
+#ifdef WEIGHT_KERNELS_X86
+        // формула сбалансированной стратегии в той же последовательности операций, что и
+        // WeightPolicy::Balanced; FMA не используется - результат совпадает побитово
+        KERNEL_TARGET("avx2")
+        inline __m256d balancedAvx2(__m256d lat, __m256d bw, __m256d loss, __m256d util, __m256d cost)
+        {
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d k015 = _mm256_set1_pd(0.15);
+            __m256d effective = _mm256_mul_pd(lat, _mm256_add_pd(one, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(3.0), util), util)));
+            __m256d current_bw = _mm256_mul_pd(bw, _mm256_sub_pd(one, loss));
+            __m256d penalty = _mm256_add_pd(_mm256_mul_pd(loss, _mm256_set1_pd(0.7)), _mm256_mul_pd(util, _mm256_set1_pd(0.3)));
+            __m256d reliability = _mm256_max_pd(_mm256_sub_pd(one, penalty), _mm256_setzero_pd());
+            __m256d res = _mm256_add_pd(_mm256_mul_pd(effective, _mm256_set1_pd(0.5)),
+                                        _mm256_mul_pd(_mm256_div_pd(one, current_bw), _mm256_set1_pd(0.2)));
+            res = _mm256_add_pd(res, _mm256_mul_pd(cost, k015));
+            return _mm256_add_pd(res, _mm256_mul_pd(_mm256_sub_pd(one, reliability), k015));
+        }
+
+        // с AVX-512 компилятору доступна FMA, и GCC сливает обычные умножение и сложение в одну
+        // инструкцию с другим округлением; варианты с явным режимом округления не сливаются
+        constexpr __mmask8 ALL_LANES = 0xFF;
+
+        KERNEL_TARGET("avx512f")
+        inline __m512d mul512(__m512d a, __m512d b) { return _mm512_maskz_mul_round_pd(ALL_LANES, a, b, _MM_FROUND_CUR_DIRECTION); }
+
+        KERNEL_TARGET("avx512f")
+        inline __m512d add512(__m512d a, __m512d b) { return _mm512_maskz_add_round_pd(ALL_LANES, a, b, _MM_FROUND_CUR_DIRECTION); }
+
+        KERNEL_TARGET("avx512f")
+        inline __m512d sub512(__m512d a, __m512d b) { return _mm512_maskz_sub_round_pd(ALL_LANES, a, b, _MM_FROUND_CUR_DIRECTION); }
+
+        KERNEL_TARGET("avx512f")
+        inline __m512d balancedAvx512(__m512d lat, __m512d bw, __m512d loss, __m512d util, __m512d cost)
+        {
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d k015 = _mm512_set1_pd(0.15);
+            __m512d effective = mul512(lat, add512(one, mul512(mul512(_mm512_set1_pd(3.0), util), util)));
+            __m512d current_bw = mul512(bw, sub512(one, loss));
+            __m512d penalty = add512(mul512(loss, _mm512_set1_pd(0.7)), mul512(util, _mm512_set1_pd(0.3)));
+            // max(0, x) в форме std::max: ноль, если x не больше нуля
+            __m512d reliability = sub512(one, penalty);
+            reliability = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(_mm512_setzero_pd(), reliability, _CMP_LT_OQ), reliability);
+            __m512d res = add512(mul512(effective, _mm512_set1_pd(0.5)),
+                                 mul512(_mm512_div_pd(one, current_bw), _mm512_set1_pd(0.2)));
+            res = add512(res, mul512(cost, k015));
+            return add512(res, mul512(sub512(one, reliability), k015));
+        }
+#endif
+    }
+
+    void WeightCalculator::calculateBatchScalar(const ParameterColumns &c, std::size_t first, std::size_t count,
+                                                Strategy strategy, double *out)
+    {
+        switch (strategy)
+        {
+        case MAXIMIZE_BANDWIDTH:
+            for (std::size_t i = first; i < count; ++i)
+                out[i] = 1.0 / c.bandwidth[i];
+            break;
+        case BALANCE_LOAD:
+            for (std::size_t i = first; i < count; ++i)
+                out[i] = WeightPolicy::Balanced::weight(c, static_cast<WeightPolicy::EdgeIndex>(i));
+            break;
+        case ADAPTIVE_WEIGHTS:
+            for (std::size_t i = first; i < count; ++i)
+                out[i] = WeightPolicy::Adaptive::weight(c, static_cast<WeightPolicy::EdgeIndex>(i));
+            break;
+        default:
+            break;
+        }
+    }
+
+#ifdef WEIGHT_KERNELS_X86
+    KERNEL_TARGET("avx2")
+    void WeightCalculator::calculateBatchAvx2(const ParameterColumns &c, std::size_t count, Strategy strategy, double *out)
+    {
+        const __m256d one = _mm256_set1_pd(1.0);
+        const __m256d high_util = _mm256_set1_pd(HIGH_UTILIZATION);
+        const __m256d high_loss = _mm256_set1_pd(HIGH_PACKET_LOSS);
+
+        const std::size_t vector_end = count - count % 4;
+        switch (strategy)
+        {
+        case MAXIMIZE_BANDWIDTH:
+            for (std::size_t i = 0; i < vector_end; i += 4)
+                _mm256_storeu_pd(out + i, _mm256_div_pd(one, _mm256_loadu_pd(c.bandwidth + i)));
+            break;
+        case BALANCE_LOAD:
+            for (std::size_t i = 0; i < vector_end; i += 4)
+            {
+                _mm256_storeu_pd(out + i, balancedAvx2(_mm256_loadu_pd(c.latency + i), _mm256_loadu_pd(c.bandwidth + i),
+                                                       _mm256_loadu_pd(c.packet_loss + i), _mm256_loadu_pd(c.utilization + i),
+                                                       _mm256_loadu_pd(c.cost + i)));
+            }
+            break;
+        case ADAPTIVE_WEIGHTS:
+            for (std::size_t i = 0; i < vector_end; i += 4)
+            {
+                __m256d bw = _mm256_loadu_pd(c.bandwidth + i);
+                __m256d loss = _mm256_loadu_pd(c.packet_loss + i);
+                __m256d util = _mm256_loadu_pd(c.utilization + i);
+                __m256d res = balancedAvx2(_mm256_loadu_pd(c.latency + i), bw, loss, util, _mm256_loadu_pd(c.cost + i));
+                __m256d loaded = _mm256_mul_pd(_mm256_sub_pd(one, _mm256_loadu_pd(c.reliability + i)), _mm256_set1_pd(100.0));
+                res = _mm256_blendv_pd(res, _mm256_div_pd(one, bw), _mm256_cmp_pd(loss, high_loss, _CMP_GT_OQ));
+                res = _mm256_blendv_pd(res, loaded, _mm256_cmp_pd(util, high_util, _CMP_GT_OQ));
+                _mm256_storeu_pd(out + i, res);
+            }
+            break;
+        default:
+            break;
+        }
+        calculateBatchScalar(c, vector_end, count, strategy, out);
+    }
+
+    KERNEL_TARGET("avx512f")
+    void WeightCalculator::calculateBatchAvx512(const ParameterColumns &c, std::size_t count, Strategy strategy, double *out)
+    {
+        const __m512d one = _mm512_set1_pd(1.0);
+        const __m512d high_util = _mm512_set1_pd(HIGH_UTILIZATION);
+        const __m512d high_loss = _mm512_set1_pd(HIGH_PACKET_LOSS);
+
+        // хвост обрабатывается той же веткой через маску загрузки/записи
+        for (std::size_t i = 0; i < count; i += 8)
+        {
+            const __mmask8 lanes = count - i >= 8 ? __mmask8(0xFF) : __mmask8((1u << (count - i)) - 1);
+            // неактивные полосы заполняются единицами, чтобы не делить на ноль
+            const __m512d bw = _mm512_mask_loadu_pd(one, lanes, c.bandwidth + i);
+
+            __m512d res;
+            switch (strategy)
+            {
+            case MAXIMIZE_BANDWIDTH:
+                res = _mm512_div_pd(one, bw);
+                break;
+            case BALANCE_LOAD:
+                res = balancedAvx512(_mm512_mask_loadu_pd(one, lanes, c.latency + i), bw,
+                                     _mm512_mask_loadu_pd(one, lanes, c.packet_loss + i),
+                                     _mm512_mask_loadu_pd(one, lanes, c.utilization + i),
+                                     _mm512_mask_loadu_pd(one, lanes, c.cost + i));
+                break;
+            case ADAPTIVE_WEIGHTS:
+            {
+                __m512d loss = _mm512_mask_loadu_pd(one, lanes, c.packet_loss + i);
+                __m512d util = _mm512_mask_loadu_pd(one, lanes, c.utilization + i);
+                res = balancedAvx512(_mm512_mask_loadu_pd(one, lanes, c.latency + i), bw, loss, util,
+                                     _mm512_mask_loadu_pd(one, lanes, c.cost + i));
+                __m512d loaded = mul512(sub512(one, _mm512_mask_loadu_pd(one, lanes, c.reliability + i)),
+                                        _mm512_set1_pd(100.0));
+                res = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(loss, high_loss, _CMP_GT_OQ), res, _mm512_div_pd(one, bw));
+                res = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(util, high_util, _CMP_GT_OQ), res, loaded);
+                break;
+            }
+            default:
+                return;
+            }
+            _mm512_mask_storeu_pd(out + i, lanes, res);
+        }
+    }
+#else
+    void WeightCalculator::calculateBatchAvx2(const ParameterColumns &c, std::size_t count, Strategy strategy, double *out)
+    {
+        calculateBatchScalar(c, 0, count, strategy, out);
+    }
+
+    void WeightCalculator::calculateBatchAvx512(const ParameterColumns &c, std::size_t count, Strategy strategy, double *out)
+    {
+        calculateBatchScalar(c, 0, count, strategy, out);
+    }
+#endif
+
+    WeightCalculator::InstructionSet WeightCalculator::getSupportedInstructionSet()
+    {
+        static const InstructionSet supported = [] {
+#if defined(WEIGHT_KERNELS_X86) && defined(_MSC_VER) && !defined(__clang__)
+            // CPUID: AVX2 - лист 7 EBX[5], AVX-512F - лист 7 EBX[16]; регистры должны сохраняться ОС (XCR0)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return SCALAR_KERNEL;
+            __cpuid(info, 1);
+            if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28))) return SCALAR_KERNEL;
+            unsigned long long xcr0 = _xgetbv(0);
+            if ((xcr0 & 0x6) != 0x6) return SCALAR_KERNEL;
+            __cpuidex(info, 7, 0);
+            if ((info[1] & (1 << 16)) && (xcr0 & 0xE0) == 0xE0) return AVX512_KERNEL;
+            return (info[1] & (1 << 5)) ? AVX2_KERNEL : SCALAR_KERNEL;
+#elif defined(WEIGHT_KERNELS_X86)
+            // проверка GCC/Clang учитывает и поддержку регистров операционной системой
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return AVX512_KERNEL;
+            if (__builtin_cpu_supports("avx2")) return AVX2_KERNEL;
+            return SCALAR_KERNEL;
+#else
+            return SCALAR_KERNEL;
+#endif
+        }();
+        return supported;
+    }
+
+    WeightCalculator::InstructionSet WeightCalculator::getInstructionSet()
+    {
+        int isa = selectedIsa.load(std::memory_order_relaxed);
+        return isa < 0 ? getSupportedInstructionSet() : static_cast<InstructionSet>(isa);
+    }
+
+    void WeightCalculator::setInstructionSet(InstructionSet isa)
+    {
+        selectedIsa.store(std::min(isa, getSupportedInstructionSet()), std::memory_order_relaxed);
+    }
+
+    std::string WeightCalculator::getInstructionSetName(InstructionSet isa)
+    {
+        switch (isa)
+        {
+        case AVX2_KERNEL: return "AVX2";
+        case AVX512_KERNEL: return "AVX-512";
+        default: return "Scalar";
+        }
+    }
+
+    void WeightCalculator::calculateBatch(const ParameterColumns &columns, std::size_t count, Strategy strategy,
+                                          double *out)
+    {
+        calculateBatch(columns, count, strategy, out, getInstructionSet());
+    }
+
+    void WeightCalculator::calculateBatch(const ParameterColumns &columns, std::size_t count, Strategy strategy,
+                                          double *out, InstructionSet isa)
+    {
+        switch (strategy)
+        {
+        case UNIFORM_WEIGHTS:
+            std::fill(out, out + count, calculateUniformWeight());
+            return;
+        case MINIMIZE_COST:
+            std::copy(columns.cost, columns.cost + count, out);
+            return;
+        case MAXIMIZE_BANDWIDTH:
+        case BALANCE_LOAD:
+        case ADAPTIVE_WEIGHTS:
+            break;
+        case MINIMIZE_LATENCY:
+            std::copy(columns.latency, columns.latency + count, out);
+            return;
+        default:
+            if (const CustomStrategy *custom = getCustomStrategy(strategy))
+                custom->calculateBatch(columns, count, out, isa);
+            else
+                std::copy(columns.latency, columns.latency + count, out);
+            return;
+        }
+
+        isa = std::min(isa, getSupportedInstructionSet());
+        if (isa == AVX512_KERNEL)
+            calculateBatchAvx512(columns, count, strategy, out);
+        else if (isa == AVX2_KERNEL)
+            calculateBatchAvx2(columns, count, strategy, out);
+        else
+            calculateBatchScalar(columns, 0, count, strategy, out);
+    }
+
+    // пользовательские стратегии за один проход для любой программы: ребра идут плитками из
+    // нескольких векторов. на плитке сначала считаются нелинейные слагаемые программы (каждое один
+    // раз, деления первыми, чтобы они шли параллельно с остальной работой), затем слагаемые
+    // складываются в порядке описания без ветвления по виду слагаемого: источник значения - столбец
+    // параметра или буфер плитки. порядок операций как в CustomStrategy::weight: значение * коэффициент,
+    // сумма слева направо
+    namespace
+    {
+        using Columns = WeightCalculator::ParameterColumns;
+        using Component = CustomStrategy::Component;
+
+        // векторов в плитке (в скалярном ядре - ребер): суммы плитки должны оставаться в регистрах
+        constexpr std::size_t SCALAR_TILE = 8;
+        constexpr std::size_t AVX2_TILE = 4;
+        constexpr std::size_t AVX512_TILE = 8;
+
+        // нелинейные слагаемые с общим для программы значением (без порога), в порядке расчета
+        constexpr CustomStrategy::Term SHARED_TERMS[] = {
+            CustomStrategy::INVERSE_CURRENT_BANDWIDTH, CustomStrategy::INVERSE_BANDWIDTH,
+            CustomStrategy::EFFECTIVE_LATENCY, CustomStrategy::UNRELIABILITY};
+        constexpr std::size_t SHARED_COUNT = sizeof(SHARED_TERMS) / sizeof(SHARED_TERMS[0]);
+
+        constexpr bool isShared(CustomStrategy::Term term)
+        {
+            return term >= CustomStrategy::EFFECTIVE_LATENCY && term != CustomStrategy::UTILIZATION_EXCESS;
+        }
+
+        // строка буфера плитки для нелинейного слагаемого
+        constexpr std::size_t sharedSlot(CustomStrategy::Term term)
+        {
+            return term == CustomStrategy::INVERSE_CURRENT_BANDWIDTH ? 0
+                 : term == CustomStrategy::INVERSE_BANDWIDTH ? 1
+                 : term == CustomStrategy::EFFECTIVE_LATENCY ? 2 : 3;
+        }
+
+        // столбцы по номеру слагаемого; UTILIZATION_EXCESS читает загрузку
+        struct TermSources
+        {
+            const double *columns[CustomStrategy::TERM_COUNT] = {};
+
+            explicit TermSources(const Columns &c)
+            {
+                const double *linear[] = {c.latency, c.bandwidth, c.packet_loss, c.utilization, c.cost, c.reliability};
+                std::copy(linear, linear + CustomStrategy::RELIABILITY + 1, columns);
+                columns[CustomStrategy::UTILIZATION_EXCESS] = c.utilization;
+            }
+
+            // начало значений слагаемого на плитке с первым ребром i (shared - буфер плитки)
+            const double *at(const Component &component, std::size_t i, const double *shared, std::size_t stride) const
+            {
+                return isShared(component.term) ? shared + sharedSlot(component.term) * stride
+                                                : columns[component.term] + i;
+            }
+        };
+
+        template <CustomStrategy::Term TERM>
+        inline double termScalar(const Columns &c, std::size_t i)
+        {
+            if constexpr (TERM == CustomStrategy::EFFECTIVE_LATENCY)
+                return WeightPolicy::effectiveLatency(c.latency[i], c.utilization[i]);
+            else if constexpr (TERM == CustomStrategy::INVERSE_BANDWIDTH)
+                return 1.0 / c.bandwidth[i];
+            else if constexpr (TERM == CustomStrategy::INVERSE_CURRENT_BANDWIDTH)
+                return 1.0 / WeightPolicy::currentBandwidth(c.bandwidth[i], c.packet_loss[i]);
+            else
+                return 1.0 - WeightPolicy::dynamicReliability(c.packet_loss[i], c.utilization[i]);
+        }
+
+        template <std::size_t... U>
+        inline void sharedScalar(double *shared, unsigned terms, const Columns &c, std::size_t i,
+                                 std::index_sequence<U...>)
+        {
+            constexpr std::size_t size = sizeof...(U);
+            if (terms & (1u << CustomStrategy::INVERSE_CURRENT_BANDWIDTH))
+                ((shared[0 * size + U] = termScalar<CustomStrategy::INVERSE_CURRENT_BANDWIDTH>(c, i + U)), ...);
+            if (terms & (1u << CustomStrategy::INVERSE_BANDWIDTH))
+                ((shared[1 * size + U] = termScalar<CustomStrategy::INVERSE_BANDWIDTH>(c, i + U)), ...);
+            if (terms & (1u << CustomStrategy::EFFECTIVE_LATENCY))
+                ((shared[2 * size + U] = termScalar<CustomStrategy::EFFECTIVE_LATENCY>(c, i + U)), ...);
+            if (terms & (1u << CustomStrategy::UNRELIABILITY))
+                ((shared[3 * size + U] = termScalar<CustomStrategy::UNRELIABILITY>(c, i + U)), ...);
+        }
+
+        // значения слагаемого на плитке; порог UTILIZATION_EXCESS - единственная поправка после чтения
+        template <std::size_t... U>
+        inline void valuesScalar(double (&v)[sizeof...(U)], const Component &component, const double *src,
+                                 std::index_sequence<U...>)
+        {
+            ((v[U] = src[U]), ...);
+            if (component.term == CustomStrategy::UTILIZATION_EXCESS)
+                ((v[U] = std::max(0.0, v[U] - component.threshold)), ...);
+        }
+
+        // плитки по U ребер от first, пока помещаются целиком; возвращает начало необработанного хвоста
+        template <std::size_t... U>
+        inline std::size_t programScalar(const std::vector<Component> &program, unsigned terms, const Columns &c,
+                                         std::size_t first, std::size_t count, double *out,
+                                         std::index_sequence<U...> tile)
+        {
+            constexpr std::size_t size = sizeof...(U);
+            const TermSources sources(c);
+            std::size_t i = first;
+            for (; i + size <= count; i += size)
+            {
+                double shared[SHARED_COUNT * size];
+                sharedScalar(shared, terms, c, i, tile);
+
+                double v[size];
+                valuesScalar(v, program[0], sources.at(program[0], i, shared, size), tile);
+                double acc[size] = {v[U] * program[0].coefficient...};
+                for (std::size_t t = 1; t < program.size(); ++t)
+                {
+                    valuesScalar(v, program[t], sources.at(program[t], i, shared, size), tile);
+                    ((acc[U] = acc[U] + v[U] * program[t].coefficient), ...);
+                }
+                ((out[i + U] = acc[U]), ...);
+            }
+            return i;
+        }
+
+#ifdef WEIGHT_KERNELS_X86
+        template <CustomStrategy::Term TERM>
+        KERNEL_TARGET("avx2")
+        inline __m256d termAvx2(const Columns &c, std::size_t i)
+        {
+            const __m256d one = _mm256_set1_pd(1.0);
+            if constexpr (TERM == CustomStrategy::EFFECTIVE_LATENCY)
+            {
+                __m256d util = _mm256_loadu_pd(c.utilization + i);
+                __m256d factor = _mm256_add_pd(one, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(3.0), util), util));
+                return _mm256_mul_pd(_mm256_loadu_pd(c.latency + i), factor);
+            }
+            else if constexpr (TERM == CustomStrategy::INVERSE_BANDWIDTH)
+                return _mm256_div_pd(one, _mm256_loadu_pd(c.bandwidth + i));
+            else if constexpr (TERM == CustomStrategy::INVERSE_CURRENT_BANDWIDTH)
+                return _mm256_div_pd(one, _mm256_mul_pd(_mm256_loadu_pd(c.bandwidth + i),
+                                                        _mm256_sub_pd(one, _mm256_loadu_pd(c.packet_loss + i))));
+            else
+            {
+                __m256d penalty = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(c.packet_loss + i), _mm256_set1_pd(0.7)),
+                                                _mm256_mul_pd(_mm256_loadu_pd(c.utilization + i), _mm256_set1_pd(0.3)));
+                return _mm256_sub_pd(one, _mm256_max_pd(_mm256_sub_pd(one, penalty), _mm256_setzero_pd()));
+            }
+        }
+
+        template <std::size_t... U>
+        KERNEL_TARGET("avx2")
+        inline void sharedAvx2(double *shared, unsigned terms, const Columns &c, std::size_t i, std::index_sequence<U...>)
+        {
+            constexpr std::size_t stride = 4 * sizeof...(U);
+            if (terms & (1u << CustomStrategy::INVERSE_CURRENT_BANDWIDTH))
+                (_mm256_store_pd(shared + 0 * stride + 4 * U, termAvx2<CustomStrategy::INVERSE_CURRENT_BANDWIDTH>(c, i + 4 * U)), ...);
+            if (terms & (1u << CustomStrategy::INVERSE_BANDWIDTH))
+                (_mm256_store_pd(shared + 1 * stride + 4 * U, termAvx2<CustomStrategy::INVERSE_BANDWIDTH>(c, i + 4 * U)), ...);
+            if (terms & (1u << CustomStrategy::EFFECTIVE_LATENCY))
+                (_mm256_store_pd(shared + 2 * stride + 4 * U, termAvx2<CustomStrategy::EFFECTIVE_LATENCY>(c, i + 4 * U)), ...);
+            if (terms & (1u << CustomStrategy::UNRELIABILITY))
+                (_mm256_store_pd(shared + 3 * stride + 4 * U, termAvx2<CustomStrategy::UNRELIABILITY>(c, i + 4 * U)), ...);
+        }
+
+        template <std::size_t... U>
+        KERNEL_TARGET("avx2")
+        inline void valuesAvx2(__m256d (&v)[sizeof...(U)], const Component &component, const double *src,
+                               std::index_sequence<U...>)
+        {
+            ((v[U] = _mm256_loadu_pd(src + 4 * U)), ...);
+            if (component.term == CustomStrategy::UTILIZATION_EXCESS)
+            {
+                const __m256d threshold = _mm256_set1_pd(component.threshold);
+                ((v[U] = _mm256_max_pd(_mm256_sub_pd(v[U], threshold), _mm256_setzero_pd())), ...);
+            }
+        }
+
+        template <std::size_t... U>
+        KERNEL_TARGET("avx2")
+        inline std::size_t programAvx2(const std::vector<Component> &program, unsigned terms, const Columns &c,
+                                       std::size_t first, std::size_t count, double *out, std::index_sequence<U...> tile)
+        {
+            constexpr std::size_t size = sizeof...(U);
+            const TermSources sources(c);
+            std::size_t i = first;
+            for (; i + 4 * size <= count; i += 4 * size)
+            {
+                alignas(32) double shared[SHARED_COUNT * 4 * size];
+                sharedAvx2(shared, terms, c, i, tile);
+
+                __m256d v[size];
+                valuesAvx2(v, program[0], sources.at(program[0], i, shared, 4 * size), tile);
+                __m256d k = _mm256_set1_pd(program[0].coefficient);
+                __m256d acc[size] = {_mm256_mul_pd(v[U], k)...};
+                for (std::size_t t = 1; t < program.size(); ++t)
+                {
+                    valuesAvx2(v, program[t], sources.at(program[t], i, shared, 4 * size), tile);
+                    k = _mm256_set1_pd(program[t].coefficient);
+                    ((acc[U] = _mm256_add_pd(acc[U], _mm256_mul_pd(v[U], k))), ...);
+                }
+                (_mm256_storeu_pd(out + i + 4 * U, acc[U]), ...);
+            }
+            return i;
+        }
+
+        // неактивные полосы загружаются единицами (потери - нулем), чтобы не делить на ноль
+        template <CustomStrategy::Term TERM>
+        KERNEL_TARGET("avx512f")
+        inline __m512d termAvx512(const Columns &c, std::size_t i, __mmask8 lanes)
+        {
+            const __m512d one = _mm512_set1_pd(1.0);
+            if constexpr (TERM == CustomStrategy::EFFECTIVE_LATENCY)
+            {
+                __m512d util = _mm512_mask_loadu_pd(one, lanes, c.utilization + i);
+                __m512d factor = add512(one, mul512(mul512(_mm512_set1_pd(3.0), util), util));
+                return mul512(_mm512_mask_loadu_pd(one, lanes, c.latency + i), factor);
+            }
+            else if constexpr (TERM == CustomStrategy::INVERSE_BANDWIDTH)
+                return _mm512_div_pd(one, _mm512_mask_loadu_pd(one, lanes, c.bandwidth + i));
+            else if constexpr (TERM == CustomStrategy::INVERSE_CURRENT_BANDWIDTH)
+                return _mm512_div_pd(one, mul512(_mm512_mask_loadu_pd(one, lanes, c.bandwidth + i),
+                                                 sub512(one, _mm512_maskz_loadu_pd(lanes, c.packet_loss + i))));
+            else
+            {
+                const __m512d zero = _mm512_setzero_pd();
+                __m512d penalty = add512(mul512(_mm512_mask_loadu_pd(one, lanes, c.packet_loss + i), _mm512_set1_pd(0.7)),
+                                         mul512(_mm512_mask_loadu_pd(one, lanes, c.utilization + i), _mm512_set1_pd(0.3)));
+                __m512d reliability = sub512(one, penalty);
+                reliability = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(zero, reliability, _CMP_LT_OQ), reliability);
+                return sub512(one, reliability);
+            }
+        }
+
+        template <std::size_t... U>
+        KERNEL_TARGET("avx512f")
+        inline void sharedAvx512(double *shared, unsigned terms, const Columns &c, std::size_t i,
+                                 const __mmask8 (&lanes)[sizeof...(U)], std::index_sequence<U...>)
+        {
+            constexpr std::size_t stride = 8 * sizeof...(U);
+            if (terms & (1u << CustomStrategy::INVERSE_CURRENT_BANDWIDTH))
+                (_mm512_store_pd(shared + 0 * stride + 8 * U, termAvx512<CustomStrategy::INVERSE_CURRENT_BANDWIDTH>(c, i + 8 * U, lanes[U])), ...);
+            if (terms & (1u << CustomStrategy::INVERSE_BANDWIDTH))
+                (_mm512_store_pd(shared + 1 * stride + 8 * U, termAvx512<CustomStrategy::INVERSE_BANDWIDTH>(c, i + 8 * U, lanes[U])), ...);
+            if (terms & (1u << CustomStrategy::EFFECTIVE_LATENCY))
+                (_mm512_store_pd(shared + 2 * stride + 8 * U, termAvx512<CustomStrategy::EFFECTIVE_LATENCY>(c, i + 8 * U, lanes[U])), ...);
+            if (terms & (1u << CustomStrategy::UNRELIABILITY))
+                (_mm512_store_pd(shared + 3 * stride + 8 * U, termAvx512<CustomStrategy::UNRELIABILITY>(c, i + 8 * U, lanes[U])), ...);
+        }
+
+        // активные полосы вектора с началом i (за концом массива - ни одной)
+        inline __mmask8 lanesAt(std::size_t count, std::size_t i)
+        {
+            if (i >= count) return 0;
+            return count - i >= 8 ? __mmask8(0xFF) : __mmask8((1u << (count - i)) - 1);
+        }
+
+        // неактивные полосы - единицы, как в termAvx512
+        template <std::size_t... U>
+        KERNEL_TARGET("avx512f")
+        inline void valuesAvx512(__m512d (&v)[sizeof...(U)], const Component &component, const double *src,
+                                 const __mmask8 (&lanes)[sizeof...(U)], std::index_sequence<U...>)
+        {
+            const __m512d one = _mm512_set1_pd(1.0);
+            ((v[U] = _mm512_mask_loadu_pd(one, lanes[U], src + 8 * U)), ...);
+            if (component.term == CustomStrategy::UTILIZATION_EXCESS)
+            {
+                const __m512d threshold = _mm512_set1_pd(component.threshold);
+                const __m512d zero = _mm512_setzero_pd();
+                ((v[U] = sub512(v[U], threshold)), ...);
+                ((v[U] = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(zero, v[U], _CMP_LT_OQ), v[U])), ...);
+            }
+        }
+
+        // последняя плитка - через маски полос
+        template <std::size_t... U>
+        KERNEL_TARGET("avx512f")
+        inline void programAvx512(const std::vector<Component> &program, unsigned terms, const Columns &c,
+                                  std::size_t count, double *out, std::index_sequence<U...> tile)
+        {
+            constexpr std::size_t size = sizeof...(U);
+            const TermSources sources(c);
+            for (std::size_t i = 0; i < count; i += 8 * size)
+            {
+                const __mmask8 lanes[size] = {lanesAt(count, i + 8 * U)...};
+                alignas(64) double shared[SHARED_COUNT * 8 * size];
+                sharedAvx512(shared, terms, c, i, lanes, tile);
+
+                __m512d v[size];
+                valuesAvx512(v, program[0], sources.at(program[0], i, shared, 8 * size), lanes, tile);
+                __m512d k = _mm512_set1_pd(program[0].coefficient);
+                __m512d acc[size] = {mul512(v[U], k)...};
+                for (std::size_t t = 1; t < program.size(); ++t)
+                {
+                    valuesAvx512(v, program[t], sources.at(program[t], i, shared, 8 * size), lanes, tile);
+                    k = _mm512_set1_pd(program[t].coefficient);
+                    ((acc[U] = add512(acc[U], mul512(v[U], k))), ...);
+                }
+                (_mm512_mask_storeu_pd(out + i + 8 * U, lanes[U], acc[U]), ...);
+            }
+        }
+#endif
+    }
+
+    void CustomStrategy::calculateBatch(const WeightCalculator::ParameterColumns &c, std::size_t count, double *out,
+                                        WeightCalculator::InstructionSet isa) const
+    {
+        isa = std::min(isa, WeightCalculator::getSupportedInstructionSet());
+        if (isa == WeightCalculator::AVX512_KERNEL)
+            calculateBatchAvx512(c, count, out);
+        else if (isa == WeightCalculator::AVX2_KERNEL)
+            calculateBatchAvx2(c, count, out);
+        else
+            calculateBatchScalar(c, 0, count, out);
+    }
+
+    void CustomStrategy::calculateBatchScalar(const WeightCalculator::ParameterColumns &c, std::size_t first,
+                                              std::size_t count, double *out) const
+    {
+        first = programScalar(program, sharedTerms, c, first, count, out, std::make_index_sequence<SCALAR_TILE>());
+        programScalar(program, sharedTerms, c, first, count, out, std::make_index_sequence<1>());
+    }
+
+#ifdef WEIGHT_KERNELS_X86
+    // неполная плитка - по одному вектору, хвост короче вектора - скалярными плитками
+    // в той же функции, без перехода AVX -> SSE
+    KERNEL_TARGET("avx2")
+    void CustomStrategy::calculateBatchAvx2(const WeightCalculator::ParameterColumns &c, std::size_t count,
+                                            double *out) const
+    {
+        std::size_t i = programAvx2(program, sharedTerms, c, 0, count, out, std::make_index_sequence<AVX2_TILE>());
+        i = programAvx2(program, sharedTerms, c, i, count, out, std::make_index_sequence<1>());
+        programScalar(program, sharedTerms, c, i, count, out, std::make_index_sequence<1>());
+    }
+
+    KERNEL_TARGET("avx512f")
+    void CustomStrategy::calculateBatchAvx512(const WeightCalculator::ParameterColumns &c, std::size_t count,
+                                              double *out) const
+    {
+        programAvx512(program, sharedTerms, c, count, out, std::make_index_sequence<AVX512_TILE>());
+    }
+#else
+    void CustomStrategy::calculateBatchAvx2(const WeightCalculator::ParameterColumns &c, std::size_t count,
+                                            double *out) const
+    {
+        calculateBatchScalar(c, 0, count, out);
+    }
+
+    void CustomStrategy::calculateBatchAvx512(const WeightCalculator::ParameterColumns &c, std::size_t count,
+                                              double *out) const
+    {
+        calculateBatchScalar(c, 0, count, out);
+    }
+#endif
+}
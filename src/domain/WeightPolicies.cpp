@@ -0,0 +1,63 @@
+#include "domain/WeightPolicies.h"
+#include <algorithm>
+
+namespace Domain
+{
+    unsigned WeightPolicy::getColumns(WeightCalculator::Strategy strategy)
+    {
+        return dispatch(strategy, [](auto policy) { return columnsOf(policy); });
+    }
+
+    ParameterView::ParameterView(const LinkParameterStore &store, WeightCalculator::Strategy strategy)
+    {
+        const unsigned needed = WeightPolicy::getColumns(strategy);
+        const double **targets[LinkParameterStore::COLUMN_COUNT] = {
+            &columns.latency, &columns.bandwidth, &columns.packet_loss,
+            &columns.utilization, &columns.cost, &columns.reliability};
+        WeightPolicy::PagedColumns::Reader *paged[LinkParameterStore::COLUMN_COUNT] = {
+            &pagedColumns.latency, &pagedColumns.bandwidth, &pagedColumns.packet_loss,
+            &pagedColumns.utilization, &pagedColumns.cost, &pagedColumns.reliability};
+        WeightPolicy::EncodedColumns::Reader *encoded[LinkParameterStore::COLUMN_COUNT] = {
+            &encodedColumns.latency, &encodedColumns.bandwidth, &encodedColumns.packet_loss,
+            &encodedColumns.utilization, &encodedColumns.cost, &encodedColumns.reliability};
+
+        for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+        {
+            auto column = static_cast<LinkParameterStore::Column>(c);
+            const ParameterColumn &values = store.getColumn(column);
+            encoded[c]->column = &values;
+            if (!(needed & WeightPolicy::columnBit(column)))
+                continue;
+            if (values.isMaterialized() && values.getEncoding() != ParameterColumn::FLOAT64)
+                access = ENCODED;
+            else if (const void *data = values.getData())
+                *targets[c] = static_cast<const double *>(data);
+            else if (access == DIRECT)
+                access = PAGED;
+        }
+        if (access != PAGED)
+            return;
+
+        const std::size_t n = store.size();
+        const std::size_t page_count = (n + PagedArray<double>::PAGE_SIZE - 1) >> PagedArray<double>::PAGE_SHIFT;
+        for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+        {
+            auto column = static_cast<LinkParameterStore::Column>(c);
+            if (!(needed & WeightPolicy::columnBit(column)))
+                continue;
+            const ParameterColumn &values = store.getColumn(column);
+            if (values.isMaterialized())
+            {
+                pageTables[c].resize(page_count);
+                for (std::size_t p = 0; p < page_count; ++p)
+                    pageTables[c][p] = values.getPage(p);
+            }
+            else
+            {
+                defaultPages[c].assign(std::min(n, PagedArray<double>::PAGE_SIZE), values.getDefaultValue());
+                pageTables[c].assign(page_count, defaultPages[c].data());
+            }
+            paged[c]->pages = pageTables[c].data();
+        }
+    }
+}
@@ -3,198 +3,183 @@
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <stdexcept>
 
 namespace Infrastructure
 {
-    struct CoordNode
+    namespace
     {
-        int id;
-        double x, y;
-        CoordNode(int nid = 0, double nx = 0, double ny = 0) : id(nid), x(nx), y(ny) {}
-    };
-
-    template <typename Graph>
-    struct CoordHeuristic
-    {
-        const std::vector<CoordNode>& nodes;
-        const std::unordered_map<int, size_t>& node_to_index;
-        size_t goal_index;
-
-        CoordHeuristic(const std::vector<CoordNode>& n,
-                       const std::unordered_map<int, size_t>& map,
-                       int goal_id)
-            : nodes(n), node_to_index(map), goal_index(map.at(goal_id)) {}
-
-        double operator()(size_t u) const
-        {
-            double dx = nodes[u].x - nodes[goal_index].x;
-            double dy = nodes[u].y - nodes[goal_index].y;
-            return std::sqrt(dx*dx + dy*dy);
-        }
-    };
-
-    Domain::PathResult AStarPathFinder::findShortestPath(
-        const Domain::NetworkGraphPtr &graph,
-        int start_id, int end_id)
-    {
-        return findShortestPathStatic(graph, start_id, end_id,
-                                      useWeights, strategy, useCoordinateHeuristic);
-    }
-
-    Domain::PathResult AStarPathFinder::findShortestPathStatic(
-        const Domain::NetworkGraphPtr &graph,
-        int start_id, int end_id,
-        bool useWeights,
-        Domain::WeightCalculator::Strategy strategy,
-        bool useCoordinateHeuristic)
-    {
-        const int RUNS = 100;
-        auto total_duration = std::chrono::nanoseconds::zero();
-        Domain::PathResult result;
-
-        if (!graph->hasNode(start_id) || !graph->hasNode(end_id))
+        // поиск с восстановлением пути и замером времени; WeightMap задает способ получения веса ребра
+        template <typename WeightMap>
+        Domain::PathResult runAStar(const Domain::CompactGraph &graph,
+                                    Domain::CompactGraph::NodeIndex start_idx, Domain::CompactGraph::NodeIndex end_idx,
+                                    WeightMap weight_map, bool useWeights, const Domain::GeometricHeuristic *heuristic)
         {
-            result.success = false;
-            result.errorMessage = "Start or end node not found";
-            return result;
-        }
-
-        auto node_ids = graph->getAllNodeIds();
-        BGLGraph bgl_graph(node_ids.size());
-        std::unordered_map<int, size_t> node_to_index;
-        std::vector<int> index_to_node;
-        index_to_node.reserve(node_ids.size());
+            using Vertex = Domain::CompactGraph::NodeIndex;
 
-        std::vector<CoordNode> coord_nodes;
-        coord_nodes.reserve(node_ids.size());
+            const int RUNS = 100;
+            auto total_duration = std::chrono::nanoseconds::zero();
+            Domain::PathResult result;
 
-        for (size_t i = 0; i < node_ids.size(); ++i)
-        {
-            int nid = node_ids[i];
-            node_to_index[nid] = i;
-            index_to_node.push_back(nid);
+            const size_t n = graph.getNodeCount();
+            // эвристика, не прошедшая проверку при построении, дает нули - тогда поиск без нее
+            if (heuristic && !heuristic->isUsable())
+                heuristic = nullptr;
 
-            double x = static_cast<double>(nid);
-            double y = (nid >= 1000) ? 10000.0 + static_cast<double>(nid % 1000) : 0.0;
-            coord_nodes.emplace_back(nid, x, y);
-        }
+            std::vector<double> distances(n, std::numeric_limits<double>::infinity());
+            std::vector<Vertex> predecessors(n);
+            for (size_t i = 0; i < n; ++i)
+                predecessors[i] = static_cast<Vertex>(i);
+            // расстояния, предки + внутренние структуры BGL: оценки f, цвета, индекс в куче, куча;
+            // координаты общие для всех запросов и сюда не входят
+            result.scratchBytes = n * (sizeof(double) + sizeof(Vertex)) +
+                                  n * (sizeof(double) + sizeof(boost::default_color_type) + sizeof(size_t) + sizeof(Vertex));
 
-        for (int node_id : node_ids)
-        {
-            size_t u = node_to_index[node_id];
-            for (int v_id : graph->getNeighbors(node_id))
+            auto run_search = [&](std::vector<double> &dist, std::vector<Vertex> &pred, std::size_t &settled)
             {
-                double weight = 1.0;
-                if (useWeights)
+                auto visitor = AStarGoalVisitor<Vertex>(end_idx, settled);
+                if (heuristic)
                 {
-                    try { weight = graph->getEdgeWeight(node_id, v_id, strategy); }
-                    catch (...) { weight = 1.0; }
+                    GeometricAStarHeuristic<Domain::CompactGraph> estimate(*heuristic, end_idx);
+                    boost::astar_search(graph, start_idx, estimate,
+                                        boost::predecessor_map(&pred[0])
+                                            .distance_map(&dist[0])
+                                            .distance_inf(std::numeric_limits<double>::infinity())
+                                            .weight_map(weight_map)
+                                            .visitor(visitor));
                 }
-                boost::add_edge(u, node_to_index[v_id], weight, bgl_graph);
-            }
-        }
-
-        size_t n = index_to_node.size();
-        size_t start_idx = node_to_index[start_id];
-        size_t end_idx = node_to_index[end_id];
-
-        std::vector<double> distances(n, std::numeric_limits<double>::infinity());
-        std::vector<BGLGraph::vertex_descriptor> predecessors(n);
-        for (size_t i = 0; i < n; ++i)
-            predecessors[i] = i;
+                else
+                {
+                    AStarHeuristic<Domain::CompactGraph, double> zero(end_idx);
+                    boost::astar_search(graph, start_idx, zero,
+                                        boost::predecessor_map(&pred[0])
+                                            .distance_map(&dist[0])
+                                            .distance_inf(std::numeric_limits<double>::infinity())
+                                            .weight_map(weight_map)
+                                            .visitor(visitor));
+                }
+            };
 
-        try
-        {
-            if (useCoordinateHeuristic)
+            try
             {
-                CoordHeuristic<BGLGraph> heuristic(coord_nodes, node_to_index, end_id);
-                auto visitor = AStarGoalVisitor<BGLGraph::vertex_descriptor>(end_idx);
-                boost::astar_search(bgl_graph, start_idx, heuristic,
-                                    boost::predecessor_map(&predecessors[0])
-                                        .distance_map(&distances[0])
-                                        .visitor(visitor));
+                run_search(distances, predecessors, result.settledNodes);
             }
-            else
+            catch (const found_goal&) {}
+            catch (const std::exception& e)
             {
-                AStarHeuristic<BGLGraph, double> heuristic(end_idx);
-                auto visitor = AStarGoalVisitor<BGLGraph::vertex_descriptor>(end_idx);
-                boost::astar_search(bgl_graph, start_idx, heuristic,
-                                    boost::predecessor_map(&predecessors[0])
-                                        .distance_map(&distances[0])
-                                        .visitor(visitor));
+                result.success = false;
+                result.errorMessage = "BGL A* error: " + std::string(e.what());
+                return result;
             }
-        }
-        catch (const found_goal&) {}
-        catch (const std::exception& e)
-        {
-            result.success = false;
-            result.errorMessage = "BGL A* error: " + std::string(e.what());
-            return result;
-        }
 
-        if (distances[end_idx] == std::numeric_limits<double>::infinity())
-        {
-            result.success = false;
-            result.errorMessage = "No path found";
-            return result;
-        }
-
-        std::vector<int> rev_path;
-        for (size_t v = end_idx; v != start_idx; v = predecessors[v])
-        {
-            if (predecessors[v] == v)
+            if (distances[end_idx] == std::numeric_limits<double>::infinity())
             {
                 result.success = false;
-                result.errorMessage = "Path reconstruction failed";
+                result.errorMessage = "No path found";
                 return result;
             }
-            rev_path.push_back(index_to_node[v]);
-        }
-        rev_path.push_back(index_to_node[start_idx]);
-        std::reverse(rev_path.begin(), rev_path.end());
-
-        result.success = true;
-        result.pathNodes = std::move(rev_path);
-        result.totalCost = distances[end_idx];
-        result.algorithmName = useWeights ? "BGL A* (Multi-Param + Coord)" : "BGL A* (Uniform + Coord)";
 
-        for (int run = 0; run < RUNS; ++run)
-        {
-            auto startTime = std::chrono::high_resolution_clock::now();
-
-            std::vector<double> temp_distances(n, std::numeric_limits<double>::infinity());
-            std::vector<BGLGraph::vertex_descriptor> temp_predecessors(n);
-            for (size_t i = 0; i < n; ++i)
-                temp_predecessors[i] = i;
-
-            try
+            std::vector<Domain::NodeId> rev_path;
+            for (Vertex v = end_idx; v != start_idx; v = predecessors[v])
             {
-                if (useCoordinateHeuristic)
+                if (predecessors[v] == v)
                 {
-                    CoordHeuristic<BGLGraph> heuristic(coord_nodes, node_to_index, end_id);
-                    auto visitor = AStarGoalVisitor<BGLGraph::vertex_descriptor>(end_idx);
-                    boost::astar_search(bgl_graph, start_idx, heuristic,
-                                        boost::predecessor_map(&temp_predecessors[0])
-                                            .distance_map(&temp_distances[0])
-                                            .visitor(visitor));
+                    result.success = false;
+                    result.errorMessage = "Path reconstruction failed";
+                    return result;
                 }
-                else
+                rev_path.push_back(graph.getNodeId(v));
+            }
+            rev_path.push_back(graph.getNodeId(start_idx));
+            std::reverse(rev_path.begin(), rev_path.end());
+
+            result.success = true;
+            result.pathNodes = std::move(rev_path);
+            result.totalCost = distances[end_idx];
+            result.algorithmName = std::string(useWeights ? "BGL A* (Multi-Param" : "BGL A* (Uniform") +
+                                   (heuristic ? " + Coord)" : ")");
+
+            for (int run = 0; run < RUNS; ++run)
+            {
+                auto startTime = std::chrono::high_resolution_clock::now();
+
+                std::vector<double> temp_distances(n, std::numeric_limits<double>::infinity());
+                std::vector<Vertex> temp_predecessors(n);
+                for (size_t i = 0; i < n; ++i)
+                    temp_predecessors[i] = static_cast<Vertex>(i);
+                std::size_t settled = 0;
+
+                try
                 {
-                    AStarHeuristic<BGLGraph, double> heuristic(end_idx);
-                    auto visitor = AStarGoalVisitor<BGLGraph::vertex_descriptor>(end_idx);
-                    boost::astar_search(bgl_graph, start_idx, heuristic,
-                                        boost::predecessor_map(&temp_predecessors[0])
-                                            .distance_map(&temp_distances[0])
-                                            .visitor(visitor));
+                    run_search(temp_distances, temp_predecessors, settled);
                 }
+                catch (const found_goal&) {}
+
+                auto endTime = std::chrono::high_resolution_clock::now();
+                total_duration += (endTime - startTime);
             }
-            catch (...) {}
 
-            auto endTime = std::chrono::high_resolution_clock::now();
-            total_duration += (endTime - startTime);
+            result.executionTime = (total_duration.count() / RUNS) / 1000000.0;
+            return result;
+        }
+    }
+
+    Domain::PathResult AStarPathFinder::findShortestPath(
+        const Domain::NetworkGraphPtr &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id)
+    {
+        return findShortestPathStatic(graph, start_id, end_id,
+                                      useWeights, strategy, useCoordinateHeuristic);
+    }
+
+    Domain::PathResult AStarPathFinder::findShortestPath(
+        const Domain::CompactGraph &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id)
+    {
+        // у снимка без графа нет координат
+        return findShortestPathStatic(graph, start_id, end_id, useWeights, strategy);
+    }
+
+    Domain::PathResult AStarPathFinder::findShortestPathStatic(
+        const Domain::NetworkGraphPtr &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id,
+        bool useWeights,
+        Domain::WeightCalculator::Strategy strategy,
+        bool useCoordinateHeuristic)
+    {
+        const auto compact = graph->getCompactGraph();
+        Domain::GeometricHeuristicPtr heuristic;
+        if (useCoordinateHeuristic)
+            heuristic = graph->getGeometricHeuristic(
+                compact, useWeights ? strategy : Domain::WeightCalculator::UNIFORM_WEIGHTS);
+        return findShortestPathStatic(*compact, start_id, end_id, useWeights, strategy, heuristic.get());
+    }
+
+    Domain::PathResult AStarPathFinder::findShortestPathStatic(
+        const Domain::CompactGraph &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id,
+        bool useWeights,
+        Domain::WeightCalculator::Strategy strategy,
+        const Domain::GeometricHeuristic *heuristic,
+        WeightEvaluation evaluation)
+    {
+        using Vertex = Domain::CompactGraph::NodeIndex;
+
+        const Vertex start_idx = graph.findIndex(start_id);
+        const Vertex end_idx = graph.findIndex(end_id);
+        if (start_idx == Domain::CompactGraph::INVALID_NODE || end_idx == Domain::CompactGraph::INVALID_NODE)
+        {
+            Domain::PathResult result;
+            result.success = false;
+            result.errorMessage = "Start or end node not found";
+            return result;
         }
 
-        result.executionTime = (total_duration.count() / RUNS) / 1000000.0;
-        return result;
+        const auto effective = useWeights ? strategy : Domain::WeightCalculator::UNIFORM_WEIGHTS;
+        if (heuristic && (heuristic->getNodeCount() != graph.getNodeCount() || heuristic->getStrategy() != effective))
+            throw std::invalid_argument("A* heuristic was built for another graph snapshot or strategy");
+        return withWeightMap(graph, effective, evaluation, [&](auto weight_map) {
+            return runAStar(graph, start_idx, end_idx, weight_map, useWeights, heuristic);
+        });
     }
 }
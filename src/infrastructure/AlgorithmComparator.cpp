@@ -2,12 +2,15 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <set>
 
 namespace Infrastructure
 {
     std::vector<AlgorithmComparison> AlgorithmComparator::compareAlgorithms(
         const Domain::NetworkGraphPtr &graph,
-        const std::vector<std::pair<int, int>> &test_routes,
+        const std::vector<Domain::NodePair> &test_routes,
         const Config::StrategySettings &strategies)
     {
         std::vector<AlgorithmComparison> results;
@@ -40,6 +43,7 @@ namespace Infrastructure
             try
             {
                 BGLShortestPath bglUniform(false, strategies.exact_uniform);
+                MemoryProbe probe;
                 auto result = bglUniform.findShortestPath(graph, start, end);
 
                 AlgorithmComparison comp;
@@ -49,13 +53,17 @@ namespace Infrastructure
                 comp.pathCost = result.totalCost;
                 comp.pathLength = result.pathNodes.size();
                 comp.success = result.success;
+                comp.scratchMemory = result.scratchBytes;
+                comp.peakMemory = probe.getPeakIncrease();
                 results.push_back(comp);
 
                 std::cout << "  " << comp.algorithmName << ": "
                           << (comp.success ? "OK" : "FAIL")
                           << " cost=" << comp.pathCost
                           << " length=" << comp.pathLength
-                          << " time=" << comp.executionTime << "ms\n";
+                          << " time=" << comp.executionTime << "ms"
+                          << " scratch=" << comp.scratchMemory / 1024.0 << "KB"
+                          << " peak=" << comp.peakMemory / 1024.0 << "KB\n";
             }
             catch (const std::exception &e)
             {
@@ -72,6 +80,7 @@ namespace Infrastructure
             try
             {
                 BGLShortestPath bglMultiParam(true, strategies.exact_multi_param);
+                MemoryProbe probe;
                 auto result = bglMultiParam.findShortestPath(graph, start, end);
 
                 AlgorithmComparison comp;
@@ -81,13 +90,17 @@ namespace Infrastructure
                 comp.pathCost = result.totalCost;
                 comp.pathLength = result.pathNodes.size();
                 comp.success = result.success;
+                comp.scratchMemory = result.scratchBytes;
+                comp.peakMemory = probe.getPeakIncrease();
                 results.push_back(comp);
 
                 std::cout << "  " << comp.algorithmName << ": "
                           << (comp.success ? "OK" : "FAIL")
                           << " cost=" << comp.pathCost
                           << " length=" << comp.pathLength
-                          << " time=" << comp.executionTime << "ms\n";
+                          << " time=" << comp.executionTime << "ms"
+                          << " scratch=" << comp.scratchMemory / 1024.0 << "KB"
+                          << " peak=" << comp.peakMemory / 1024.0 << "KB\n";
             }
             catch (const std::exception &e)
             {
@@ -104,6 +117,7 @@ namespace Infrastructure
             try
             {
                 AStarPathFinder astarUniform(false, strategies.exact_uniform);
+                MemoryProbe probe;
                 auto result = astarUniform.findShortestPath(graph, start, end);
 
                 AlgorithmComparison comp;
@@ -113,13 +127,18 @@ namespace Infrastructure
                 comp.pathCost = result.totalCost;
                 comp.pathLength = result.pathNodes.size();
                 comp.success = result.success;
+                comp.scratchMemory = result.scratchBytes;
+                comp.peakMemory = probe.getPeakIncrease();
                 results.push_back(comp);
 
                 std::cout << "  " << comp.algorithmName << ": "
                           << (comp.success ? "OK" : "FAIL")
                           << " cost=" << comp.pathCost
                           << " length=" << comp.pathLength
-                          << " time=" << comp.executionTime << "ms\n";
+                          << " time=" << comp.executionTime << "ms"
+                          << " scratch=" << comp.scratchMemory / 1024.0 << "KB"
+                          << " peak=" << comp.peakMemory / 1024.0 << "KB"
+                          << " settled=" << result.settledNodes << "\n";
             }
             catch (const std::exception &e)
             {
@@ -136,6 +155,7 @@ namespace Infrastructure
             try
             {
                 AStarPathFinder astarMultiParam(true, strategies.exact_multi_param);
+                MemoryProbe probe;
                 auto result = astarMultiParam.findShortestPath(graph, start, end);
 
                 AlgorithmComparison comp;
@@ -145,13 +165,26 @@ namespace Infrastructure
                 comp.pathCost = result.totalCost;
                 comp.pathLength = result.pathNodes.size();
                 comp.success = result.success;
+                comp.scratchMemory = result.scratchBytes;
+                comp.peakMemory = probe.getPeakIncrease();
                 results.push_back(comp);
 
                 std::cout << "  " << comp.algorithmName << ": "
                           << (comp.success ? "OK" : "FAIL")
                           << " cost=" << comp.pathCost
                           << " length=" << comp.pathLength
-                          << " time=" << comp.executionTime << "ms\n";
+                          << " time=" << comp.executionTime << "ms"
+                          << " scratch=" << comp.scratchMemory / 1024.0 << "KB"
+                          << " peak=" << comp.peakMemory / 1024.0 << "KB"
+                          << " settled=" << result.settledNodes;
+                // с координатами - сколько вершин извлек бы тот же поиск с нулевой оценкой (как Дейкстра)
+                if (graph->getCoordinates())
+                {
+                    astarMultiParam.enableCoordinateHeuristic(false);
+                    std::cout << " (без координат " << astarMultiParam.findShortestPath(graph, start, end).settledNodes
+                              << ")";
+                }
+                std::cout << "\n";
             }
             catch (const std::exception &e)
             {
@@ -167,12 +200,13 @@ namespace Infrastructure
             // эвристические алгоритмы
             std::cout << "\nЭВРИСТИЧЕСКИЕ АЛГОРИТМЫ:\n";
 
-            std::vector<std::pair<int, int>> single_demand = {{start, end}};
+            std::vector<Domain::NodePair> single_demand = {{start, end}};
 
             // генетический алгоритм
             try
             {
                 GeneticAlgorithm geneticAlgo(50, 100, 0.15, 0.8, strategies.genetic);
+                MemoryProbe probe;
                 auto result = geneticAlgo.optimize(graph, single_demand);
 
                 AlgorithmComparison comp;
@@ -183,13 +217,17 @@ namespace Infrastructure
                 comp.pathCost = result.objective;
                 comp.pathLength = result.path.size();
                 comp.success = result.success;
+                comp.scratchMemory = result.scratchBytes;
+                comp.peakMemory = probe.getPeakIncrease();
                 results.push_back(comp);
 
                 std::cout << "  " << comp.algorithmName << ": "
                           << (comp.success ? "OK" : "FAIL")
                           << " cost=" << comp.pathCost
                           << " length=" << comp.pathLength
-                          << " time=" << comp.executionTime << "ms\n";
+                          << " time=" << comp.executionTime << "ms"
+                          << " scratch=" << comp.scratchMemory / 1024.0 << "KB"
+                          << " peak=" << comp.peakMemory / 1024.0 << "KB\n";
             }
             catch (const std::exception &e)
             {
@@ -206,6 +244,7 @@ namespace Infrastructure
             try
             {
                 AntColonyOptimizer antAlgo(50, 100, 1.0, 2.0, 0.5, 100.0, strategies.ant_colony);
+                MemoryProbe probe;
                 auto result = antAlgo.optimize(graph, single_demand);
 
                 AlgorithmComparison comp;
@@ -216,13 +255,17 @@ namespace Infrastructure
                 comp.pathCost = result.objective;
                 comp.pathLength = result.path.size();
                 comp.success = result.success;
+                comp.scratchMemory = result.scratchBytes;
+                comp.peakMemory = probe.getPeakIncrease();
                 results.push_back(comp);
 
                 std::cout << "  " << comp.algorithmName << ": "
                           << (comp.success ? "OK" : "FAIL")
                           << " cost=" << comp.pathCost
                           << " length=" << comp.pathLength
-                          << " time=" << comp.executionTime << "ms\n";
+                          << " time=" << comp.executionTime << "ms"
+                          << " scratch=" << comp.scratchMemory / 1024.0 << "KB"
+                          << " peak=" << comp.peakMemory / 1024.0 << "KB\n";
             }
             catch (const std::exception &e)
             {
@@ -253,8 +296,10 @@ namespace Infrastructure
                   << std::setw(10) << "Success"
                   << std::setw(15) << "Cost"
                   << std::setw(8) << "Length"
-                  << std::setw(12) << "Time(ms)" << "\n";
-        std::cout << std::string(85, '-') << "\n";
+                  << std::setw(12) << "Time(ms)"
+                  << std::setw(14) << "Scratch(KB)"
+                  << std::setw(12) << "Peak(KB)" << "\n";
+        std::cout << std::string(111, '-') << "\n";
 
         for (const auto &result : results)
         {
@@ -265,7 +310,9 @@ namespace Infrastructure
                           << std::setw(10) << (result.success ? "OK" : "FAIL")
                           << std::setw(15) << std::fixed << std::setprecision(6) << result.pathCost
                           << std::setw(8) << result.pathLength
-                          << std::setw(12) << std::fixed << std::setprecision(3) << result.executionTime << "\n";
+                          << std::setw(12) << std::fixed << std::setprecision(3) << result.executionTime
+                          << std::setw(14) << std::setprecision(1) << result.scratchMemory / 1024.0
+                          << std::setw(12) << result.peakMemory / 1024.0 << "\n";
             }
         }
 
@@ -276,8 +323,10 @@ namespace Infrastructure
                   << std::setw(10) << "Success"
                   << std::setw(15) << "Cost"
                   << std::setw(8) << "Length"
-                  << std::setw(12) << "Time(ms)" << "\n";
-        std::cout << std::string(90, '-') << "\n";
+                  << std::setw(12) << "Time(ms)"
+                  << std::setw(14) << "Scratch(KB)"
+                  << std::setw(12) << "Peak(KB)" << "\n";
+        std::cout << std::string(116, '-') << "\n";
 
         for (const auto &result : results)
         {
@@ -288,7 +337,9 @@ namespace Infrastructure
                           << std::setw(10) << (result.success ? "OK" : "FAIL")
                           << std::setw(15) << std::fixed << std::setprecision(6) << result.pathCost
                           << std::setw(8) << result.pathLength
-                          << std::setw(12) << std::fixed << std::setprecision(3) << result.executionTime << "\n";
+                          << std::setw(12) << std::fixed << std::setprecision(3) << result.executionTime
+                          << std::setw(14) << std::setprecision(1) << result.scratchMemory / 1024.0
+                          << std::setw(12) << result.peakMemory / 1024.0 << "\n";
             }
         }
 
@@ -318,4 +369,361 @@ namespace Infrastructure
         std::cout << "Эвристические алгоритмы: " << heuristicSuccess << "/" << heuristicCount << " успешных ("
                   << (heuristicSuccess * 100.0 / heuristicCount) << "%)\n";
     }
-}
\ No newline at end of file
+
+    std::vector<OrderingBenchmark> AlgorithmComparator::benchmarkOrderings(
+        const Domain::NetworkGraphPtr &graph,
+        const std::vector<Domain::NodePair> &test_routes)
+    {
+        std::vector<OrderingBenchmark> results;
+        const auto original = graph->getNodeOrdering();
+        BoostFlowSolver flowSolver;
+
+        for (auto method : Domain::GraphOrdering::getAllMethods())
+        {
+            OrderingBenchmark bench{};
+            bench.orderingName = Domain::GraphOrdering::getMethodName(method);
+            bench.success = true;
+
+            try
+            {
+                // время построения замеряется на свежем CSR, а не на кэше графа
+                auto buildStart = std::chrono::high_resolution_clock::now();
+                auto compact = Domain::CompactGraph::build(*graph);
+                if (method != Domain::GraphOrdering::ID_ORDER)
+                    compact = Domain::CompactGraph::permute(*compact, Domain::GraphOrdering::compute(*compact, method));
+                auto buildEnd = std::chrono::high_resolution_clock::now();
+                bench.buildTime = std::chrono::duration<double, std::milli>(buildEnd - buildStart).count();
+
+                // решатель потока берет CSR из графа
+                graph->setNodeOrdering(method);
+
+                auto locality = Domain::GraphOrdering::measure(*compact);
+                bench.averageGap = locality.averageGap;
+                bench.crossLineShare = locality.crossLineShare;
+
+                for (const auto &[start, end] : test_routes)
+                {
+                    if (start == end)
+                        continue;
+                    auto dijkstra = BGLShortestPath::findShortestPathStatic(*compact, start, end, true);
+                    auto astar = AStarPathFinder::findShortestPathStatic(*compact, start, end, true);
+                    auto flow = flowSolver.solveMaxFlow(graph, start, end);
+                    bench.dijkstraTime += dijkstra.executionTime;
+                    bench.astarTime += astar.executionTime;
+                    bench.flowTime += flow.totalCost;
+                    bench.success = bench.success && dijkstra.success && flow.success;
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cout << "  " << bench.orderingName << ": FAIL Error: " << e.what() << "\n";
+                bench.success = false;
+            }
+            results.push_back(bench);
+        }
+
+        graph->setNodeOrdering(original);
+        return results;
+    }
+
+    void AlgorithmComparator::printOrderingTable(const std::vector<OrderingBenchmark> &results)
+    {
+        std::cout << "\n"
+                  << std::string(100, '=') << "\n";
+        std::cout << "ВЛИЯНИЕ ПОРЯДКА ВЕРШИН НА ЛОКАЛЬНОСТЬ\n";
+        std::cout << std::string(100, '=') << "\n";
+        std::cout << std::left
+                  << std::setw(24) << "Ordering"
+                  << std::setw(10) << "Success"
+                  << std::setw(12) << "Build(ms)"
+                  << std::setw(12) << "Avg gap"
+                  << std::setw(12) << "Cross-line"
+                  << std::setw(14) << "Dijkstra(ms)"
+                  << std::setw(12) << "A*(ms)"
+                  << std::setw(12) << "Flow(ms)" << "\n";
+        std::cout << std::string(108, '-') << "\n";
+
+        for (const auto &result : results)
+        {
+            std::cout << std::left
+                      << std::setw(24) << result.orderingName
+                      << std::setw(10) << (result.success ? "OK" : "FAIL")
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << result.buildTime
+                      << std::setw(12) << std::setprecision(1) << result.averageGap
+                      << std::setw(12) << std::setprecision(3) << result.crossLineShare
+                      << std::setw(14) << result.dijkstraTime
+                      << std::setw(12) << result.astarTime
+                      << std::setw(12) << result.flowTime << "\n";
+        }
+        std::cout << "Cross-line - доля ребер, у которых расстояния концов лежат в разных 64-байтных кэш-линиях\n";
+    }
+
+    std::vector<WeightKernelBenchmark> AlgorithmComparator::benchmarkWeightKernels(const Domain::NetworkGraphPtr &graph)
+    {
+        using Calculator = Domain::WeightCalculator;
+        std::vector<WeightKernelBenchmark> results;
+        const auto &store = graph->getParameterStore();
+        const std::size_t edges = std::max<std::size_t>(store.size(), 1);
+        // повторы, чтобы на малых графах замер не упирался в разрешение таймера (~16M весов на замер)
+        const std::size_t repeats = std::max<std::size_t>(1, (std::size_t(1) << 24) / edges);
+
+        const auto original = Calculator::getInstructionSet();
+        const Calculator::InstructionSet all[] = {Calculator::SCALAR_KERNEL, Calculator::AVX2_KERNEL, Calculator::AVX512_KERNEL};
+        std::vector<double> scalar, weights;
+
+        // встроенные стратегии с векторными ядрами и все загруженные пользовательские
+        std::vector<Calculator::Strategy> strategies = {Calculator::BALANCE_LOAD, Calculator::ADAPTIVE_WEIGHTS,
+                                                        Calculator::MAXIMIZE_BANDWIDTH};
+        for (auto strategy : Calculator::getAllStrategies())
+            if (Calculator::getCustomStrategy(strategy))
+                strategies.push_back(strategy);
+
+        for (auto strategy : strategies)
+        {
+            for (auto isa : all)
+            {
+                if (isa > Calculator::getSupportedInstructionSet())
+                    break;
+                Calculator::setInstructionSet(isa);
+
+                auto start = std::chrono::high_resolution_clock::now();
+                for (std::size_t r = 0; r < repeats; ++r)
+                    Calculator::calculateWeights(store, strategy, weights);
+                auto end = std::chrono::high_resolution_clock::now();
+
+                if (isa == Calculator::SCALAR_KERNEL)
+                    scalar = weights;
+
+                WeightKernelBenchmark bench;
+                bench.strategyName = Calculator::getStrategyName(strategy);
+                bench.instructionSet = Calculator::getInstructionSetName(isa);
+                bench.time = std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+                bench.nsPerEdge = bench.time * 1e6 / edges;
+                bench.matchesScalar = std::memcmp(scalar.data(), weights.data(), weights.size() * sizeof(double)) == 0;
+                results.push_back(bench);
+            }
+        }
+
+        Calculator::setInstructionSet(original);
+        return results;
+    }
+
+    void AlgorithmComparator::printWeightKernelTable(const std::vector<WeightKernelBenchmark> &results)
+    {
+        std::cout << "\n"
+                  << std::string(100, '=') << "\n";
+        std::cout << "ПАКЕТНЫЙ РАСЧЕТ ВЕСОВ (набор по умолчанию: "
+                  << Domain::WeightCalculator::getInstructionSetName(Domain::WeightCalculator::getInstructionSet()) << ")\n";
+        std::cout << std::string(100, '=') << "\n";
+        std::cout << std::left
+                  << std::setw(24) << "Strategy"
+                  << std::setw(12) << "ISA"
+                  << std::setw(12) << "Time(ms)"
+                  << std::setw(12) << "ns/edge"
+                  << std::setw(16) << "10M edges(ms)"
+                  << std::setw(10) << "Exact" << "\n";
+        std::cout << std::string(86, '-') << "\n";
+
+        for (const auto &result : results)
+        {
+            std::cout << std::left
+                      << std::setw(24) << result.strategyName
+                      << std::setw(12) << result.instructionSet
+                      << std::fixed << std::setprecision(4)
+                      << std::setw(12) << result.time
+                      << std::setw(12) << std::setprecision(2) << result.nsPerEdge
+                      << std::setw(16) << std::setprecision(1) << result.nsPerEdge * 10.0
+                      << std::setw(10) << (result.matchesScalar ? "OK" : "DIFF") << "\n";
+        }
+        std::cout << "10M edges - оценка по времени на ребро; на больших графах упирается в пропускную способность памяти\n";
+    }
+
+    std::vector<WeightEvaluationBenchmark> AlgorithmComparator::benchmarkWeightEvaluation(
+        const Domain::NetworkGraphPtr &graph,
+        const std::vector<Domain::NodePair> &test_routes)
+    {
+        std::vector<WeightEvaluationBenchmark> results;
+        auto compact = graph->getCompactGraph();
+        // снимок после обновления одного ребра тем же значением: страница столбцов заменена,
+        // столбцы не лежат подряд, и Inline читает значения по таблице страниц
+        auto patched = compact->getEdgeCount() == 0
+                           ? compact
+                           : Domain::CompactGraph::withParameters(*compact, {{0, compact->getEdgeParameters(0)}});
+
+        for (auto strategy : Domain::WeightCalculator::getAllStrategies())
+        {
+            WeightEvaluationBenchmark bench{};
+            bench.strategyName = Domain::WeightCalculator::getStrategyName(strategy);
+            bench.costsMatch = true;
+            // массив весов строится заранее: в режиме по умолчанию замеряется только поиск
+            compact->getEdgeWeights(strategy);
+
+            for (const auto &[start, end] : test_routes)
+            {
+                if (start == end)
+                    continue;
+                double cost[3] = {0.0, 0.0, 0.0};
+                double *times[3] = {&bench.precomputedTime, &bench.inlineTime, &bench.runtimeSwitchTime};
+                const WeightEvaluation modes[3] = {PRECOMPUTED_WEIGHTS, INLINE_POLICY, RUNTIME_SWITCH};
+                for (int m = 0; m < 3; ++m)
+                {
+                    auto dijkstra = BGLShortestPath::findShortestPathStatic(*compact, start, end, true, strategy, modes[m]);
+                    auto astar = AStarPathFinder::findShortestPathStatic(*compact, start, end, true, strategy, nullptr, modes[m]);
+                    *times[m] += dijkstra.executionTime + astar.executionTime;
+                    cost[m] = dijkstra.totalCost + astar.totalCost;
+                }
+                auto dijkstra = BGLShortestPath::findShortestPathStatic(*patched, start, end, true, strategy, INLINE_POLICY);
+                auto astar = AStarPathFinder::findShortestPathStatic(*patched, start, end, true, strategy, nullptr, INLINE_POLICY);
+                bench.inlinePatchedTime += dijkstra.executionTime + astar.executionTime;
+                bench.costsMatch = bench.costsMatch && cost[0] == cost[1] && cost[0] == cost[2] &&
+                                   cost[0] == dijkstra.totalCost + astar.totalCost;
+            }
+            results.push_back(bench);
+        }
+        return results;
+    }
+
+    void AlgorithmComparator::printWeightEvaluationTable(const std::vector<WeightEvaluationBenchmark> &results)
+    {
+        std::cout << "\n"
+                  << std::string(100, '=') << "\n";
+        std::cout << "СПОСОБ ПОЛУЧЕНИЯ ВЕСА РЕБРА В DIJKSTRA И A*\n";
+        std::cout << std::string(100, '=') << "\n";
+        std::cout << std::left
+                  << std::setw(24) << "Strategy"
+                  << std::setw(18) << "Precomputed(ms)"
+                  << std::setw(18) << "Inline(ms)"
+                  << std::setw(18) << "Patched(ms)"
+                  << std::setw(18) << "Switch(ms)"
+                  << std::setw(16) << "Switch/Inline"
+                  << std::setw(10) << "Costs" << "\n";
+        std::cout << std::string(122, '-') << "\n";
+
+        for (const auto &result : results)
+        {
+            std::cout << std::left
+                      << std::setw(24) << result.strategyName
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(18) << result.precomputedTime
+                      << std::setw(18) << result.inlineTime
+                      << std::setw(18) << result.inlinePatchedTime
+                      << std::setw(18) << result.runtimeSwitchTime
+                      << std::setw(16) << std::setprecision(2)
+                      << (result.inlineTime > 0.0 ? result.runtimeSwitchTime / result.inlineTime : 0.0)
+                      << std::setw(10) << (result.costsMatch ? "OK" : "DIFF") << "\n";
+        }
+        std::cout << "Inline - вес из столбцов параметров без массива весов, стратегия выбрана один раз на запрос\n"
+                  << "(пользовательские стратегии - программа слагаемых выполняется на каждом ребре)\n"
+                  << "Patched - Inline на снимке после обновления ребра: столбцы не лежат подряд и не декодируются\n"
+                  << "в копию, значения читаются по таблице страниц (см. ParameterView)\n";
+    }
+
+    std::vector<ParetoBenchmark> AlgorithmComparator::benchmarkParetoSearch(
+        const Domain::NetworkGraphPtr &graph,
+        const std::vector<Domain::NodePair> &test_routes)
+    {
+        std::vector<ParetoBenchmark> results;
+        auto compact = graph->getCompactGraph();
+        const ParetoPathFinder::Settings settings;
+
+        for (const auto &[start, end] : test_routes)
+        {
+            if (start == end)
+                continue;
+
+            ParetoBenchmark bench{};
+            bench.route = {start, end};
+            auto pareto = ParetoPathFinder::findParetoFrontStatic(*compact, start, end, settings);
+            bench.paretoTime = pareto.executionTime;
+            bench.labelsCreated = pareto.labelsCreated;
+            bench.truncated = pareto.truncated;
+
+            // базовый вариант: отдельный поиск на каждую стратегию
+            std::set<std::vector<Domain::NodeId>> strategy_paths;
+            for (auto strategy : Domain::WeightCalculator::getAllStrategies())
+            {
+                auto path = BGLShortestPath::findShortestPathStatic(*compact, start, end, true, strategy);
+                bench.strategiesTime += path.executionTime;
+                if (path.success)
+                    strategy_paths.insert(path.pathNodes);
+            }
+            bench.strategyRoutes = strategy_paths.size();
+
+            for (const auto &path : strategy_paths)
+            {
+                RouteObjectives objectives;
+                if (!ParetoPathFinder::evaluateRoute(*compact, path, objectives))
+                    continue;
+                bool covered = std::any_of(pareto.routes.begin(), pareto.routes.end(), [&](const ParetoRoute &route) {
+                    return route.objectives.dominates(objectives, settings.epsilon);
+                });
+                bench.coveredRoutes += covered ? 1 : 0;
+            }
+            for (const auto &route : pareto.routes)
+                bench.newRoutes += strategy_paths.count(route.pathNodes) ? 0 : 1;
+
+            bench.front = std::move(pareto.routes);
+            results.push_back(std::move(bench));
+        }
+        return results;
+    }
+
+    void AlgorithmComparator::printParetoTable(const std::vector<ParetoBenchmark> &results)
+    {
+        std::cout << "\n"
+                  << std::string(100, '=') << "\n";
+        std::cout << "ФРОНТ ПАРЕТО (задержка, стоимость, 1/пропускная способность, надежность) ПРОТИВ ПОИСКА ПО КАЖДОЙ СТРАТЕГИИ\n";
+        std::cout << std::string(100, '=') << "\n";
+        std::cout << std::left
+                  << std::setw(16) << "Route"
+                  << std::setw(12) << "Pareto(ms)"
+                  << std::setw(8) << "Front"
+                  << std::setw(10) << "Labels"
+                  << std::setw(18) << "Strategies(ms)"
+                  << std::setw(12) << "Distinct"
+                  << std::setw(10) << "Covered"
+                  << std::setw(8) << "New" << "\n";
+        std::cout << std::string(94, '-') << "\n";
+
+        for (const auto &result : results)
+        {
+            std::cout << std::left
+                      << std::setw(16) << (std::to_string(result.route.first) + "->" + std::to_string(result.route.second))
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(12) << result.paretoTime
+                      << std::setw(8) << (std::to_string(result.front.size()) + (result.truncated ? "*" : ""))
+                      << std::setw(10) << result.labelsCreated
+                      << std::setw(18) << result.strategiesTime
+                      << std::setw(12) << result.strategyRoutes
+                      << std::setw(10) << (std::to_string(result.coveredRoutes) + "/" + std::to_string(result.strategyRoutes))
+                      << std::setw(8) << result.newRoutes << "\n";
+        }
+        std::cout << "Covered - маршруты стратегий, доминируемые фронтом; New - маршруты фронта, не найденные стратегиями; "
+                     "* - фронт урезан ограничением меток\n";
+
+        if (results.empty() || results.front().front.empty())
+            return;
+        const auto &first = results.front();
+        std::cout << "\nФронт маршрута " << first.route.first << "->" << first.route.second << ":\n";
+        std::cout << std::left
+                  << std::setw(12) << "Latency"
+                  << std::setw(12) << "Cost"
+                  << std::setw(14) << "Bandwidth"
+                  << std::setw(14) << "Reliability"
+                  << std::setw(8) << "Hops" << "\n";
+        const std::size_t shown = std::min<std::size_t>(first.front.size(), 10);
+        for (std::size_t i = 0; i < shown; ++i)
+        {
+            const auto &objectives = first.front[i].objectives;
+            std::cout << std::left << std::fixed << std::setprecision(3)
+                      << std::setw(12) << objectives.values[RouteObjectives::LATENCY]
+                      << std::setw(12) << objectives.values[RouteObjectives::COST]
+                      << std::setw(14) << objectives.getBandwidth()
+                      << std::setw(14) << std::setprecision(4) << objectives.getReliability()
+                      << std::setw(8) << first.front[i].pathNodes.size() - 1 << "\n";
+        }
+        if (first.front.size() > shown)
+            std::cout << "... еще " << first.front.size() - shown << "\n";
+    }
+}
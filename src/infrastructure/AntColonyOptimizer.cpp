@@ -4,12 +4,11 @@
 #include <limits>
 #include <algorithm>
 #include <cmath>
-#include <queue>
 
 namespace Infrastructure
 {
     HeuristicResult AntColonyOptimizer::optimize(const Domain::NetworkGraphPtr &graph,
-                                               const std::vector<std::pair<int, int>> &demands)
+                                               const std::vector<Domain::NodePair> &demands)
     {
         auto startTime = std::chrono::high_resolution_clock::now();
         HeuristicResult result;
@@ -29,12 +28,18 @@ namespace Infrastructure
         std::cout << "Запуск ACO: " << start << " → " << end 
                   << " (муравьев: " << antCount << ", итераций: " << iterations << ")\n";
 
+        // колония работает по CSR-снимку графа в плотных индексах
+        auto compact = graph->getCompactGraph();
+        const NodeIndex start_idx = compact->findIndex(start);
+        const NodeIndex end_idx = compact->findIndex(end);
+
         // инициализация феромонов и эвристик
-        initializePheromones(graph);
-        initializeHeuristics(graph);
+        initializePheromones(*compact);
+        initializeHeuristics(*compact);
 
         Ant global_best;
         global_best.path_cost = std::numeric_limits<double>::max();
+        std::size_t colony_bytes = 0;
 
         // основной цикл ACO
         for (size_t iter = 0; iter < iterations; ++iter) {
@@ -42,8 +47,8 @@ namespace Infrastructure
             
             // построение решений каждым муравьем
             for (size_t i = 0; i < antCount; ++i) {
-                Ant ant = constructSolution(graph, start, end);
-                if (!ant.path.empty() && ant.path.back() == end) {
+                Ant ant = constructSolution(*compact, start_idx, end_idx);
+                if (!ant.path.empty() && ant.path.back() == end_idx) {
                     ants.push_back(ant);
                     
                     // обновление глобально лучшего решения
@@ -53,6 +58,11 @@ namespace Infrastructure
                 }
             }
 
+            std::size_t bytes = ants.capacity() * sizeof(Ant);
+            for (const auto &ant : ants)
+                bytes += ant.path.capacity() * sizeof(NodeIndex) + ant.edges.capacity() * sizeof(EdgeIndex);
+            colony_bytes = std::max(colony_bytes, bytes);
+
             // обновление феромонов
             if (!ants.empty()) {
                 updatePheromones(ants);
@@ -72,10 +82,14 @@ namespace Infrastructure
             result.objective = global_best.path_cost;
             result.executionTime = duration.count() / 1000000.0;
             result.algorithmName = "Ant Colony Optimization";
+            result.scratchBytes = colony_bytes +
+                                  Domain::MemoryEstimate::of(pheromone) + Domain::MemoryEstimate::of(heuristic) +
+                                  Domain::MemoryEstimate::of(visitStamp) + Domain::MemoryEstimate::of(probabilities);
 
             // преобразование пути
             for (size_t i = 0; i + 1 < global_best.path.size(); ++i) {
-                result.path.emplace_back(global_best.path[i], global_best.path[i + 1]);
+                result.path.emplace_back(compact->getNodeId(global_best.path[i]),
+                                         compact->getNodeId(global_best.path[i + 1]));
             }
 
             std::cout << "ACO завершен: cost=" << global_best.path_cost 
@@ -88,182 +102,126 @@ namespace Infrastructure
         return result;
     }
 
-    void AntColonyOptimizer::initializePheromones(const Domain::NetworkGraphPtr &graph) {
-        pheromone.clear();
-        auto nodes = graph->getAllNodeIds();
-        
+    void AntColonyOptimizer::initializePheromones(const Domain::CompactGraph &graph) {
         // инициализация феромонов небольшим значением
         double initial_pheromone = 1.0;
-        for (int node : nodes) {
-            auto neighbors = graph->getNeighbors(node);
-            for (int neighbor : neighbors) {
-                pheromone[node][neighbor] = initial_pheromone;
-            }
-        }
+        pheromone.assign(graph.getEdgeCount(), initial_pheromone);
     }
 
-    void AntColonyOptimizer::initializeHeuristics(const Domain::NetworkGraphPtr &graph) {
-        heuristic.clear();
-        auto nodes = graph->getAllNodeIds();
-        
+    void AntColonyOptimizer::initializeHeuristics(const Domain::CompactGraph &graph) {
+        weights = graph.getEdgeWeights(strategy);
+        heuristic.resize(graph.getEdgeCount());
+
         // эвристическая информация = 1/стоимость_ребра
-        for (int node : nodes) {
-            auto neighbors = graph->getNeighbors(node);
-            for (int neighbor : neighbors) {
-                try {
-                    double cost = graph->getEdgeWeight(node, neighbor, strategy);
-                    heuristic[node][neighbor] = 1.0 / (cost + 0.1); // + 0.1 чтобы избежать деления на 0
-                } catch (...) {
-                    heuristic[node][neighbor] = 0.1;
-                }
-            }
+        for (EdgeIndex e = 0; e < heuristic.size(); ++e) {
+            heuristic[e] = 1.0 / ((*weights)[e] + 0.1); // + 0.1 чтобы избежать деления на 0
         }
+
+        visitStamp.assign(graph.getNodeCount(), 0);
+        currentStamp = 0;
     }
 
-    AntColonyOptimizer::Ant AntColonyOptimizer::constructSolution(const Domain::NetworkGraphPtr &graph, 
-                                                                 int start, int end) {
+    AntColonyOptimizer::Ant AntColonyOptimizer::constructSolution(const Domain::CompactGraph &graph,
+                                                                 NodeIndex start, NodeIndex end) {
         Ant ant;
-        ant.visited.insert(start);
         ant.path.push_back(start);
         ant.path_cost = 0.0;
 
-        int current = start;
+        // новая отметка вместо очистки множества посещенных узлов
+        if (++currentStamp == 0) {
+            std::fill(visitStamp.begin(), visitStamp.end(), 0);
+            currentStamp = 1;
+        }
+        visitStamp[start] = currentStamp;
+
+        NodeIndex current = start;
         
         const size_t MAX_PATH_LENGTH = 5000;
         
         while (current != end && ant.path.size() < MAX_PATH_LENGTH) {
-            int next = selectNextNode(ant, graph, end);
-            if (next == -1) {
+            EdgeIndex edge = selectNextEdge(graph, current);
+            if (edge == Domain::CompactGraph::INVALID_EDGE) {
                 break; // нет доступных соседей
             }
             
             // добавляем стоимость перехода
-            try {
-                double edge_cost = graph->getEdgeWeight(current, next, strategy);
-                ant.path_cost += edge_cost;
-            } catch (...) {
-                break;
-            }
-            
+            NodeIndex next = graph.getTarget(edge);
+            ant.path_cost += (*weights)[edge];
             ant.path.push_back(next);
-            ant.visited.insert(next);
+            ant.edges.push_back(edge);
+            visitStamp[next] = currentStamp;
             current = next;
         }
         
         return ant;
     }
 
-    int AntColonyOptimizer::selectNextNode(const Ant& ant, const Domain::NetworkGraphPtr &graph, int end) {
-        int current = ant.path.back();
-        auto available = getAvailableNeighbors(ant, graph, current);
-        
-        if (available.empty()) {
-            return -1;
-        }
-        
-        // вычисление вероятностей перехода
-        std::vector<double> probabilities;
+    AntColonyOptimizer::EdgeIndex AntColonyOptimizer::selectNextEdge(const Domain::CompactGraph &graph,
+                                                                     NodeIndex current) {
+        const EdgeIndex first = graph.edgesBegin(current);
+        const EdgeIndex last = graph.edgesEnd(current);
+
+        // вычисление вероятностей перехода: (pheromone^alpha) * (heuristic^beta),
+        // для посещенных соседей вероятность нулевая
+        probabilities.assign(last - first, 0.0);
         double sum = 0.0;
-        
-        for (int neighbor : available) {
-            double prob = calculateTransitionProbability(ant, current, neighbor, graph);
-            probabilities.push_back(prob);
+        size_t available = 0;
+
+        for (EdgeIndex e = first; e < last; ++e) {
+            if (visitStamp[graph.getTarget(e)] == currentStamp)
+                continue;
+            double prob = std::pow(pheromone[e], alpha) * std::pow(heuristic[e], beta);
+            probabilities[e - first] = prob;
             sum += prob;
+            ++available;
+        }
+        
+        if (available == 0) {
+            return Domain::CompactGraph::INVALID_EDGE;
         }
         
         if (sum == 0.0) {
             // случайный выбор если все вероятности нулевые
-            std::uniform_int_distribution<size_t> dist(0, available.size() - 1);
-            return available[dist(gen)];
+            std::uniform_int_distribution<size_t> dist(0, available - 1);
+            size_t pick = dist(gen);
+            for (EdgeIndex e = first; e < last; ++e) {
+                if (visitStamp[graph.getTarget(e)] != currentStamp && pick-- == 0)
+                    return e;
+            }
         }
         
         // нормализация и рулеточный выбор
         std::uniform_real_distribution<double> dist(0.0, sum);
         double random_value = dist(gen);
         double cumulative = 0.0;
+        EdgeIndex last_available = Domain::CompactGraph::INVALID_EDGE;
         
-        for (size_t i = 0; i < available.size(); ++i) {
-            cumulative += probabilities[i];
+        for (EdgeIndex e = first; e < last; ++e) {
+            if (probabilities[e - first] == 0.0)
+                continue;
+            cumulative += probabilities[e - first];
+            last_available = e;
             if (random_value <= cumulative) {
-                return available[i];
+                return e;
             }
         }
         
-        return available.back();
-    }
-
-    double AntColonyOptimizer::calculateTransitionProbability(const Ant& ant, int current, int next, 
-                                                             const Domain::NetworkGraphPtr &graph) {
-        // формула ACO: (pheromone^alpha) * (heuristic^beta)
-        double pheromone_value = pheromone[current][next];
-        double heuristic_value = heuristic[current][next];
-        
-        return std::pow(pheromone_value, alpha) * std::pow(heuristic_value, beta);
+        return last_available;
     }
 
     void AntColonyOptimizer::updatePheromones(std::vector<Ant>& ants) {
         // испарение феромонов
-        for (auto& [node, neighbors] : pheromone) {
-            for (auto& [neighbor, value] : neighbors) {
-                value *= (1.0 - evaporation);
-            }
+        for (double &value : pheromone) {
+            value *= (1.0 - evaporation);
         }
         
         // обновление феромонов на основе качества решений
         for (auto& ant : ants) {
             double delta_pheromone = Q / ant.path_cost;
             
-            for (size_t i = 0; i + 1 < ant.path.size(); ++i) {
-                int from = ant.path[i];
-                int to = ant.path[i + 1];
-                
-                if (pheromone.find(from) != pheromone.end() && 
-                    pheromone[from].find(to) != pheromone[from].end()) {
-                    pheromone[from][to] += delta_pheromone;
-                }
-            }
-        }
-    }
-
-    std::vector<int> AntColonyOptimizer::getAvailableNeighbors(const Ant& ant, 
-                                                              const Domain::NetworkGraphPtr &graph, 
-                                                              int current) {
-        std::vector<int> available;
-        auto neighbors = graph->getNeighbors(current);
-        
-        for (int neighbor : neighbors) {
-            if (ant.visited.find(neighbor) == ant.visited.end()) {
-                available.push_back(neighbor);
-            }
-        }
-        
-        return available;
-    }
-
-    bool AntColonyOptimizer::isValidPath(const std::vector<int>& path, const Domain::NetworkGraphPtr &graph) {
-        if (path.size() < 2) return false;
-        
-        for (size_t i = 0; i < path.size() - 1; ++i) {
-            if (!graph->hasNode(path[i]) || !graph->hasNode(path[i + 1])) {
-                return false;
-            }
-            auto neighbors = graph->getNeighbors(path[i]);
-            if (std::find(neighbors.begin(), neighbors.end(), path[i + 1]) == neighbors.end()) {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    double AntColonyOptimizer::calculatePathCost(const std::vector<int>& path, const Domain::NetworkGraphPtr &graph) {
-        double total_cost = 0.0;
-        for (size_t i = 0; i + 1 < path.size(); ++i) {
-            try {
-                total_cost += graph->getEdgeWeight(path[i], path[i + 1], strategy);
-            } catch (...) {
-                return std::numeric_limits<double>::max();
+            for (EdgeIndex e : ant.edges) {
+                pheromone[e] += delta_pheromone;
             }
         }
-        return total_cost;
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,8 @@
 #include "infrastructure/BasicMonitor.h"
 #include "infrastructure/BGLShortestPath.h"
+#include "infrastructure/MemoryProbe.h"
 #include <algorithm>
+#include <iomanip>
 
 namespace Infrastructure
 {
@@ -18,8 +20,8 @@ namespace Infrastructure
         
         // выборочный расчет вместо полного
         for (int i = 0; i < sample_size; ++i) {
-            int node = node_ids[i];
-            int degree = graph->getNeighbors(node).size();
+            auto node = node_ids[i];
+            int degree = static_cast<int>(graph->getOutDegree(node));
             total_edges += degree;
             max_degree = std::max(max_degree, degree);
         }
@@ -41,7 +43,49 @@ namespace Infrastructure
         return metrics;
     }
     
-    void BasicMonitor::simulateNodeFailure(const Domain::NetworkGraphPtr& graph, int node_id)
+    void BasicMonitor::printParameterMemoryReport(const Domain::NetworkGraphPtr& graph)
+    {
+        using Store = Domain::LinkParameterStore;
+        const Store &store = graph->getParameterStore();
+        const Store::Encoding modes[] = {Store::FULL_PRECISION, Store::FLOAT32, Store::QUANTIZED};
+
+        std::cout << "ПАМЯТЬ ПАРАМЕТРОВ СВЯЗЕЙ\n";
+        std::cout << "Выделенные столбцы:";
+        const char *names[] = {"latency", "bandwidth", "packet_loss", "utilization", "cost", "reliability"};
+        for (int c = 0; c < Store::COLUMN_COUNT; ++c)
+            if (store.isColumnMaterialized(static_cast<Store::Column>(c))) std::cout << " " << names[c];
+        std::cout << "\n";
+        for (auto mode : modes)
+        {
+            std::cout << "  " << Store::getEncodingName(mode) << ": " << store.getBytesPerEdge(mode) << " байт/ребро"
+                      << (mode == store.getEncoding() ? " (текущий)" : "") << "\n";
+        }
+        std::cout << "Занято сейчас: " << store.getMemoryUsage() << " байт на " << store.getActiveCount() << " ребер\n";
+    }
+
+    void BasicMonitor::printMemoryReport(const Domain::NetworkGraphPtr& graph)
+    {
+        auto usage = graph->getMemoryUsage();
+        const std::size_t edges = std::max<std::size_t>(graph->getEdgeCount(), 1);
+
+        std::cout << "ПАМЯТЬ ГРАФА (" << graph->getNodeCount() << " узлов, " << graph->getEdgeCount() << " ребер)\n";
+        for (const auto &[name, bytes] : usage.items)
+        {
+            std::cout << "  " << std::left << std::setw(20) << name << std::right << std::setw(12) << bytes << " байт"
+                      << std::setw(10) << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / edges
+                      << " байт/ребро\n";
+        }
+        std::cout << "  " << std::left << std::setw(20) << "Итого" << std::right << std::setw(12) << usage.getTotal() << " байт"
+                  << std::setw(10) << static_cast<double>(usage.getTotal()) / edges << " байт/ребро\n";
+        std::cout << std::defaultfloat;
+
+        auto rss = MemoryProbe::sample();
+        if (rss.currentRss)
+            std::cout << "RSS процесса: " << rss.currentRss / 1024 << " KB (пик " << rss.peakRss / 1024 << " KB)\n";
+        printParameterMemoryReport(graph);
+    }
+
+    void BasicMonitor::simulateNodeFailure(const Domain::NetworkGraphPtr& graph, Domain::NodeId node_id)
     {
         std::cout << "\nСИМУЛЯЦИЯ ОТКАЗА УЗЛА " << node_id << " \n";
         
@@ -50,7 +94,8 @@ namespace Infrastructure
             return;
         }
         
-        auto snapshot = graph->createSnapshot();
+        // снимок разделяет граф с оригиналом и хранит только сам отказ
+        auto snapshot = graph->createOverlaySnapshot();
         int original_count = snapshot->getNodeCount();
         
         if (snapshot->removeNode(node_id)) {
@@ -60,8 +105,7 @@ namespace Infrastructure
             // проверяем связность на нескольких тестовых маршрутах
             auto nodes = snapshot->getAllNodeIds();
             if (nodes.size() >= 2) {
-                BGLShortestPath finder(false);
-                auto result = finder.findShortestPath(snapshot, nodes[0], nodes[1]);
+                auto result = BGLShortestPath::findShortestPathStatic(*snapshot, nodes[0], nodes[1], false);
                 std::cout << "Связность после отказа: " << (result.success ? "OK" : "FAIL") << "\n";
             }
         } else {
@@ -69,7 +113,7 @@ namespace Infrastructure
         }
     }
     
-    void BasicMonitor::simulateEdgeFailure(const Domain::NetworkGraphPtr& graph, int from, int to)
+    void BasicMonitor::simulateEdgeFailure(const Domain::NetworkGraphPtr& graph, Domain::NodeId from, Domain::NodeId to)
     {
         std::cout << "\nСИМУЛЯЦИЯ ОТКАЗА РЕБРА " << from << " → " << to << " \n";
         
@@ -78,14 +122,13 @@ namespace Infrastructure
             return;
         }
         
-        auto snapshot = graph->createSnapshot();
+        auto snapshot = graph->createOverlaySnapshot();
         
         if (snapshot->removeEdge(from, to)) {
             std::cout << "OK Ребро " << from << " → " << to << " успешно отключено\n";
             
             // проверяем связность
-            BGLShortestPath finder(false);
-            auto result = finder.findShortestPath(snapshot, from, to);
+            auto result = BGLShortestPath::findShortestPathStatic(*snapshot, from, to, false);
             std::cout << "Связность после отказа: " << (result.success ? "OK" : "FAIL") << "\n";
         } else {
             std::cout << "FAIL Не удалось отключить ребро\n";
@@ -93,7 +136,7 @@ namespace Infrastructure
     }
     
     void BasicMonitor::analyzeConnectivity(const Domain::NetworkGraphPtr& graph, 
-                                         const std::vector<std::pair<int, int>>& test_pairs)
+                                         const std::vector<Domain::NodePair>& test_pairs)
     {
         std::cout << "\nАНАЛИЗ СВЯЗНОСТИ\n";
         BGLShortestPath finder(false);
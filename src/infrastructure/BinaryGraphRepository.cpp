@@ -0,0 +1,285 @@
+#include "infrastructure/BinaryGraphRepository.h"
+#include "infrastructure/BinaryGraphFormat.h"
+#include "infrastructure/MappedFile.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        using Domain::CompactGraph;
+        using Domain::LinkParameterStore;
+        using Domain::ParameterColumn;
+
+        using namespace BinaryGraphFormat;
+
+        constexpr std::size_t LOAD_BATCH = 1 << 20;   // ребер на пакет при сборке NetworkGraph
+
+        template <typename T>
+        SectionEntry arraySection(SectionKind kind, const Domain::ArrayStorage<T> &array)
+        {
+            SectionEntry entry{};
+            entry.kind = kind;
+            entry.elementSize = sizeof(T);
+            entry.materialized = 1;
+            entry.count = array.size();
+            return entry;
+        }
+
+        template <typename T>
+        Domain::ArrayStorage<T> arrayView(const SectionEntry &entry, const std::shared_ptr<const MappedFile> &file)
+        {
+            return Domain::ArrayStorage<T>::view(reinterpret_cast<const T *>(file->data() + entry.offset),
+                                                 entry.count, file);
+        }
+    }
+
+    void BinaryGraphRepository::save(const Domain::CompactGraph &graph, const std::string &filename)
+    {
+        const auto &store = graph.getParameterStore();
+        std::vector<SectionEntry> sections;
+        std::vector<const void *> payload;
+        sections.push_back(arraySection(NODE_IDS, graph.getNodeIdArray()));
+        payload.push_back(graph.getNodeIdArray().data());
+        sections.push_back(arraySection(SORTED_IDS, graph.getSortedIdArray()));
+        payload.push_back(graph.getSortedIdArray().data());
+        sections.push_back(arraySection(SORTED_INDEX, graph.getSortedIndexArray()));
+        payload.push_back(graph.getSortedIndexArray().data());
+        sections.push_back(arraySection(OFFSETS, graph.getOffsetArray()));
+        payload.push_back(graph.getOffsetArray().data());
+        sections.push_back(arraySection(TARGETS, graph.getTargetArray()));
+        payload.push_back(graph.getTargetArray().data());
+        std::array<ParameterColumn, LinkParameterStore::COLUMN_COUNT> contiguous;
+        for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+        {
+            const auto &column = store.getColumn(static_cast<LinkParameterStore::Column>(c));
+            SectionEntry entry{};
+            entry.kind = PARAMETERS + c;
+            entry.elementSize = static_cast<std::uint32_t>(ParameterColumn::getEncodedSize(column.getEncoding()));
+            entry.encoding = column.getEncoding();
+            entry.materialized = column.isMaterialized() ? 1 : 0;
+            entry.defaultValue = column.getDefaultValue();
+            entry.count = column.size();
+            sections.push_back(entry);
+            // у снимка с замененными страницами значения не лежат подряд - пишется сплошная копия
+            if (column.isMaterialized() && !column.getData())
+            {
+                contiguous[c] = column.reencode(column.getEncoding());
+                payload.push_back(contiguous[c].getData());
+            }
+            else
+                payload.push_back(column.getData());
+        }
+
+        FileHeader header = makeHeader();
+        header.nodeCount = graph.getNodeCount();
+        header.edgeCount = graph.getEdgeCount();
+        header.parameterEncoding = store.getEncoding();
+
+        std::uint64_t offset = firstSectionOffset();
+        header.dataChecksum = CHECKSUM_SEED;
+        for (std::size_t s = 0; s < sections.size(); ++s)
+        {
+            sections[s].offset = offset;
+            offset = alignUp(offset + sections[s].getBytes());
+            header.dataChecksum = checksum(payload[s], sections[s].getBytes(), header.dataChecksum);
+        }
+        header.headerChecksum = headerChecksum(header, sections);
+
+        // новое содержимое появляется под именем файла только целиком
+        const std::string temporary = filename + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out)
+                throw std::runtime_error("Cannot create file: " + temporary);
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(sections.data()), sections.size() * sizeof(SectionEntry));
+            std::uint64_t position = sizeof(FileHeader) + sections.size() * sizeof(SectionEntry);
+            const char zeros[SECTION_ALIGNMENT] = {};
+            for (std::size_t s = 0; s < sections.size(); ++s)
+            {
+                out.write(zeros, static_cast<std::streamsize>(sections[s].offset - position));
+                out.write(static_cast<const char *>(payload[s]), static_cast<std::streamsize>(sections[s].getBytes()));
+                position = sections[s].offset + sections[s].getBytes();
+            }
+            out.write(zeros, static_cast<std::streamsize>(alignUp(position) - position));
+            if (!out)
+                throw std::runtime_error("Cannot write file: " + temporary);
+        }
+#ifdef _WIN32
+        // rename в Windows не заменяет существующий файл
+        std::remove(filename.c_str());
+#endif
+        if (std::rename(temporary.c_str(), filename.c_str()) != 0)
+        {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Cannot replace file: " + filename);
+        }
+    }
+
+    bool BinaryGraphRepository::isBinaryGraphFile(const std::string &filename)
+    {
+        std::ifstream in(filename, std::ios::binary);
+        char magic[sizeof(MAGIC)] = {};
+        return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+    }
+
+    Domain::CompactGraphPtr BinaryGraphRepository::openCompactGraph(const std::string &filename) const
+    {
+        auto file = std::make_shared<const MappedFile>(filename, MappedFile::RANDOM);
+
+        FileHeader header;
+        if (file->size() < sizeof(header))
+            throw std::runtime_error("Not a binary graph file: " + filename);
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+            throw std::runtime_error("Not a binary graph file: " + filename);
+        if (header.byteOrder != BYTE_ORDER_MARK)
+            throw std::runtime_error("Binary graph file has foreign byte order: " + filename);
+        if (header.version != VERSION)
+            throw std::runtime_error("Unsupported binary graph version " + std::to_string(header.version) +
+                                     ": " + filename);
+        if (header.sectionCount != SECTION_COUNT ||
+            file->size() < sizeof(header) + header.sectionCount * sizeof(SectionEntry) ||
+            header.parameterEncoding > LinkParameterStore::QUANTIZED)
+            throw std::runtime_error("Corrupted binary graph header: " + filename);
+
+        std::vector<SectionEntry> sections(header.sectionCount);
+        std::memcpy(sections.data(), file->data() + TABLE_OFFSET, sections.size() * sizeof(SectionEntry));
+        if (headerChecksum(header, sections) != header.headerChecksum)
+            throw std::runtime_error("Binary graph header checksum mismatch: " + filename);
+
+        // размеры разделов согласованы со счетчиками и не выходят за файл
+        const std::uint64_t n = header.nodeCount;
+        const std::uint64_t m = header.edgeCount;
+        const auto encoding = static_cast<LinkParameterStore::Encoding>(header.parameterEncoding);
+        for (std::size_t s = 0; s < sections.size(); ++s)
+        {
+            const auto &entry = sections[s];
+            std::uint64_t count = m, element = 0;
+            switch (s)
+            {
+            case NODE_IDS: count = n; element = sizeof(Domain::NodeId); break;
+            case SORTED_IDS: count = entry.count ? n : 0; element = sizeof(Domain::NodeId); break;
+            case SORTED_INDEX: count = entry.count ? n : 0; element = sizeof(Domain::NodeIndex); break;
+            case OFFSETS: count = n + 1; element = sizeof(CompactGraph::EdgeIndex); break;
+            case TARGETS: element = sizeof(Domain::NodeIndex); break;
+            default:
+            {
+                auto column = LinkParameterStore::getColumnEncoding(
+                    encoding, static_cast<LinkParameterStore::Column>(s - PARAMETERS));
+                if (entry.encoding != static_cast<std::uint32_t>(column))
+                    throw std::runtime_error("Corrupted binary graph header: " + filename);
+                element = ParameterColumn::getEncodedSize(column);
+                break;
+            }
+            }
+            if (entry.kind != s || entry.count != count || entry.elementSize != element ||
+                entry.offset % SECTION_ALIGNMENT != 0 || entry.offset > file->size() ||
+                entry.getBytes() > file->size() - entry.offset)
+                throw std::runtime_error("Corrupted binary graph header: " + filename);
+        }
+
+        if (verifyChecksum && dataChecksum(file->data(), sections) != header.dataChecksum)
+            throw std::runtime_error("Binary graph data checksum mismatch: " + filename);
+
+        CompactGraph::Arrays arrays;
+        arrays.nodeIds = arrayView<Domain::NodeId>(sections[NODE_IDS], file);
+        arrays.sortedIds = arrayView<Domain::NodeId>(sections[SORTED_IDS], file);
+        arrays.sortedIndex = arrayView<Domain::NodeIndex>(sections[SORTED_INDEX], file);
+        arrays.offsets = arrayView<CompactGraph::EdgeIndex>(sections[OFFSETS], file);
+        arrays.targets = arrayView<Domain::NodeIndex>(sections[TARGETS], file);
+
+        std::array<ParameterColumn, LinkParameterStore::COLUMN_COUNT> columns;
+        for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+        {
+            const auto &entry = sections[PARAMETERS + c];
+            const auto column_encoding = static_cast<ParameterColumn::Encoding>(entry.encoding);
+            if (entry.materialized)
+            {
+                columns[c] = ParameterColumn::view(column_encoding, entry.defaultValue,
+                                                   file->data() + entry.offset, entry.count, file);
+            }
+            else
+            {
+                columns[c] = ParameterColumn(column_encoding, entry.defaultValue);
+                columns[c].resize(entry.count);
+            }
+        }
+
+        try
+        {
+            arrays.parameters = LinkParameterStore::fromColumns(encoding, std::move(columns));
+            return CompactGraph::fromArrays(std::move(arrays));
+        }
+        catch (const std::exception &e)
+        {
+            throw std::runtime_error("Corrupted binary graph file " + filename + ": " + e.what());
+        }
+    }
+
+    Domain::NetworkGraphPtr BinaryGraphRepository::buildNetworkGraph(const Domain::CompactGraphPtr &compact,
+                                                                     const std::string &name,
+                                                                     const std::vector<Domain::NodeId> &node_order)
+    {
+        if (!node_order.empty() && node_order.size() != compact->getNodeCount())
+            throw std::invalid_argument("Node order does not match graph size");
+
+        // вершины добавляются заранее (включая изолированные), ребра - пакетами по строкам CSR
+        auto graph = std::make_shared<Domain::NetworkGraph>(name, compact->getParameterStore().getEncoding());
+        graph->reserve(compact->getNodeCount(), compact->getEdgeCount());
+        if (node_order.empty())
+        {
+            for (CompactGraph::NodeIndex u = 0; u < compact->getNodeCount(); ++u)
+                graph->addNode(compact->getNodeId(u));
+        }
+        else
+        {
+            for (auto id : node_order)
+                graph->addNode(id);
+        }
+
+        std::vector<Domain::EdgeRecord> batch;
+        batch.reserve(std::min(compact->getEdgeCount(), LOAD_BATCH));
+        for (CompactGraph::NodeIndex u = 0; u < compact->getNodeCount(); ++u)
+        {
+            const Domain::NodeId source = compact->getNodeId(u);
+            for (auto e = compact->edgesBegin(u); e != compact->edgesEnd(u); ++e)
+            {
+                batch.emplace_back(source, compact->getNodeId(compact->getTarget(e)), compact->getEdgeParameters(e));
+                if (batch.size() == LOAD_BATCH)
+                {
+                    graph->addEdges(batch);
+                    batch.clear();
+                }
+            }
+        }
+        graph->addEdges(batch);
+        // порядок с чужими id добавляет лишние вершины, и снимок отклоняется по размеру
+        graph->adoptCompactGraph(compact);
+        return graph;
+    }
+
+    Domain::NetworkGraphPtr BinaryGraphRepository::loadGraph(const std::string &filename)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto compact = openCompactGraph(filename);
+        auto opened = std::chrono::high_resolution_clock::now();
+        auto graph = buildNetworkGraph(compact, "Binary Network Graph");
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << "Загружен двоичный граф: " << compact->getNodeCount() << " узлов, "
+                  << compact->getEdgeCount() << " ребер (отображение файла: "
+                  << std::chrono::duration<double, std::milli>(opened - start).count() << " мс, построение: "
+                  << std::chrono::duration<double, std::milli>(end - opened).count() << " мс)\n";
+        return graph;
+    }
+}
@@ -1,11 +1,11 @@
 #include "infrastructure/BoostFlowSolver.h"
 #include "domain/NetworkGraph.h"
+#include "domain/CompactGraph.h"
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/push_relabel_max_flow.hpp>
 #include <boost/graph/successive_shortest_path_nonnegative_weights.hpp>
 #include <boost/graph/find_flow_cost.hpp>
-#include <unordered_map>
 #include <vector>
 #include <chrono>
 #include <stdexcept>
@@ -26,7 +26,7 @@ namespace Infrastructure
     using EdgeDesc = boost::graph_traits<BGLGraph>::edge_descriptor;
 
     FlowResult BoostFlowSolver::solveMaxFlow(const Domain::NetworkGraphPtr &graph,
-                                             int source, int sink)
+                                             Domain::NodeId source, Domain::NodeId sink)
     {
         FlowResult result;
         if (!graph || !graph->hasNode(source) || !graph->hasNode(sink))
@@ -38,49 +38,37 @@ namespace Infrastructure
 
         auto start = Clock::now();
 
-        std::vector<int> node_ids = graph->getAllNodeIds();
-        std::unordered_map<int, int> node_to_idx;
-        for (size_t i = 0; i < node_ids.size(); ++i)
-            node_to_idx[node_ids[i]] = static_cast<int>(i);
+        // граф потока строится из CSR-снимка: без хэш-таблиц и поиска весов по id
+        auto compact = graph->getCompactGraph();
+        const auto n = compact->getNodeCount();
+        const auto m = compact->getEdgeCount();
 
-        BGLGraph g(node_ids.size());
+        BGLGraph g(n);
         auto capacity_map = get(boost::edge_capacity, g);
         auto reverse_map = get(boost::edge_reverse, g);
+        std::vector<EdgeDesc> forward(m);
 
-        for (int u_id : node_ids)
+        for (Domain::CompactGraph::NodeIndex u = 0; u < n; ++u)
         {
-            int u_idx = node_to_idx[u_id];
-            for (int v_id : graph->getNeighbors(u_id))
+            for (auto e = compact->edgesBegin(u); e != compact->edgesEnd(u); ++e)
             {
-                if (node_to_idx.find(v_id) == node_to_idx.end())
-                    continue;
-                int v_idx = node_to_idx[v_id];
-
-                EdgeDesc e, rev_e;
-                bool inserted_e, inserted_rev;
-                boost::tie(e, inserted_e) = boost::add_edge(u_idx, v_idx, g);
-                boost::tie(rev_e, inserted_rev) = boost::add_edge(v_idx, u_idx, g);
-
-                long cap = 1;
-                try
-                {
-                    cap = static_cast<long>(graph->getEdgeWeight(u_id, v_id));
-                }
-                catch (...)
-                {
-                }
-
-                capacity_map[e] = cap;
+                auto v = compact->getTarget(e);
+
+                EdgeDesc rev_e;
+                boost::tie(forward[e], std::ignore) = boost::add_edge(u, v, g);
+                boost::tie(rev_e, std::ignore) = boost::add_edge(v, u, g);
+
+                capacity_map[forward[e]] = static_cast<long>(compact->getEdgeValue(Domain::LinkParameterStore::LATENCY, e));
                 capacity_map[rev_e] = 0;
-                reverse_map[e] = rev_e;
-                reverse_map[rev_e] = e;
+                reverse_map[forward[e]] = rev_e;
+                reverse_map[rev_e] = forward[e];
             }
         }
 
         long flow = 0;
         try
         {
-            flow = boost::push_relabel_max_flow(g, node_to_idx[source], node_to_idx[sink]);
+            flow = boost::push_relabel_max_flow(g, compact->findIndex(source), compact->findIndex(sink));
         }
         catch (const std::exception &ex)
         {
@@ -90,20 +78,14 @@ namespace Infrastructure
         }
 
         auto residual_map = get(boost::edge_residual_capacity, g);
-        for (int u_id : node_ids)
+        for (Domain::CompactGraph::NodeIndex u = 0; u < n; ++u)
         {
-            int u = node_to_idx[u_id];
-            for (int v_id : graph->getNeighbors(u_id))
+            for (auto e = compact->edgesBegin(u); e != compact->edgesEnd(u); ++e)
             {
-                int v = node_to_idx[v_id];
-                EdgeDesc e;
-                bool found;
-                boost::tie(e, found) = edge(u, v, g);
-                if (!found)
-                    continue;
-                long f = capacity_map[e] - residual_map[e];
+                long f = capacity_map[forward[e]] - residual_map[forward[e]];
                 if (f > 0)
-                    result.flowPerEdge[{u_id, v_id}] = static_cast<double>(f);
+                    result.flowPerEdge[{compact->getNodeId(u), compact->getNodeId(compact->getTarget(e))}] =
+                        static_cast<double>(f);
             }
         }
 
@@ -117,7 +99,7 @@ namespace Infrastructure
     }
 
     FlowResult BoostFlowSolver::solveMinCostMaxFlow(const Domain::NetworkGraphPtr &graph,
-                                                    int source, int sink)
+                                                    Domain::NodeId source, Domain::NodeId sink)
     {
         FlowResult res;
         if (!graph || !graph->hasNode(source) || !graph->hasNode(sink))
@@ -128,45 +110,39 @@ namespace Infrastructure
         }
 
         auto start = Clock::now();
-        std::vector<int> node_ids = graph->getAllNodeIds();
-        std::unordered_map<int, int> node_to_idx;
-        for (size_t i = 0; i < node_ids.size(); ++i)
-            node_to_idx[node_ids[i]] = static_cast<int>(i);
+        auto compact = graph->getCompactGraph();
+        const auto n = compact->getNodeCount();
+        const auto m = compact->getEdgeCount();
 
-        BGLGraph g(node_ids.size());
+        BGLGraph g(n);
         auto capacity = get(boost::edge_capacity, g);
         auto rev = get(boost::edge_reverse, g);
         auto weight = get(boost::edge_weight, g);
+        std::vector<EdgeDesc> forward(m);
 
-        for (int u_id : node_ids)
+        for (Domain::CompactGraph::NodeIndex u = 0; u < n; ++u)
         {
-            for (int v_id : graph->getNeighbors(u_id))
+            for (auto e = compact->edgesBegin(u); e != compact->edgesEnd(u); ++e)
             {
-                long cap = 1, cost = 0;
-                try
-                {
-                    cap = static_cast<long>(graph->getEdgeWeight(u_id, v_id));
-                }
-                catch (...)
-                {
-                }
-
-                EdgeDesc e1, e2;
-                boost::tie(e1, std::ignore) = boost::add_edge(node_to_idx[u_id], node_to_idx[v_id], g);
-                boost::tie(e2, std::ignore) = boost::add_edge(node_to_idx[v_id], node_to_idx[u_id], g);
-
-                capacity[e1] = cap;
+                auto v = compact->getTarget(e);
+                long cap = static_cast<long>(compact->getEdgeValue(Domain::LinkParameterStore::LATENCY, e)), cost = 0;
+
+                EdgeDesc e2;
+                boost::tie(forward[e], std::ignore) = boost::add_edge(u, v, g);
+                boost::tie(e2, std::ignore) = boost::add_edge(v, u, g);
+
+                capacity[forward[e]] = cap;
                 capacity[e2] = 0;
-                weight[e1] = cost;
+                weight[forward[e]] = cost;
                 weight[e2] = -cost;
-                rev[e1] = e2;
-                rev[e2] = e1;
+                rev[forward[e]] = e2;
+                rev[e2] = forward[e];
             }
         }
 
         try
         {
-            boost::successive_shortest_path_nonnegative_weights(g, node_to_idx[source], node_to_idx[sink]);
+            boost::successive_shortest_path_nonnegative_weights(g, compact->findIndex(source), compact->findIndex(sink));
         }
         catch (const std::exception &ex)
         {
@@ -179,19 +155,14 @@ namespace Infrastructure
         long total_flow_cost = boost::find_flow_cost(g);
         auto residual = get(boost::edge_residual_capacity, g);
 
-        for (int u_id : node_ids)
+        for (Domain::CompactGraph::NodeIndex u = 0; u < n; ++u)
         {
-            for (int v_id : graph->getNeighbors(u_id))
+            for (auto e = compact->edgesBegin(u); e != compact->edgesEnd(u); ++e)
             {
-                int u = node_to_idx[u_id], v = node_to_idx[v_id];
-                EdgeDesc e;
-                bool found;
-                boost::tie(e, found) = edge(u, v, g);
-                if (!found)
-                    continue;
-                long f = capacity[e] - residual[e];
+                long f = capacity[forward[e]] - residual[forward[e]];
                 if (f != 0)
-                    res.flowPerEdge[{u_id, v_id}] = static_cast<double>(f);
+                    res.flowPerEdge[{compact->getNodeId(u), compact->getNodeId(compact->getTarget(e))}] =
+                        static_cast<double>(f);
             }
         }
 
@@ -0,0 +1,138 @@
+#include "infrastructure/CustomStrategyLoader.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <stdexcept>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        std::string trim(const std::string &s)
+        {
+            auto first = std::find_if(s.begin(), s.end(), [](unsigned char ch) { return !std::isspace(ch); });
+            auto last = std::find_if(s.rbegin(), s.rend(), [](unsigned char ch) { return !std::isspace(ch); }).base();
+            return first < last ? std::string(first, last) : std::string();
+        }
+
+        // строка без комментария: # вне кавычек; false - кавычка не закрыта
+        bool stripComment(std::string &line)
+        {
+            bool quoted = false;
+            for (std::size_t i = 0; i < line.size(); ++i)
+            {
+                if (line[i] == '"')
+                    quoted = !quoted;
+                else if (line[i] == '#' && !quoted)
+                {
+                    line.erase(i);
+                    break;
+                }
+            }
+            return !quoted;
+        }
+
+        // число целиком, без хвоста
+        bool parseNumber(const std::string &text, double &value)
+        {
+            try
+            {
+                std::size_t used = 0;
+                value = std::stod(text, &used);
+                return used == text.size();
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+    }
+
+    std::vector<Domain::CustomStrategy::Spec> CustomStrategyLoader::parse(std::istream &in, const std::string &source)
+    {
+        std::vector<Domain::CustomStrategy::Spec> specs;
+        std::string line;
+        int line_number = 0;
+        auto fail = [&](const std::string &message) {
+            throw std::runtime_error(source + ":" + std::to_string(line_number) + ": " + message);
+        };
+
+        while (std::getline(in, line))
+        {
+            ++line_number;
+            if (!stripComment(line))
+                fail("unterminated quote");
+            line = trim(line);
+            if (line.empty())
+                continue;
+
+            if (line.front() == '[')
+            {
+                if (line.back() != ']')
+                    fail("expected [name]");
+                Domain::CustomStrategy::Spec spec;
+                spec.name = trim(line.substr(1, line.size() - 2));
+                if (spec.name.empty())
+                    fail("empty strategy name");
+                specs.push_back(spec);
+                continue;
+            }
+
+            const auto eq = line.find('=');
+            if (eq == std::string::npos)
+                fail("expected key = value");
+            if (specs.empty())
+                fail("term outside of a [name] section");
+            const std::string key = trim(line.substr(0, eq));
+            const std::string value = trim(line.substr(eq + 1));
+            auto &spec = specs.back();
+
+            if (key == "description")
+            {
+                spec.description = value.size() >= 2 && value.front() == '"' && value.back() == '"'
+                                       ? value.substr(1, value.size() - 2)
+                                       : value;
+                continue;
+            }
+
+            Domain::CustomStrategy::Component component;
+            if (!Domain::CustomStrategy::findTerm(key, component.term))
+                fail("unknown term '" + key + "'");
+
+            const auto at = value.find('@');
+            if (!parseNumber(trim(value.substr(0, at)), component.coefficient))
+                fail("bad coefficient '" + value + "'");
+            if (at != std::string::npos)
+            {
+                if (component.term != Domain::CustomStrategy::UTILIZATION_EXCESS)
+                    fail("threshold is only allowed for utilization_excess");
+                if (!parseNumber(trim(value.substr(at + 1)), component.threshold))
+                    fail("bad threshold '" + value + "'");
+            }
+            spec.components.push_back(component);
+        }
+        return specs;
+    }
+
+    std::vector<Domain::WeightCalculator::Strategy> CustomStrategyLoader::loadFile(const std::string &filename)
+    {
+        std::ifstream in(filename);
+        if (!in.is_open())
+            throw std::runtime_error("Cannot open strategy file: " + filename);
+
+        std::vector<Domain::WeightCalculator::Strategy> strategies;
+        for (const auto &spec : parse(in, filename))
+        {
+            // компиляция один раз при загрузке; ошибки описания - с именем файла
+            try
+            {
+                strategies.push_back(Domain::WeightCalculator::registerStrategy(Domain::CustomStrategy(spec)));
+            }
+            catch (const std::invalid_argument &e)
+            {
+                throw std::runtime_error(filename + ": " + e.what());
+            }
+        }
+        return strategies;
+    }
+}
@@ -0,0 +1,127 @@
+#include "infrastructure/EdgeListParser.h"
+#include "infrastructure/LinkMetricsTable.h"
+#include "domain/ParameterSynthesizer.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        bool isSeparator(char c) { return c == ' ' || c == '\t' || c == ',' || c == '\r'; }
+
+        const char *skipSeparators(const char *p, const char *end)
+        {
+            while (p < end && isSeparator(*p)) ++p;
+            return p;
+        }
+
+        // число с позиции p; nullptr - число не разобрано
+        const char *parseNodeId(const char *p, const char *end, Domain::NodeId &value)
+        {
+            auto [ptr, ec] = std::from_chars(p, end, value);
+            return ec == std::errc() ? ptr : nullptr;
+        }
+
+        const char *parseWeight(const char *p, const char *end, double &value)
+        {
+#if defined(__cpp_lib_to_chars)
+            auto [ptr, ec] = std::from_chars(p, end, value);
+            return ec == std::errc() ? ptr : nullptr;
+#else
+            // библиотека без from_chars для double: strtod по копии токена (отображение не завершается нулем)
+            char token[64];
+            std::size_t n = 0;
+            while (p + n < end && n + 1 < sizeof(token) && !isSeparator(p[n]) && p[n] != '\n')
+            {
+                token[n] = p[n];
+                ++n;
+            }
+            token[n] = '\0';
+            char *token_end = nullptr;
+            value = std::strtod(token, &token_end);
+            return token_end == token ? nullptr : p + (token_end - token);
+#endif
+        }
+    }
+
+    EdgeListParser::Chunk EdgeListParser::parse(const char *begin, const char *end, const Options &options)
+    {
+        Chunk res;
+        // оценка числа ребер по размеру куска (~16 байт на строку)
+        res.records.reserve(static_cast<std::size_t>(end - begin) / 16 + 1);
+
+        const Domain::ParameterSynthesizer synthesizer(options.seed);
+
+        for (const char *line = begin; line < end;)
+        {
+            const char *line_end = static_cast<const char *>(std::memchr(line, '\n', end - line));
+            if (!line_end) line_end = end;
+            ++res.lines;
+
+            const char *p = line;
+            while (p < line_end && std::isspace(static_cast<unsigned char>(*p))) ++p;
+            const char *first = p;
+            line = line_end + 1;
+            if (p == line_end) continue;
+            if (options.dialect == DIMACS)
+            {
+                if (*p == 'c' || *p == 'p') continue;
+                // дуга: "a" и разделитель перед номерами вершин
+                p = *p == 'a' && p + 1 < line_end && isSeparator(p[1]) ? skipSeparators(p + 1, line_end) : nullptr;
+            }
+            else if (*p == '#' || *p == '%' || *p == '/')
+                continue;
+
+            Domain::NodeId u = 0, v = 0;
+            double file_weight = 1.0;
+            if (p) p = parseNodeId(p, line_end, u);
+            if (p) p = parseNodeId(skipSeparators(p, line_end), line_end, v);
+            if (!p)
+            {
+                ++res.unparsable;
+                if (res.lines <= WARNING_LINES) res.warnings.emplace_back(res.lines, std::string(first, line_end));
+                continue;
+            }
+            // вес из файла (если есть)
+            p = skipSeparators(p, line_end);
+            if (p == line_end || !parseWeight(p, line_end, file_weight)) file_weight = 1.0;
+
+            // вес из файла - задержка; остальные параметры синтезируются по ключу ребра
+            Domain::LinkParameters params;
+            params.latency = file_weight;
+            if (options.synthesize)
+            {
+                // у неориентированной связи параметры общие для обоих направлений
+                params = options.symmetric ? synthesizer.synthesize(std::min(u, v), std::max(u, v), file_weight)
+                                           : synthesizer.synthesize(u, v, file_weight);
+            }
+            if (options.metrics)
+            {
+                if (options.metrics->apply(u, v, options.symmetric, params))
+                    ++res.joined;
+                else if (++res.unjoined <= WARNING_LINES)
+                    res.unjoinedLinks.emplace_back(u, v);
+            }
+            res.records.emplace_back(u, v, params);
+            if (options.symmetric && u != v)
+                res.records.emplace_back(v, u, params);
+            res.maxNodeId = std::max(res.maxNodeId, std::max(u, v));
+        }
+        return res;
+    }
+
+    const char *EdgeListParser::parseValue(const char *p, const char *end, double &value)
+    {
+        return parseWeight(p, end, value);
+    }
+
+    const char *EdgeListParser::nextLine(const char *position, const char *end)
+    {
+        const char *nl = static_cast<const char *>(std::memchr(position, '\n', end - position));
+        return nl ? nl + 1 : end;
+    }
+}
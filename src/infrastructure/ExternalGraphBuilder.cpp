@@ -0,0 +1,550 @@
+#include "infrastructure/ExternalGraphBuilder.h"
+#include "infrastructure/BinaryGraphFormat.h"
+#include "infrastructure/EdgeListParser.h"
+#include "infrastructure/GraphFileFormat.h"
+#include "infrastructure/LinkMetricsTable.h"
+#include "infrastructure/MappedFile.h"
+#include "infrastructure/ThreadPool.h"
+#include "domain/CompactGraph.h"
+#include "domain/ParameterColumn.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        using namespace BinaryGraphFormat;
+        using Domain::CompactGraph;
+        using Domain::EdgeRecord;
+        using Domain::LinkParameterStore;
+        using Domain::NodeId;
+        using Domain::ParameterColumn;
+
+        constexpr std::size_t MIN_BUDGET = 4 << 20;
+        constexpr std::size_t PARSE_WINDOW = 4 << 20;       // байт текста на задачу разбора
+        constexpr std::size_t MIN_READ_BUFFER = 1 << 16;    // байт буфера чтения прогона при слиянии
+        constexpr std::size_t WRITE_BLOCK = 1 << 16;        // элементов на блок записи
+        // память буфера прогона на запись: сама запись, индекс сортировки и два id вершин
+        constexpr std::size_t BYTES_PER_RECORD = sizeof(EdgeRecord) + sizeof(std::uint32_t) + 2 * sizeof(NodeId);
+
+        // временные файлы удаляются при выходе из области видимости, в том числе при исключении
+        class TemporaryFiles
+        {
+        public:
+            explicit TemporaryFiles(std::string prefix) : prefix(std::move(prefix)) {}
+            ~TemporaryFiles()
+            {
+                for (const auto &name : names)
+                    std::remove(name.c_str());
+            }
+            TemporaryFiles(const TemporaryFiles &) = delete;
+            TemporaryFiles &operator=(const TemporaryFiles &) = delete;
+
+            std::string create(const std::string &suffix)
+            {
+                names.push_back(prefix + suffix);
+                return names.back();
+            }
+
+        private:
+            std::string prefix;
+            std::vector<std::string> names;
+        };
+
+        template <typename T>
+        void writeBlock(std::ostream &out, std::vector<T> &block, const std::string &name)
+        {
+            out.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size() * sizeof(T)));
+            if (!out)
+                throw std::runtime_error("Cannot write file: " + name);
+            block.clear();
+        }
+
+        // последовательное чтение прогона блоками
+        template <typename T>
+        class RunReader
+        {
+        public:
+            RunReader(const std::string &name, std::size_t buffer_bytes) : in(name, std::ios::binary | std::ios::ate)
+            {
+                if (!in)
+                    throw std::runtime_error("Cannot open temporary file: " + name);
+                // буфер не больше самого прогона
+                const auto size = static_cast<std::size_t>(in.tellg());
+                in.seekg(0);
+                buffer.resize(std::max<std::size_t>(1, std::min(buffer_bytes, size) / sizeof(T)));
+                fill();
+            }
+
+            bool done() const { return position == filled; }
+            const T &current() const { return buffer[position]; }
+            void advance()
+            {
+                if (++position == filled)
+                    fill();
+            }
+
+        private:
+            void fill()
+            {
+                in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(T)));
+                filled = static_cast<std::size_t>(in.gcount()) / sizeof(T);
+                position = 0;
+            }
+
+            std::ifstream in;
+            std::vector<T> buffer;
+            std::size_t position = 0;
+            std::size_t filled = 0;
+        };
+
+        // слияние отсортированных прогонов: visit получает элементы по возрастанию less,
+        // равные элементы - в порядке прогонов (то есть в порядке исходного файла)
+        template <typename T, typename Less, typename Visit>
+        void mergeRuns(const std::vector<std::string> &runs, std::size_t buffer_bytes, Less less, Visit visit)
+        {
+            std::vector<std::unique_ptr<RunReader<T>>> readers;
+            for (const auto &name : runs)
+                readers.push_back(std::make_unique<RunReader<T>>(name, buffer_bytes));
+
+            auto later = [&readers, &less](std::size_t a, std::size_t b) {
+                const T &x = readers[a]->current();
+                const T &y = readers[b]->current();
+                if (less(y, x)) return true;
+                if (less(x, y)) return false;
+                return a > b;
+            };
+            std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> queue(later);
+            for (std::size_t r = 0; r < readers.size(); ++r)
+                if (!readers[r]->done()) queue.push(r);
+
+            while (!queue.empty())
+            {
+                const std::size_t r = queue.top();
+                queue.pop();
+                visit(readers[r]->current());
+                readers[r]->advance();
+                if (!readers[r]->done()) queue.push(r);
+            }
+        }
+
+        // раздел выходного файла, записываемый блоками со своей позиции
+        template <typename T>
+        class SectionWriter
+        {
+        public:
+            SectionWriter(const std::string &filename, std::uint64_t offset)
+                : name(filename), out(filename, std::ios::binary | std::ios::in | std::ios::out)
+            {
+                out.seekp(static_cast<std::streamoff>(offset));
+                if (!out)
+                    throw std::runtime_error("Cannot write file: " + filename);
+                block.reserve(WRITE_BLOCK);
+            }
+
+            void push(const T &value)
+            {
+                block.push_back(value);
+                if (block.size() == WRITE_BLOCK)
+                    writeBlock(out, block, name);
+            }
+
+            // готовые байты раздела вслед за уже добавленными элементами
+            void write(const void *data, std::size_t bytes)
+            {
+                writeBlock(out, block, name);
+                out.write(static_cast<const char *>(data), static_cast<std::streamsize>(bytes));
+                if (!out)
+                    throw std::runtime_error("Cannot write file: " + name);
+            }
+
+            void close()
+            {
+                writeBlock(out, block, name);
+                out.close();
+            }
+
+        private:
+            std::string name;
+            std::fstream out;
+            std::vector<T> block;
+        };
+
+        // столбец параметров: значения кодируются так же, как в ParameterColumn
+        class ColumnWriter
+        {
+        public:
+            ColumnWriter(const std::string &filename, std::uint64_t offset, ParameterColumn::Encoding encoding,
+                         double default_value)
+                : writer(filename, offset), encoding(encoding), defaultValue(default_value)
+            {
+                values.reserve(WRITE_BLOCK);
+            }
+
+            void push(double value)
+            {
+                // столбец, все значения которого равны значению по умолчанию, не выделяется
+                materialized = materialized || value != defaultValue;
+                values.push_back(value);
+                if (values.size() == WRITE_BLOCK)
+                    flush();
+            }
+
+            void close()
+            {
+                flush();
+                writer.close();
+            }
+
+            bool isMaterialized() const { return materialized; }
+
+        private:
+            void flush()
+            {
+                encoded.resize(values.size() * ParameterColumn::getEncodedSize(encoding));
+                ParameterColumn::encode(encoding, values.data(), values.size(), encoded.data());
+                writer.write(encoded.data(), encoded.size());
+                values.clear();
+            }
+
+            SectionWriter<unsigned char> writer;
+            ParameterColumn::Encoding encoding;
+            double defaultValue;
+            bool materialized = false;
+            std::vector<double> values;
+            std::vector<unsigned char> encoded;
+        };
+
+        double columnValue(const Domain::LinkParameters &params, int column)
+        {
+            switch (column)
+            {
+            case LinkParameterStore::LATENCY: return params.latency;
+            case LinkParameterStore::BANDWIDTH: return params.bandwidth;
+            case LinkParameterStore::PACKET_LOSS: return params.packet_loss;
+            case LinkParameterStore::UTILIZATION: return params.utilization;
+            case LinkParameterStore::COST: return params.cost;
+            default: return params.reliability;
+            }
+        }
+
+        bool sameEdge(const EdgeRecord &a, const EdgeRecord &b)
+        {
+            return a.source == b.source && a.target == b.target;
+        }
+
+        bool edgeLess(const EdgeRecord &a, const EdgeRecord &b)
+        {
+            return a.source != b.source ? a.source < b.source : a.target < b.target;
+        }
+
+        double elapsed(std::chrono::steady_clock::time_point since)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+        }
+    }
+
+    ExternalGraphBuilder::Stats ExternalGraphBuilder::build(const std::string &edge_list, const std::string &output) const
+    {
+        Stats stats;
+        auto run_start = std::chrono::steady_clock::now();
+
+        const std::size_t budget = std::max(settings.memoryBudget, MIN_BUDGET);
+        // индексы сортировки 32-битные
+        const std::size_t run_capacity = std::min<std::size_t>(budget / BYTES_PER_RECORD, UINT32_MAX);
+
+        std::string prefix = output;
+        if (!settings.temporaryDirectory.empty())
+        {
+            const auto slash = output.find_last_of("/\\");
+            prefix = settings.temporaryDirectory + "/" + (slash == std::string::npos ? output : output.substr(slash + 1));
+        }
+        TemporaryFiles temporary(prefix);
+        std::vector<std::string> edge_runs, id_runs;
+
+        // 1. файл читается окнами, записи копятся до бюджета и сбрасываются отсортированными прогонами;
+        // повторы ребра внутри прогона схлопываются сразу
+        MappedFile text(edge_list);
+        const char *position = text.data();
+        const char *text_end = text.data() + text.size();
+        if (text.size() >= 3 && static_cast<unsigned char>(position[0]) == 0xEF &&
+            static_cast<unsigned char>(position[1]) == 0xBB && static_cast<unsigned char>(position[2]) == 0xBF)
+            position += 3;
+        const auto format = GraphFileFormat::detect(edge_list, position, text_end);
+        position += format.headerBytes;
+        auto parser_options = format.getParserOptions(settings.synthesizeParameters, settings.seed);
+        std::unique_ptr<LinkMetricsTable> metrics;
+        if (!settings.metricsFile.empty())
+        {
+            metrics = std::make_unique<LinkMetricsTable>(settings.metricsFile);
+            parser_options.metrics = metrics.get();
+        }
+
+        std::vector<EdgeRecord> records;
+        records.reserve(std::min(run_capacity, text.size() / 16 + 1));
+        std::uint64_t reserved_edges = 0;
+
+        auto spill = [&]() {
+            if (records.empty()) return;
+            std::vector<std::uint32_t> order(records.size());
+            std::iota(order.begin(), order.end(), 0u);
+            std::sort(order.begin(), order.end(), [&records](std::uint32_t a, std::uint32_t b) {
+                if (!sameEdge(records[a], records[b])) return edgeLess(records[a], records[b]);
+                return a < b;
+            });
+
+            const std::string run_name = temporary.create(".run" + std::to_string(edge_runs.size()) + ".tmp");
+            {
+                std::ofstream out(run_name, std::ios::binary | std::ios::trunc);
+                std::vector<EdgeRecord> block;
+                block.reserve(WRITE_BLOCK);
+                for (std::size_t i = 0; i < order.size(); ++i)
+                {
+                    // из повторов остается последняя запись
+                    if (i + 1 < order.size() && sameEdge(records[order[i]], records[order[i + 1]]))
+                        continue;
+                    block.push_back(records[order[i]]);
+                    ++reserved_edges;
+                    stats.temporaryBytes += sizeof(EdgeRecord);
+                    if (block.size() == WRITE_BLOCK)
+                        writeBlock(out, block, run_name);
+                }
+                writeBlock(out, block, run_name);
+            }
+            edge_runs.push_back(run_name);
+
+            std::vector<NodeId> ids;
+            ids.reserve(records.size() * 2);
+            for (const auto &record : records)
+            {
+                ids.push_back(record.source);
+                ids.push_back(record.target);
+            }
+            records.clear();
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+            const std::string ids_name = temporary.create(".ids" + std::to_string(id_runs.size()) + ".tmp");
+            stats.temporaryBytes += ids.size() * sizeof(NodeId);
+            {
+                std::ofstream out(ids_name, std::ios::binary | std::ios::trunc);
+                writeBlock(out, ids, ids_name);
+            }
+            id_runs.push_back(ids_name);
+        };
+
+        const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        ThreadPool pool(threads);
+        std::size_t line_offset = format.headerLines;
+        while (position < text_end)
+        {
+            // окна по границам строк разбираются параллельно, записи добавляются в порядке файла
+            std::vector<std::future<EdgeListParser::Chunk>> pending;
+            for (std::size_t t = 0; t < threads && position < text_end; ++t)
+            {
+                const char *window_end = static_cast<std::size_t>(text_end - position) <= PARSE_WINDOW
+                                             ? text_end
+                                             : EdgeListParser::nextLine(position + PARSE_WINDOW, text_end);
+                pending.push_back(pool.enqueue(EdgeListParser::parse, position, window_end, parser_options));
+                position = window_end;
+            }
+            for (auto &future : pending)
+            {
+                auto chunk = future.get();
+                for (const auto &[line_no, line] : chunk.warnings)
+                    if (line_offset + line_no <= EdgeListParser::WARNING_LINES)
+                        std::cerr << "Warning: cannot parse line " << line_offset + line_no << ": " << line << "\n";
+                line_offset += chunk.lines;
+                stats.unparsable += chunk.unparsable;
+                stats.joined += chunk.joined;
+                stats.unjoined += chunk.unjoined;
+                stats.records += chunk.records.size();
+                for (const auto &record : chunk.records)
+                {
+                    records.push_back(record);
+                    if (records.size() == run_capacity)
+                        spill();
+                }
+            }
+        }
+        spill();
+        std::vector<EdgeRecord>().swap(records);
+        stats.runs = edge_runs.size();
+        stats.runTime = elapsed(run_start);
+
+        auto merge_start = std::chrono::steady_clock::now();
+        const std::size_t read_buffer = std::max(MIN_READ_BUFFER, budget / std::max<std::size_t>(1, edge_runs.size()));
+
+        // 2. слияние id вершин: нумерация по возрастанию id, как у CompactGraph::build
+        const std::string ids_name = temporary.create(".ids.tmp");
+        std::uint64_t n = 0;
+        {
+            std::ofstream out(ids_name, std::ios::binary | std::ios::trunc);
+            std::vector<NodeId> block;
+            block.reserve(WRITE_BLOCK);
+            NodeId last_id = 0;
+            mergeRuns<NodeId>(id_runs, read_buffer, std::less<NodeId>(), [&](NodeId id) {
+                if (n > 0 && id == last_id) return;
+                last_id = id;
+                block.push_back(id);
+                ++n;
+                if (block.size() == WRITE_BLOCK)
+                    writeBlock(out, block, ids_name);
+            });
+            writeBlock(out, block, ids_name);
+        }
+        if (n >= Domain::INVALID_NODE_INDEX)
+            throw std::runtime_error("Too many nodes for CompactGraph: " + edge_list);
+
+        // 3. раскладка выходного файла: под ребра резервируется место до схлопывания повторов между прогонами
+        const LinkParameterStore defaults(settings.encoding);
+        std::vector<SectionEntry> sections(SECTION_COUNT);
+        std::vector<std::uint64_t> reserved(SECTION_COUNT, 0);
+        for (int s = 0; s < SECTION_COUNT; ++s)
+        {
+            sections[s].kind = s;
+            sections[s].materialized = 1;
+        }
+        sections[NODE_IDS].elementSize = sizeof(NodeId);
+        sections[NODE_IDS].count = n;
+        sections[SORTED_IDS].elementSize = sizeof(NodeId);
+        sections[SORTED_INDEX].elementSize = sizeof(Domain::NodeIndex);
+        sections[OFFSETS].elementSize = sizeof(CompactGraph::EdgeIndex);
+        sections[OFFSETS].count = n + 1;
+        sections[TARGETS].elementSize = sizeof(Domain::NodeIndex);
+        reserved[NODE_IDS] = n * sizeof(NodeId);
+        reserved[OFFSETS] = (n + 1) * sizeof(CompactGraph::EdgeIndex);
+        reserved[TARGETS] = reserved_edges * sizeof(Domain::NodeIndex);
+        for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+        {
+            const auto &column = defaults.getColumn(static_cast<LinkParameterStore::Column>(c));
+            auto &entry = sections[PARAMETERS + c];
+            entry.elementSize = static_cast<std::uint32_t>(ParameterColumn::getEncodedSize(column.getEncoding()));
+            entry.encoding = column.getEncoding();
+            entry.defaultValue = column.getDefaultValue();
+            // без синтеза у ребер есть только задержка, остальные столбцы заведомо не выделяются
+            if (settings.synthesizeParameters || c == LinkParameterStore::LATENCY)
+                reserved[PARAMETERS + c] = reserved_edges * entry.elementSize;
+        }
+        std::uint64_t offset = firstSectionOffset();
+        for (int s = 0; s < SECTION_COUNT; ++s)
+        {
+            sections[s].offset = offset;
+            offset = alignUp(offset + reserved[s]);
+        }
+
+        // файл сразу получает полный размер: разделы без данных не выходят за его конец
+        const std::string partial = temporary.create(".partial.tmp");
+        {
+            std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+            out.seekp(static_cast<std::streamoff>(offset - 1));
+            out.put('\0');
+            if (!out)
+                throw std::runtime_error("Cannot write file: " + partial);
+        }
+
+        // 4. слияние ребер прямо в разделы CSR: источники идут по возрастанию, поэтому смещения
+        // пишутся одним проходом, а индекс цели ищется по отображенному списку id
+        std::uint64_t m = 0;
+        {
+            MappedFile id_file(ids_name, MappedFile::RANDOM);
+            const auto *ids = reinterpret_cast<const NodeId *>(id_file.data());
+            {
+                SectionWriter<NodeId> node_writer(partial, sections[NODE_IDS].offset);
+                for (std::uint64_t i = 0; i < n; ++i)
+                    node_writer.push(ids[i]);
+                node_writer.close();
+            }
+
+            SectionWriter<CompactGraph::EdgeIndex> offset_writer(partial, sections[OFFSETS].offset);
+            SectionWriter<Domain::NodeIndex> target_writer(partial, sections[TARGETS].offset);
+            std::vector<std::unique_ptr<ColumnWriter>> columns(LinkParameterStore::COLUMN_COUNT);
+            for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+                if (reserved[PARAMETERS + c] > 0)
+                    columns[c] = std::make_unique<ColumnWriter>(
+                        partial, sections[PARAMETERS + c].offset,
+                        static_cast<ParameterColumn::Encoding>(sections[PARAMETERS + c].encoding),
+                        sections[PARAMETERS + c].defaultValue);
+
+            std::uint64_t next_node = 0;
+            auto emit = [&](const EdgeRecord &edge) {
+                if (m >= CompactGraph::INVALID_EDGE)
+                    throw std::runtime_error("Too many edges for CompactGraph: " + edge_list);
+                while (next_node < n && ids[next_node] <= edge.source)
+                {
+                    offset_writer.push(static_cast<CompactGraph::EdgeIndex>(m));
+                    ++next_node;
+                }
+                target_writer.push(static_cast<Domain::NodeIndex>(std::lower_bound(ids, ids + n, edge.target) - ids));
+                for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+                    if (columns[c]) columns[c]->push(columnValue(edge.params, c));
+                ++m;
+            };
+
+            // повтор ребра из разных прогонов: последним приходит более поздний прогон, он и остается
+            bool has_edge = false;
+            EdgeRecord last;
+            mergeRuns<EdgeRecord>(edge_runs, read_buffer, edgeLess, [&](const EdgeRecord &edge) {
+                if (has_edge && !sameEdge(edge, last))
+                    emit(last);
+                last = edge;
+                has_edge = true;
+            });
+            if (has_edge)
+                emit(last);
+            for (; next_node <= n; ++next_node)
+                offset_writer.push(static_cast<CompactGraph::EdgeIndex>(m));
+
+            offset_writer.close();
+            target_writer.close();
+            for (int c = 0; c < LinkParameterStore::COLUMN_COUNT; ++c)
+            {
+                sections[PARAMETERS + c].count = m;
+                sections[PARAMETERS + c].materialized = columns[c] && columns[c]->isMaterialized() ? 1 : 0;
+                if (columns[c]) columns[c]->close();
+            }
+            sections[TARGETS].count = m;
+        }
+
+        // 5. заголовок с контрольными суммами, затем замена выходного файла целиком
+        FileHeader header = makeHeader();
+        header.nodeCount = n;
+        header.edgeCount = m;
+        header.parameterEncoding = settings.encoding;
+        {
+            MappedFile written(partial, MappedFile::SEQUENTIAL);
+            header.dataChecksum = dataChecksum(written.data(), sections);
+        }
+        header.headerChecksum = headerChecksum(header, sections);
+        {
+            std::fstream out(partial, std::ios::binary | std::ios::in | std::ios::out);
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(sections.data()),
+                      static_cast<std::streamsize>(sections.size() * sizeof(SectionEntry)));
+            if (!out)
+                throw std::runtime_error("Cannot write file: " + partial);
+        }
+#ifdef _WIN32
+        std::remove(output.c_str());
+#endif
+        if (std::rename(partial.c_str(), output.c_str()) != 0)
+            throw std::runtime_error("Cannot replace file: " + output);
+
+        stats.nodes = n;
+        stats.edges = m;
+        stats.mergeTime = elapsed(merge_start);
+        return stats;
+    }
+}
@@ -1,17 +1,23 @@
 #include "infrastructure/FileGraphRepository.h"
+#include "infrastructure/BinaryGraphFormat.h"
+#include "infrastructure/EdgeListParser.h"
+#include "infrastructure/GraphFileFormat.h"
+#include "infrastructure/LinkMetricsTable.h"
+#include "infrastructure/MappedFile.h"
+#include "infrastructure/NodeCoordinateFile.h"
+#include "infrastructure/ThreadPool.h"
 #include "domain/NetworkGraph.h"
 #include "domain/WeightCalculator.h"
-#include <fstream>
-#include <sstream>
+#include <chrono>
 #include <iostream>
+#include <memory>
 #include <algorithm>
+#include <string_view>
+#include <thread>
 #include <vector>
-#include <cctype>
 #include <windows.h>
-#include <random>
 
 namespace Infrastructure {
-
 static std::string cp1251_to_utf8(const std::string& src) {
     if (src.empty()) return {};
     int wlen = MultiByteToWideChar(1251, 0, src.data(), static_cast<int>(src.size()), nullptr, 0);
@@ -25,178 +31,247 @@ static std::string cp1251_to_utf8(const std::string& src) {
     return std::string(u8buf.data(), u8len);
 }
 
-Domain::NetworkGraphPtr FileGraphRepository::loadGraph(const std::string& filename) {
-    auto graph = std::make_shared<Domain::NetworkGraph>("Multi-Param Social Network");
+namespace {
+
+constexpr std::size_t MIN_CHUNK = 1 << 20;    // меньшие куски не окупают запуск задачи
+constexpr std::uint64_t CACHE_REVISION = 2;   // увеличивается при изменении правил разбора
+
+constexpr const char *GRAPH_NAME = "Multi-Param Social Network";
+
+} // namespace
 
-    std::ifstream in(filename, std::ios::binary);
-    if (!in.is_open()) {
-        throw std::runtime_error("Cannot open file: " + filename);
+Domain::NetworkGraphPtr FileGraphRepository::loadGraph(const std::string& filename) {
+    auto load_start = std::chrono::steady_clock::now();
+    const GraphCache cache(cacheDirectory);
+    std::uint64_t cache_key = 0;
+    if (!cacheDirectory.empty()) {
+        // формат определяется по содержимому и расширению: содержимое входит в ключ, расширение - сюда
+        // файл метрик входит в ключ своим содержимым
+        const std::uint64_t options[] = {CACHE_REVISION, static_cast<std::uint64_t>(encoding),
+                                         synthesizeParameters ? 1u : 0u, seed,
+                                         static_cast<std::uint64_t>(GraphFileFormat::fromExtension(filename)),
+                                         metricsFile.empty() ? 0 : cache.getKey(metricsFile, 0)};
+        cache_key = cache.getKey(filename, BinaryGraphFormat::checksum(
+            options, sizeof(options), BinaryGraphFormat::CHECKSUM_SEED));
+        if (auto cached = cache.load(cache_key, GRAPH_NAME)) {
+            std::cout << "Кэш графа: попадание (" << cache.getEntryPath(cache_key) << "), "
+                      << cached->getNodeCount() << " узлов, " << cached->getEdgeCount() << " связей, загрузка "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count()
+                      << " мс\n";
+            attachCoordinates(*cached);
+            return cached;
+        }
     }
-    std::string raw;
-    in.seekg(0, std::ios::end);
-    raw.resize(static_cast<size_t>(in.tellg()));
-    in.seekg(0, std::ios::beg);
-    in.read(&raw[0], static_cast<std::streamsize>(raw.size()));
-    in.close();
-
-    std::string text;
-    bool isUtf8 = false;
-    if (raw.size() >= 3 &&
-        static_cast<unsigned char>(raw[0]) == 0xEF &&
-        static_cast<unsigned char>(raw[1]) == 0xBB &&
-        static_cast<unsigned char>(raw[2]) == 0xBF) {
-        isUtf8 = true;
-        text = raw.substr(3);
+
+    auto graph = std::make_shared<Domain::NetworkGraph>(GRAPH_NAME, encoding);
+
+    // файл отображается в память и разбирается на месте, без копий в строки
+    MappedFile file(filename);
+    std::string_view text(file.data(), file.size());
+
+    std::string converted;
+    if (text.size() >= 3 &&
+        static_cast<unsigned char>(text[0]) == 0xEF &&
+        static_cast<unsigned char>(text[1]) == 0xBB &&
+        static_cast<unsigned char>(text[2]) == 0xBF) {
+        text.remove_prefix(3);
     } else {
+        // кодировка определяется по началу файла: списки ребер - ASCII, cp1251 встречается в малых CSV
+        const std::size_t probe = std::min<std::size_t>(text.size(), MIN_CHUNK);
         size_t high = 0;
-        for (unsigned char c : raw) if (c >= 0x80) ++high;
-        if (high > raw.size() / 20) {
-            text = cp1251_to_utf8(raw);
-        } else {
-            text = raw;
+        for (std::size_t i = 0; i < probe; ++i) if (static_cast<unsigned char>(text[i]) >= 0x80) ++high;
+        if (high > probe / 20) {
+            converted = cp1251_to_utf8(std::string(text));
+            text = converted;
         }
     }
 
-    std::vector<std::string> lines;
-    {
-        std::string cur;
-        for (size_t i = 0; i < text.size(); ++i) {
-            char c = text[i];
-            if (c == '\r') continue;
-            if (c == '\n') {
-                lines.push_back(cur);
-                cur.clear();
-            } else cur.push_back(c);
+    if (verbose) {
+        std::cout << "Показ первых строк файла (" << filename << "):\n";
+        std::size_t pos = 0;
+        for (int i = 0; i < 10 && pos < text.size(); ++i) {
+            std::size_t next = std::min(text.find('\n', pos), text.size());
+            std::string_view line = text.substr(pos, next - pos);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            std::cout << (i + 1) << ": " << line << "\n";
+            pos = next + 1;
         }
-        if (!cur.empty()) lines.push_back(cur);
     }
 
-    std::cout << "Показ первых строк файла (" << filename << "):\n";
-    for (size_t i = 0; i < lines.size() && i < 10; ++i) {
-        std::cout << (i+1) << ": " << lines[i] << "\n";
+    // заголовок формата разбирается сразу, строки ребер после него - кусками
+    const auto format = GraphFileFormat::detect(filename, text.data(), text.data() + text.size());
+    text.remove_prefix(format.headerBytes);
+    auto parser_options = format.getParserOptions(synthesizeParameters, seed);
+    std::unique_ptr<LinkMetricsTable> metrics;
+    if (!metricsFile.empty()) {
+        metrics = std::make_unique<LinkMetricsTable>(metricsFile);
+        parser_options.metrics = metrics.get();
     }
+    std::cout << "Формат файла: " << GraphFileFormat::getName(format.kind)
+              << (format.symmetric ? " (неориентированный)" : "");
+    if (format.declaredNodes || format.declaredEdges)
+        std::cout << ", по заголовку " << format.declaredNodes << " узлов, " << format.declaredEdges << " связей";
+    std::cout << "\n";
 
-    auto trim = [](std::string &s) {
-        s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](unsigned char ch){ return !std::isspace(ch); }));
-        s.erase(std::find_if(s.rbegin(), s.rend(), [](unsigned char ch){ return !std::isspace(ch); }).base(), s.end());
-    };
-
-    // генератор случайных чисел для заполнения многопараметрических весов
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> util_dist(0.1, 0.8);    // загрузка канала 10-80%
-    std::uniform_real_distribution<> loss_dist(0.0, 0.05);   // потери пакетов 0-5%
-    std::uniform_real_distribution<> rel_dist(0.85, 0.99);   // надежность 85-99%
-    std::uniform_real_distribution<> bw_dist(50.0, 500.0);   // пропускная способность 50-500 Мбит/с
-    std::uniform_real_distribution<> cost_dist(0.5, 5.0);    // стоимость 0.5-5.0
-
-    int edges_loaded = 0;
-    int unparsable = 0;
-    int max_node_id = 0;
-    int line_no = 0;
-
-    for (const auto& rawline : lines) {
-        ++line_no;
-        std::string line = rawline;
-        trim(line);
-        if (line.empty()) continue;
-        if (line[0] == '#' || line[0] == '%' || line[0] == '/' ) continue;
-
-        // нормализация разделителей
-        for (char &c : line) if (c == '\t' || c == ',') c = ' ';
-
-        std::istringstream iss(line);
-        int u = 0, v = 0;
-        double file_weight = 1.0;
-        
-        if (!(iss >> u >> v)) {
-            ++unparsable;
-            if (line_no <= 20) std::cerr << "Warning: cannot parse line " << line_no << ": " << rawline << "\n";
-            continue;
-        }
-        
-        // пытаемся прочитать вес из файла (если есть)
-        if (!(iss >> file_weight)) {
-            file_weight = 1.0; // значение по умолчанию
-        }
+    // куски по границам строк разбираются параллельно
+    auto parse_start = std::chrono::steady_clock::now();
+    const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t chunk_count = std::max<std::size_t>(1, std::min(threads * 4, text.size() / MIN_CHUNK));
+    std::vector<const char *> bounds{text.data()};
+    const char *text_end = text.data() + text.size();
+    for (std::size_t c = 1; c < chunk_count; ++c) {
+        const char *target = text.data() + text.size() * c / chunk_count;
+        if (target <= bounds.back()) continue;
+        const char *next = EdgeListParser::nextLine(target, text_end);
+        if (next == text_end) break;
+        bounds.push_back(next);
+    }
+    bounds.push_back(text_end);
 
-        // создаем многопараметрическую структуру LinkParameters
-        Domain::LinkParameters params;
-        
-        // базовые параметры из файла
-        params.latency = file_weight;           // используем файловый вес как задержку
-        params.cost = file_weight * cost_dist(gen); // стоимость пропорциональна задержке
-        
-        // дополнительные параметры (генерируем реалистичные значения)
-        params.bandwidth = bw_dist(gen);        // пропускная способность
-        params.packet_loss = loss_dist(gen);    // потери пакетов
-        params.utilization = util_dist(gen);    // загрузка канала
-        params.reliability = rel_dist(gen);     // надежность
-
-        // используем новый API с LinkParameters
-        graph->ensureNode(u);
-        graph->ensureNode(v);
-        graph->addEdge(u, v, params);  // ← используем перегруженную версию с LinkParameters
-
-        ++edges_loaded;
-        max_node_id = std::max(max_node_id, std::max(u, v));
+    // параметры ребра зависят только от seed и самого ребра, поэтому у всех кусков seed общий
+    std::vector<EdgeListParser::Chunk> chunks(bounds.size() - 1);
+    if (chunks.size() == 1) {
+        chunks[0] = EdgeListParser::parse(bounds[0], bounds[1], parser_options);
+    } else {
+        ThreadPool pool(std::min(threads, chunks.size()));
+        std::vector<std::future<EdgeListParser::Chunk>> pending;
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+            pending.push_back(pool.enqueue(EdgeListParser::parse, bounds[c], bounds[c + 1], parser_options));
+        for (std::size_t c = 0; c < chunks.size(); ++c)
+            chunks[c] = pending[c].get();
     }
 
+    // ребра всех кусков в порядке файла добавляются в граф одним пакетом
+    std::size_t edges_loaded = 0;
+    for (const auto &chunk : chunks) edges_loaded += chunk.records.size();
+    std::vector<Domain::EdgeRecord> records;
+    records.reserve(edges_loaded);
+
+    int unparsable = 0;
+    Domain::NodeId max_node_id = 0;
+    std::size_t line_offset = format.headerLines;
+    std::size_t joined = 0, unjoined = 0;
+    for (auto &chunk : chunks) {
+        joined += chunk.joined;
+        for (const auto &[u, v] : chunk.unjoinedLinks)
+            if (unjoined++ < EdgeListParser::WARNING_LINES)
+                std::cerr << "Warning: no metrics for link " << u << " -> " << v << "\n";
+        unjoined += chunk.unjoined - chunk.unjoinedLinks.size();
+        records.insert(records.end(), chunk.records.begin(), chunk.records.end());
+        std::vector<Domain::EdgeRecord>().swap(chunk.records);
+        unparsable += chunk.unparsable;
+        max_node_id = std::max(max_node_id, chunk.maxNodeId);
+        for (const auto &[line_no, line] : chunk.warnings)
+            if (line_offset + line_no <= EdgeListParser::WARNING_LINES)
+                std::cerr << "Warning: cannot parse line " << line_offset + line_no << ": " << line << "\n";
+        line_offset += chunk.lines;
+    }
+
+    auto parse_end = std::chrono::steady_clock::now();
+    graph->reserve(format.declaredNodes, records.size());
+    graph->addEdges(records);
+    auto build_end = std::chrono::steady_clock::now();
+
     std::cout << "Успешно загружен многопараметрический граф: " << graph->getNodeCount()
               << " узлов, " << edges_loaded << " связей\n";
     std::cout << "Максимальный ID узла: " << max_node_id << "\n";
-    std::cout << "Параметры связей: latency, bandwidth, packet_loss, utilization, cost, reliability\n";
+    const double parse_ms = std::chrono::duration<double, std::milli>(parse_end - parse_start).count();
+    std::cout << "Разбор файла: " << parse_ms << " мс (" << chunks.size() << " кусков, "
+              << (parse_ms > 0.0 ? text.size() / 1048576.0 / (parse_ms / 1000.0) : 0.0) << " МБ/с), построение графа: "
+              << std::chrono::duration<double, std::milli>(build_end - parse_end).count() << " мс\n";
+    if (synthesizeParameters)
+        std::cout << "Параметры связей: latency, bandwidth, packet_loss, utilization, cost, reliability\n";
+    else
+        std::cout << "Параметры связей: latency (из файла)\n";
     
     if (unparsable > 0) {
         std::cout << "Нераспаршенных строк: " << unparsable << "\n";
     }
+    if (metrics) {
+        std::cout << "Метрики связей (" << metricsFile << "): присоединены к " << joined << " связям, без метрик "
+                  << unjoined << " (значения из списка ребер), строк без связи " << metrics->getUnusedRowCount() << "\n";
+        if (!metrics->getSkippedColumns().empty() || metrics->getUnparsable() > 0)
+            std::cout << "  пропущено столбцов: " << metrics->getSkippedColumns().size() << ", нераспаршенных строк: "
+                      << metrics->getUnparsable() << "\n";
+    }
+
+    if (!cacheDirectory.empty()) {
+        try {
+            cache.store(cache_key, *graph);
+            std::cout << "Кэш графа: промах, граф сохранен в кэш; загрузка с разбором и записью "
+                      << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load_start).count()
+                      << " мс\n";
+        } catch (const std::exception &e) {
+            std::cout << "Кэш графа: промах, граф не сохранен: " << e.what() << "\n";
+        }
+    }
 
     // демонстрация многопараметрической системы для первых 3 ребер
-    if (edges_loaded >= 3) {
+    if (verbose && edges_loaded >= 3) {
         std::cout << "\nДЕМОНСТРАЦИЯ МНОГОПАРАМЕТРИЧЕСКИХ ВЕСОВ\n";
         
         // получаем список всех узлов и ребер для демонстрации
         auto node_ids = graph->getAllNodeIds();
         if (node_ids.size() >= 2) {
-            int demo_node = node_ids[0];
-            auto neighbors = graph->getNeighbors(demo_node);
+            auto demo_node = node_ids[0];
+            auto neighbors = graph->neighbors(demo_node);
             
             if (!neighbors.empty()) {
-                int demo_target = neighbors[0];
+                auto demo_edge = *neighbors.begin();
+                auto demo_target = demo_edge.getTarget();
+                
+                auto params = demo_edge.getParameters();
+                
+                std::cout << "Пример ребра " << demo_node << " → " << demo_target << ":\n";
+                std::cout << "  latency: " << params.latency << " ms\n";
+                std::cout << "  bandwidth: " << params.bandwidth << " Mbps\n";
+                std::cout << "  packet_loss: " << (params.packet_loss * 100) << "%\n";
+                std::cout << "  utilization: " << (params.utilization * 100) << "%\n";
+                std::cout << "  cost: " << params.cost << "\n";
+                std::cout << "  reliability: " << (params.reliability * 100) << "%\n";
                 
-                try {
-                    auto params = graph->getEdgeParameters(demo_node, demo_target);
-                    
-                    std::cout << "Пример ребра " << demo_node << " → " << demo_target << ":\n";
-                    std::cout << "  latency: " << params.latency << " ms\n";
-                    std::cout << "  bandwidth: " << params.bandwidth << " Mbps\n";
-                    std::cout << "  packet_loss: " << (params.packet_loss * 100) << "%\n";
-                    std::cout << "  utilization: " << (params.utilization * 100) << "%\n";
-                    std::cout << "  cost: " << params.cost << "\n";
-                    std::cout << "  reliability: " << (params.reliability * 100) << "%\n";
-                    
-                    // демонстрация разных стратегий агрегации
-                    std::cout << "\nАгрегированные веса по разным стратегиям:\n";
-                    auto strategies = {
-                        Domain::WeightCalculator::MINIMIZE_LATENCY,
-                        Domain::WeightCalculator::BALANCE_LOAD,
-                        Domain::WeightCalculator::MAXIMIZE_BANDWIDTH,
-                        Domain::WeightCalculator::MINIMIZE_COST
-                    };
-                    
-                    for (auto strategy : strategies) {
-                        double weight = graph->getEdgeWeight(demo_node, demo_target, strategy);
-                        std::cout << "Стратегия " << strategy << ": " << weight << "\n";
-                    }
-                    
-                } catch (const std::exception& e) {
-                    std::cout << "Ошибка получения параметров: " << e.what() << "\n";
+                // демонстрация разных стратегий агрегации
+                std::cout << "\nАгрегированные веса по разным стратегиям:\n";
+                auto strategies = {
+                    Domain::WeightCalculator::MINIMIZE_LATENCY,
+                    Domain::WeightCalculator::BALANCE_LOAD,
+                    Domain::WeightCalculator::MAXIMIZE_BANDWIDTH,
+                    Domain::WeightCalculator::MINIMIZE_COST
+                };
+                
+                for (auto strategy : strategies) {
+                    double weight = Domain::WeightCalculator::calculateCompositeWeight(params, strategy);
+                    std::cout << "Стратегия " << strategy << ": " << weight << "\n";
                 }
             }
         }
     }
 
+    attachCoordinates(*graph);
     return graph;
 }
 
+void FileGraphRepository::attachCoordinates(Domain::NetworkGraph &graph) const {
+    if (coordinateFile.empty()) return;
+    const NodeCoordinateFile file(coordinateFile);
+    const auto &coordinates = file.getCoordinates();
+    graph.setCoordinates(coordinates);
+    std::cout << "Координаты узлов (" << coordinateFile << "): " << coordinates->size() << " точек, "
+              << (coordinates->getSystem() == Domain::NodeCoordinates::GEOGRAPHIC ? "широта и долгота" : "плоские");
+    if (file.getUnparsable() > 0)
+        std::cout << ", нераспаршенных строк: " << file.getUnparsable();
+    std::cout << "\n";
+
+    // проверка допустимости эвристики сразу при загрузке; построенная эвристика остается в кэше графа
+    const auto strategy = Domain::WeightCalculator::MINIMIZE_LATENCY;
+    const auto heuristic = graph.getGeometricHeuristic(graph.getCompactGraph(), strategy);
+    std::cout << "Эвристика A* (" << Domain::WeightCalculator::getStrategyName(strategy) << "): ";
+    if (heuristic->isUsable())
+        std::cout << "оценка = расстояние * " << heuristic->getScale() << "\n";
+    else
+        std::cout << "отключена, оценка нулевая (узлов без координат " << heuristic->getMissingNodes()
+                  << ", ребер с недопустимым весом " << heuristic->getInvalidEdges() << ", ребер нулевого веса "
+                  << heuristic->getZeroWeightEdges() << ")\n";
+}
+
 } // namespace Infrastructure
\ No newline at end of file
@@ -10,7 +10,7 @@
 namespace Infrastructure
 {
     HeuristicResult GeneticAlgorithm::optimize(const Domain::NetworkGraphPtr &graph,
-                                               const std::vector<std::pair<int, int>> &demands)
+                                               const std::vector<Domain::NodePair> &demands)
     {
         auto startTime = std::chrono::high_resolution_clock::now();
         HeuristicResult result;
@@ -23,16 +23,19 @@ namespace Infrastructure
             return result;
         }
 
-        auto [start, end] = demands[0];
+        auto [start_id, end_id] = demands[0];
 
-        if (!graph->hasNode(start) || !graph->hasNode(end))
+        // дальше алгоритм работает только с плотными индексами графа
+        const Domain::NodeIndex start = graph->findIndex(start_id);
+        const Domain::NodeIndex end = graph->findIndex(end_id);
+        if (start == Domain::INVALID_NODE_INDEX || end == Domain::INVALID_NODE_INDEX)
         {
-            std::cout << "FAIL Ошибка: узлы " << start << " или " << end << " не найдены\n";
+            std::cout << "FAIL Ошибка: узлы " << start_id << " или " << end_id << " не найдены\n";
             result.success = false;
             return result;
         }
 
-        std::cout << "Запуск оптимизированного ГА: " << start << " → " << end << "\n";
+        std::cout << "Запуск оптимизированного ГА: " << start_id << " → " << end_id << "\n";
 
         // инициализация популяции
         auto population = initializePopulation(graph, start, end);
@@ -47,10 +50,13 @@ namespace Infrastructure
 
         Chromosome global_best;
         global_best.fitness = std::numeric_limits<double>::max();
+        std::size_t population_bytes = 0;
 
         // основной цикл генетического алгоритма
         for (size_t gen_count = 0; gen_count < generations; ++gen_count)
         {
+            population_bytes = std::max(population_bytes, getPopulationBytes(population));
+
             // оценка приспособленности
             int valid_count = 0;
             for (auto &chromosome : population)
@@ -166,11 +172,14 @@ namespace Infrastructure
             result.objective = global_best.fitness;
             result.executionTime = duration.count() / 1000000.0;
             result.algorithmName = "Optimized Genetic Algorithm";
+            // при смене поколения старая и новая популяции существуют одновременно
+            result.scratchBytes = 2 * population_bytes + visitStamp.capacity() * sizeof(std::uint32_t);
 
             // преобразование пути
             for (size_t i = 0; i + 1 < global_best.path.size(); ++i)
             {
-                result.path.emplace_back(global_best.path[i], global_best.path[i + 1]);
+                result.path.emplace_back(graph->getNodeId(global_best.path[i]),
+                                         graph->getNodeId(global_best.path[i + 1]));
             }
 
             std::cout << "OK ГА завершен: cost=" << global_best.fitness
@@ -186,8 +195,16 @@ namespace Infrastructure
         return result;
     }
 
+    std::size_t GeneticAlgorithm::getPopulationBytes(const std::vector<Chromosome> &population)
+    {
+        std::size_t bytes = population.capacity() * sizeof(Chromosome);
+        for (const auto &chromosome : population)
+            bytes += chromosome.path.capacity() * sizeof(Domain::NodeIndex);
+        return bytes;
+    }
+
     std::vector<GeneticAlgorithm::Chromosome> GeneticAlgorithm::initializePopulation(
-        const Domain::NetworkGraphPtr &graph, int start, int end)
+        const Domain::NetworkGraphPtr &graph, Domain::NodeIndex start, Domain::NodeIndex end)
     {
         std::vector<Chromosome> population;
         population.reserve(populationSize);
@@ -197,7 +214,7 @@ namespace Infrastructure
 
         for (int attempt = 0; attempt < MAX_ATTEMPTS && population.size() < populationSize; ++attempt)
         {
-            std::vector<int> path;
+            Path path;
 
             // чередуем стратегии для разнообразия
             if (attempt % 3 == 0)
@@ -226,7 +243,7 @@ namespace Infrastructure
 
     double GeneticAlgorithm::calculateFitness(const Chromosome &chromosome,
                                               const Domain::NetworkGraphPtr &graph,
-                                              int start, int end)
+                                              Domain::NodeIndex start, Domain::NodeIndex end)
     {
         // проверка валидности пути
         if (chromosome.path.empty() ||
@@ -243,7 +260,7 @@ namespace Infrastructure
     GeneticAlgorithm::Chromosome GeneticAlgorithm::crossover(const Chromosome &parent1,
                                                              const Chromosome &parent2,
                                                              const Domain::NetworkGraphPtr &graph,
-                                                             int start, int end)
+                                                             Domain::NodeIndex start, Domain::NodeIndex end)
     {
         // упрощенный одноточечный кроссовер
         if (parent1.path.size() < 3 || parent2.path.size() < 3)
@@ -255,11 +272,11 @@ namespace Infrastructure
         size_t crossover_point = dist(gen);
 
         // берем первую часть от parent1
-        std::vector<int> child_path;
+        Path child_path;
         child_path.insert(child_path.end(), parent1.path.begin(), parent1.path.begin() + crossover_point);
 
         // пытаемся найти продолжение из parent2
-        int last_node = child_path.back();
+        Domain::NodeIndex last_node = child_path.back();
         auto it = std::find(parent2.path.begin(), parent2.path.end(), last_node);
 
         if (it != parent2.path.end() && it + 1 != parent2.path.end())
@@ -287,7 +304,7 @@ namespace Infrastructure
 
     void GeneticAlgorithm::mutate(Chromosome &chromosome,
                                   const Domain::NetworkGraphPtr &graph,
-                                  int start, int end)
+                                  Domain::NodeIndex start, Domain::NodeIndex end)
     {
         if (chromosome.path.size() < 3)
             return;
@@ -304,8 +321,8 @@ namespace Infrastructure
             size_t pos = pos_dist(gen);
             if (pos < chromosome.path.size() - 1)
             {
-                int from = chromosome.path[pos];
-                int to = chromosome.path[pos + 1];
+                Domain::NodeIndex from = chromosome.path[pos];
+                Domain::NodeIndex to = chromosome.path[pos + 1];
 
                 // пытаемся найти альтернативный путь
                 auto new_segment = generateRandomPathBFS(graph, from, to);
@@ -324,12 +341,11 @@ namespace Infrastructure
             size_t pos = pos_dist(gen);
             if (pos > 0 && pos < chromosome.path.size() - 1)
             {
-                int prev = chromosome.path[pos - 1];
-                int next = chromosome.path[pos + 1];
+                Domain::NodeIndex prev = chromosome.path[pos - 1];
+                Domain::NodeIndex next = chromosome.path[pos + 1];
 
                 // проверяем, есть ли прямое соединение
-                auto neighbors = graph->getNeighbors(prev);
-                if (std::find(neighbors.begin(), neighbors.end(), next) != neighbors.end())
+                if (graph->findEdgeAt(prev, next))
                 {
                     chromosome.path.erase(chromosome.path.begin() + pos);
                 }
@@ -347,16 +363,16 @@ namespace Infrastructure
     }
 
     // быстрая генерация пути с помощью BFS
-    std::vector<int> GeneticAlgorithm::generateRandomPathBFS(const Domain::NetworkGraphPtr &graph,
-                                                             int start, int end)
+    GeneticAlgorithm::Path GeneticAlgorithm::generateRandomPathBFS(const Domain::NetworkGraphPtr &graph,
+                                                                   Domain::NodeIndex start, Domain::NodeIndex end)
     {
         if (start == end)
             return {start};
 
-        std::queue<std::vector<int>> paths;
-        std::unordered_set<int> visited;
+        std::queue<Path> paths;
+        resetVisited(graph);
         paths.push({start});
-        visited.insert(start);
+        markVisited(start);
 
         const size_t MAX_PATHS = 5000;
         size_t paths_explored = 0;
@@ -367,23 +383,23 @@ namespace Infrastructure
             paths.pop();
             paths_explored++;
 
-            int current_node = current_path.back();
+            Domain::NodeIndex current_node = current_path.back();
 
             if (current_node == end)
             {
                 return current_path;
             }
 
-            auto neighbors = graph->getNeighbors(current_node);
-
             // ограничиваем количество проверяемых соседей для производительности
-            size_t neighbors_to_check = std::min(size_t(5), neighbors.size());
-            for (size_t i = 0; i < neighbors_to_check; ++i)
+            size_t neighbors_to_check = 5;
+            for (const auto &edge : graph->neighborsAt(current_node))
             {
-                int neighbor = neighbors[i];
-                if (visited.find(neighbor) == visited.end())
+                if (neighbors_to_check-- == 0)
+                    break;
+                Domain::NodeIndex neighbor = edge.getNeighborIndex();
+                if (!isVisited(neighbor))
                 {
-                    visited.insert(neighbor);
+                    markVisited(neighbor);
                     auto new_path = current_path;
                     new_path.push_back(neighbor);
                     paths.push(new_path);
@@ -399,16 +415,16 @@ namespace Infrastructure
     }
 
     // генерация пути с помощью DFS (для разнообразия)
-    std::vector<int> GeneticAlgorithm::generateRandomPathDFS(const Domain::NetworkGraphPtr &graph,
-                                                             int start, int end)
+    GeneticAlgorithm::Path GeneticAlgorithm::generateRandomPathDFS(const Domain::NetworkGraphPtr &graph,
+                                                                   Domain::NodeIndex start, Domain::NodeIndex end)
     {
         if (start == end)
             return {start};
 
-        std::vector<int> path;
-        std::unordered_set<int> visited;
+        Path path;
+        resetVisited(graph);
 
-        std::function<bool(int)> dfs = [&](int current) -> bool
+        std::function<bool(Domain::NodeIndex)> dfs = [&](Domain::NodeIndex current) -> bool
         {
             if (current == end)
             {
@@ -416,19 +432,23 @@ namespace Infrastructure
                 return true;
             }
 
-            if (visited.find(current) != visited.end() || path.size() > 15)
+            if (isVisited(current) || path.size() > 15)
             {
                 return false;
             }
 
-            visited.insert(current);
+            markVisited(current);
             path.push_back(current);
 
-            auto neighbors = graph->getNeighbors(current);
-            std::vector<int> shuffled = neighbors;
+            // собственный случайный порядок обхода нужен каждому уровню рекурсии
+            auto range = graph->neighborsAt(current);
+            Path shuffled;
+            shuffled.reserve(range.size());
+            for (const auto &edge : range)
+                shuffled.push_back(edge.getNeighborIndex());
             std::shuffle(shuffled.begin(), shuffled.end(), gen);
 
-            for (int neighbor : shuffled)
+            for (Domain::NodeIndex neighbor : shuffled)
             {
                 if (dfs(neighbor))
                 {
@@ -448,73 +468,54 @@ namespace Infrastructure
     }
 
     // жадная генерация пути
-    std::vector<int> GeneticAlgorithm::generateGreedyPath(const Domain::NetworkGraphPtr &graph,
-                                                          int start, int end)
+    GeneticAlgorithm::Path GeneticAlgorithm::generateGreedyPath(const Domain::NetworkGraphPtr &graph,
+                                                                Domain::NodeIndex start, Domain::NodeIndex end)
     {
-        std::vector<int> path = {start};
-        std::unordered_set<int> visited = {start};
-        int current = start;
+        Path path = {start};
+        resetVisited(graph);
+        markVisited(start);
+        Domain::NodeIndex current = start;
 
         const size_t MAX_STEPS = 5000;
+        const auto &weights = graph->getEdgeWeights(strategy);
 
         for (size_t step = 0; step < MAX_STEPS && current != end; ++step)
         {
-            auto neighbors = graph->getNeighbors(current);
+            auto neighbors = graph->neighborsAt(current);
             if (neighbors.empty())
                 break;
 
             // ищем соседа который приближает к цели
-            int best_neighbor = -1;
+            Domain::NodeIndex best_neighbor = Domain::INVALID_NODE_INDEX;
             double best_score = std::numeric_limits<double>::max();
 
-            for (int neighbor : neighbors)
+            for (const auto &edge : neighbors)
             {
-                if (visited.find(neighbor) != visited.end())
+                if (isVisited(edge.getNeighborIndex()))
                     continue;
 
-                try
-                {
-                    double cost = graph->getEdgeWeight(current, neighbor, strategy);
-                    // простая эвристика - минимизируем стоимость
-                    if (cost < best_score)
-                    {
-                        best_score = cost;
-                        best_neighbor = neighbor;
-                    }
-                }
-                catch (...)
+                double cost = weights[edge.getId()];
+                // простая эвристика - минимизируем стоимость
+                if (cost < best_score)
                 {
-                    continue;
+                    best_score = cost;
+                    best_neighbor = edge.getNeighborIndex();
                 }
             }
 
-            if (best_neighbor == -1)
-            {
-                // все соседи посещены - выбираем случайного
-                std::vector<int> unvisited;
-                for (int neighbor : neighbors)
-                {
-                    if (visited.find(neighbor) == visited.end())
-                    {
-                        unvisited.push_back(neighbor);
-                    }
-                }
-                if (unvisited.empty())
-                    break;
-                std::uniform_int_distribution<size_t> dist(0, unvisited.size() - 1);
-                best_neighbor = unvisited[dist(gen)];
-            }
+            if (best_neighbor == Domain::INVALID_NODE_INDEX)
+                break; // все соседи посещены
 
             path.push_back(best_neighbor);
-            visited.insert(best_neighbor);
+            markVisited(best_neighbor);
             current = best_neighbor;
         }
 
-        return (current == end) ? path : std::vector<int>();
+        return (current == end) ? path : Path();
     }
 
-    bool GeneticAlgorithm::isValidPath(const std::vector<int> &path, const Domain::NetworkGraphPtr &graph,
-                                       int start, int end)
+    bool GeneticAlgorithm::isValidPath(const Path &path, const Domain::NetworkGraphPtr &graph,
+                                       Domain::NodeIndex start, Domain::NodeIndex end)
     {
         if (path.size() < 2)
             return false;
@@ -523,12 +524,8 @@ namespace Infrastructure
 
         for (size_t i = 0; i < path.size() - 1; ++i)
         {
-            if (!graph->hasNode(path[i]) || !graph->hasNode(path[i + 1]))
-            {
-                return false;
-            }
-            auto neighbors = graph->getNeighbors(path[i]);
-            if (std::find(neighbors.begin(), neighbors.end(), path[i + 1]) == neighbors.end())
+            // ребро существует только между существующими узлами
+            if (!graph->findEdgeAt(path[i], path[i + 1]))
             {
                 return false;
             }
@@ -536,20 +533,30 @@ namespace Infrastructure
         return true;
     }
 
-    double GeneticAlgorithm::calculatePathCost(const std::vector<int> &path, const Domain::NetworkGraphPtr &graph)
+    double GeneticAlgorithm::calculatePathCost(const Path &path, const Domain::NetworkGraphPtr &graph)
     {
+        const auto &weights = graph->getEdgeWeights(strategy);
         double total_cost = 0.0;
         for (size_t i = 0; i + 1 < path.size(); ++i)
         {
-            try
-            {
-                total_cost += graph->getEdgeWeight(path[i], path[i + 1], strategy);
-            }
-            catch (...)
+            auto edge = graph->findEdgeAt(path[i], path[i + 1]);
+            if (!edge)
             {
                 return std::numeric_limits<double>::max();
             }
+            total_cost += weights[*edge];
         }
         return total_cost;
     }
-}
\ No newline at end of file
+
+    void GeneticAlgorithm::resetVisited(const Domain::NetworkGraphPtr &graph)
+    {
+        if (visitStamp.size() < graph->getIndexBound())
+            visitStamp.resize(graph->getIndexBound(), 0);
+        if (++currentStamp == 0)
+        {
+            std::fill(visitStamp.begin(), visitStamp.end(), 0);
+            currentStamp = 1;
+        }
+    }
+}
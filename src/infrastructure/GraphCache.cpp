@@ -0,0 +1,131 @@
+#include "infrastructure/GraphCache.h"
+#include "infrastructure/BinaryGraphFormat.h"
+#include "infrastructure/BinaryGraphRepository.h"
+#include "infrastructure/MappedFile.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        namespace fs = std::filesystem;
+
+        // файл, измененный недавно, может измениться еще раз в пределах разрешения времени
+        // изменения, не сдвинув его; хэш содержимого такого файла не запоминается
+        constexpr auto STAMP_DELAY = std::chrono::seconds(2);
+
+        std::string toHex(std::uint64_t value)
+        {
+            char buffer[17];
+            std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+            return buffer;
+        }
+
+        std::uint64_t combine(std::uint64_t hash, std::uint64_t value)
+        {
+            return BinaryGraphFormat::checksum(&value, sizeof(value), hash);
+        }
+
+        // файл пишется под временным именем и заменяет старый целиком
+        void replaceFile(const std::string &temporary, const std::string &filename)
+        {
+#ifdef _WIN32
+            std::remove(filename.c_str());
+#endif
+            if (std::rename(temporary.c_str(), filename.c_str()) != 0)
+            {
+                std::remove(temporary.c_str());
+                throw std::runtime_error("Cannot replace file: " + filename);
+            }
+        }
+    }
+
+    std::string GraphCache::getEntryPath(std::uint64_t key) const
+    {
+        return (fs::path(directory) / (toHex(key) + BinaryGraphRepository::FILE_EXTENSION)).string();
+    }
+
+    std::uint64_t GraphCache::getKey(const std::string &filename, std::uint64_t options) const
+    {
+        std::error_code error;
+        const fs::path path = fs::absolute(filename, error);
+        const std::uint64_t size = error ? 0 : fs::file_size(path, error);
+        const auto modified = error ? fs::file_time_type() : fs::last_write_time(path, error);
+        if (error)
+            throw std::runtime_error("Cannot open file: " + filename);
+        const long long modified_ticks = static_cast<long long>(modified.time_since_epoch().count());
+
+        // штамп: размер, время изменения и хэш содержимого файла по этому пути
+        const std::string name = path.u8string();
+        const std::string stamp_path =
+            (fs::path(directory) / (toHex(BinaryGraphFormat::checksum(name.data(), name.size(),
+                                                                      BinaryGraphFormat::CHECKSUM_SEED)) + ".stamp")).string();
+        std::uint64_t stamp_size = 0, content_hash = 0;
+        long long stamp_ticks = 0;
+        std::ifstream in(stamp_path);
+        if (!(in >> stamp_size >> stamp_ticks >> std::hex >> content_hash) || stamp_size != size ||
+            stamp_ticks != modified_ticks)
+        {
+            MappedFile file(filename);
+            content_hash = BinaryGraphFormat::checksum(file.data(), file.size(), BinaryGraphFormat::CHECKSUM_SEED);
+            if (modified + STAMP_DELAY < fs::file_time_type::clock::now())
+            {
+                fs::create_directories(directory, error);
+                std::ofstream out(stamp_path, std::ios::trunc);
+                if (out)
+                    out << size << ' ' << modified_ticks << ' ' << std::hex << content_hash << '\n';
+            }
+        }
+        return combine(combine(BinaryGraphFormat::CHECKSUM_SEED, content_hash), options);
+    }
+
+    Domain::NetworkGraphPtr GraphCache::load(std::uint64_t key, const std::string &name) const
+    {
+        const std::string entry = getEntryPath(key);
+        std::error_code error;
+        if (!fs::exists(entry, error))
+            return nullptr;
+        try
+        {
+            auto compact = BinaryGraphRepository().openCompactGraph(entry);
+            std::vector<Domain::NodeId> order(compact->getNodeCount());
+            std::ifstream in(fs::path(entry).replace_extension(".order").string(), std::ios::binary);
+            in.read(reinterpret_cast<char *>(order.data()),
+                    static_cast<std::streamsize>(order.size() * sizeof(Domain::NodeId)));
+            if (!in || in.peek() != std::ifstream::traits_type::eof())
+                return nullptr;
+            return BinaryGraphRepository::buildNetworkGraph(compact, name, order);
+        }
+        catch (const std::exception &)
+        {
+            return nullptr;
+        }
+    }
+
+    void GraphCache::store(std::uint64_t key, const Domain::NetworkGraph &graph) const
+    {
+        std::error_code error;
+        fs::create_directories(directory, error);
+        if (error)
+            throw std::runtime_error("Cannot create cache directory: " + directory);
+
+        // порядок вершин пишется первым: запись находится по файлу графа, который появляется последним
+        const std::string entry = getEntryPath(key);
+        const std::string order_path = fs::path(entry).replace_extension(".order").string();
+        const auto order = graph.getAllNodeIds();
+        {
+            std::ofstream out(order_path + ".tmp", std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char *>(order.data()),
+                      static_cast<std::streamsize>(order.size() * sizeof(Domain::NodeId)));
+            if (!out)
+                throw std::runtime_error("Cannot write file: " + order_path);
+        }
+        replaceFile(order_path + ".tmp", order_path);
+        BinaryGraphRepository::save(graph, entry);
+    }
+}
@@ -0,0 +1,193 @@
+#include "infrastructure/GraphFileFormat.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        // строка с позиции position без перевода строки и пробелов по краям
+        std::string_view lineAt(const char *position, const char *end)
+        {
+            const char *line_end = static_cast<const char *>(std::memchr(position, '\n', end - position));
+            std::string_view line(position, (line_end ? line_end : end) - position);
+            while (!line.empty() && std::isspace(static_cast<unsigned char>(line.front()))) line.remove_prefix(1);
+            while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) line.remove_suffix(1);
+            return line;
+        }
+
+        std::string lowercase(std::string_view text)
+        {
+            std::string res(text);
+            std::transform(res.begin(), res.end(), res.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return res;
+        }
+
+        std::vector<std::string> tokens(std::string_view line)
+        {
+            std::istringstream in{std::string(line)};
+            std::vector<std::string> res;
+            for (std::string token; in >> token;) res.push_back(token);
+            return res;
+        }
+
+        // число после ключа ("nodes:") в строке; 0 - ключа нет
+        std::size_t valueAfter(const std::string &line, const char *key)
+        {
+            const auto pos = line.find(key);
+            return pos == std::string::npos ? 0 : std::strtoull(line.c_str() + pos + std::strlen(key), nullptr, 10);
+        }
+
+        // %%MatrixMarket matrix coordinate <real|integer|pattern> <general|symmetric>, комментарии %,
+        // строка размера "rows cols nnz"; индексы строк и столбцов - номера вершин
+        GraphFileFormat parseMatrixMarket(const std::string &filename, const char *begin, const char *end)
+        {
+            GraphFileFormat format;
+            format.kind = GraphFileFormat::MATRIX_MARKET;
+            const auto banner = tokens(lowercase(lineAt(begin, end)));
+            if (banner.size() < 5 || banner[1] != "matrix" || banner[2] != "coordinate")
+                throw std::runtime_error("Matrix Market file is not a coordinate matrix: " + filename);
+            if (banner[3] != "real" && banner[3] != "integer" && banner[3] != "pattern")
+                throw std::runtime_error("Unsupported Matrix Market field '" + banner[3] + "': " + filename);
+            if (banner[4] != "general" && banner[4] != "symmetric")
+                throw std::runtime_error("Unsupported Matrix Market symmetry '" + banner[4] + "': " + filename);
+            format.symmetric = banner[4] == "symmetric";
+
+            const char *position = EdgeListParser::nextLine(begin, end);
+            format.headerLines = 1;
+            while (position < end)
+            {
+                const auto line = lineAt(position, end);
+                position = EdgeListParser::nextLine(position, end);
+                ++format.headerLines;
+                if (line.empty() || line.front() == '%') continue;
+
+                std::size_t rows = 0, columns = 0, entries = 0;
+                std::istringstream size_line{std::string(line)};
+                if (!(size_line >> rows >> columns >> entries))
+                    throw std::runtime_error("Malformed Matrix Market size line: " + filename);
+                if (rows != columns)
+                    throw std::runtime_error("Matrix Market matrix is not square: " + filename);
+                format.declaredNodes = rows;
+                format.declaredEdges = entries;
+                format.headerBytes = static_cast<std::size_t>(position - begin);
+                return format;
+            }
+            throw std::runtime_error("Matrix Market size line missing: " + filename);
+        }
+
+        // строки c и "p sp N M" до первой дуги
+        GraphFileFormat parseDimacs(const std::string &filename, const char *begin, const char *end)
+        {
+            GraphFileFormat format;
+            format.kind = GraphFileFormat::DIMACS;
+            std::size_t lines = 0;
+            for (const char *position = begin; position < end;)
+            {
+                const auto line = lineAt(position, end);
+                position = EdgeListParser::nextLine(position, end);
+                ++lines;
+                if (line.empty() || line.front() == 'c') continue;
+                if (line.front() != 'p') break;
+
+                const auto problem = tokens(line);
+                if (problem.size() < 4)
+                    throw std::runtime_error("Malformed DIMACS problem line: " + filename);
+                format.declaredNodes = std::strtoull(problem[2].c_str(), nullptr, 10);
+                format.declaredEdges = std::strtoull(problem[3].c_str(), nullptr, 10);
+                format.headerBytes = static_cast<std::size_t>(position - begin);
+                format.headerLines = lines;
+                break;
+            }
+            return format;
+        }
+
+        // комментарии в начале файла SNAP: "# Nodes: N Edges: M", ориентированность графа
+        GraphFileFormat parseSnap(const char *begin, const char *end)
+        {
+            GraphFileFormat format;
+            bool described = false;
+            for (const char *position = begin; position < end;)
+            {
+                const auto line = lineAt(position, end);
+                if (!line.empty() && line.front() != '#') break;
+                position = EdgeListParser::nextLine(position, end);
+                ++format.headerLines;
+                format.headerBytes = static_cast<std::size_t>(position - begin);
+
+                const auto text = lowercase(line);
+                if (text.find("nodes:") != std::string::npos)
+                {
+                    format.declaredNodes = valueAfter(text, "nodes:");
+                    format.declaredEdges = valueAfter(text, "edges:");
+                    described = true;
+                }
+                // "Undirected graph" или "Directed graph (each unordered pair of nodes is saved once)"
+                if (text.find("undirected") != std::string::npos || text.find("unordered pair") != std::string::npos)
+                {
+                    format.symmetric = true;
+                    described = true;
+                }
+            }
+            if (described)
+                format.kind = GraphFileFormat::SNAP;
+            return format;
+        }
+    }
+
+    GraphFileFormat::Kind GraphFileFormat::fromExtension(const std::string &filename)
+    {
+        const auto extension = lowercase(std::filesystem::path(filename).extension().string());
+        if (extension == ".gr") return DIMACS;
+        if (extension == ".mtx") return MATRIX_MARKET;
+        return EDGE_LIST;
+    }
+
+    GraphFileFormat GraphFileFormat::detect(const std::string &filename, const char *begin, const char *end)
+    {
+        const Kind by_extension = fromExtension(filename);
+        const auto first = begin < end ? lineAt(begin, end) : std::string_view();
+
+        if (lowercase(first.substr(0, 14)) == "%%matrixmarket")
+            return parseMatrixMarket(filename, begin, end);
+        if (by_extension == MATRIX_MARKET)
+            throw std::runtime_error("Matrix Market banner missing: " + filename);
+        // списки ребер начинаются с номера вершины или комментария, DIMACS - со строки c или p
+        const bool dimacs_line = !first.empty() && (first.front() == 'c' || first.front() == 'p') &&
+                                 (first.size() == 1 || std::isspace(static_cast<unsigned char>(first[1])));
+        if (by_extension == DIMACS || dimacs_line)
+            return parseDimacs(filename, begin, end);
+        if (!first.empty() && first.front() == '#')
+            return parseSnap(begin, end);
+        return GraphFileFormat();
+    }
+
+    const char *GraphFileFormat::getName(Kind kind)
+    {
+        switch (kind)
+        {
+        case SNAP: return "SNAP";
+        case DIMACS: return "DIMACS";
+        case MATRIX_MARKET: return "Matrix Market";
+        default: return "список ребер";
+        }
+    }
+
+    EdgeListParser::Options GraphFileFormat::getParserOptions(bool synthesize, std::uint64_t seed) const
+    {
+        EdgeListParser::Options options;
+        options.dialect = kind == DIMACS ? EdgeListParser::DIMACS : EdgeListParser::EDGE_LIST;
+        options.symmetric = symmetric;
+        options.synthesize = synthesize;
+        options.seed = seed;
+        return options;
+    }
+}
@@ -0,0 +1,261 @@
+#include "infrastructure/LinkMetricsTable.h"
+#include "infrastructure/EdgeListParser.h"
+#include "infrastructure/MappedFile.h"
+#include "infrastructure/TelemetryIngestor.h"
+#include "infrastructure/ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        using Domain::LinkParameterStore;
+
+        constexpr std::size_t MIN_CHUNK = 1 << 20;   // как у FileGraphRepository
+
+        std::uint64_t keyHash(Domain::NodeId u, Domain::NodeId v)
+        {
+            std::uint64_t h = static_cast<std::uint64_t>(u) * 0x9e3779b97f4a7c15ULL ^ static_cast<std::uint64_t>(v);
+            h ^= h >> 32;
+            h *= 0xd6e8feb86659fd93ULL;
+            return h ^ (h >> 32);
+        }
+
+        double &field(Domain::LinkParameters &params, LinkParameterStore::Column column)
+        {
+            switch (column)
+            {
+            case LinkParameterStore::BANDWIDTH: return params.bandwidth;
+            case LinkParameterStore::PACKET_LOSS: return params.packet_loss;
+            case LinkParameterStore::UTILIZATION: return params.utilization;
+            case LinkParameterStore::COST: return params.cost;
+            case LinkParameterStore::RELIABILITY: return params.reliability;
+            default: return params.latency;
+            }
+        }
+
+        // поле строки с позиции p до разделителя; ' ' - поля через пробелы и табуляцию
+        std::string_view nextField(const char *&p, const char *end, char delimiter)
+        {
+            if (delimiter == ' ')
+                while (p < end && (*p == ' ' || *p == '\t')) ++p;
+            const char *start = p;
+            while (p < end && *p != delimiter && !(delimiter == ' ' && *p == '\t')) ++p;
+            std::string_view res(start, p - start);
+            if (p < end) ++p;
+            while (!res.empty() && (res.front() == ' ' || res.front() == '\t')) res.remove_prefix(1);
+            while (!res.empty() && (res.back() == ' ' || res.back() == '\t' || res.back() == '\r')) res.remove_suffix(1);
+            return res;
+        }
+
+        // строки метрик одного куска файла
+        struct Rows
+        {
+            std::vector<Domain::NodeId> sources, targets;
+            std::vector<double> values;
+            int unparsable = 0;
+        };
+
+        // positions[i] - место поля i после ключа в строке значений, -1 - поле пропускается
+        Rows parseRows(const char *begin, const char *end, char delimiter, const std::vector<int> &positions,
+                       std::size_t width)
+        {
+            Rows res;
+            for (const char *line = begin; line < end;)
+            {
+                const char *line_end = static_cast<const char *>(std::memchr(line, '\n', end - line));
+                if (!line_end) line_end = end;
+                const char *p = line;
+                line = line_end + 1;
+
+                auto source = nextField(p, line_end, delimiter);
+                if (source.empty() || source.front() == '#') continue;
+                auto target = nextField(p, line_end, delimiter);
+                Domain::NodeId u = 0, v = 0;
+                if (std::from_chars(source.data(), source.data() + source.size(), u).ec != std::errc() ||
+                    std::from_chars(target.data(), target.data() + target.size(), v).ec != std::errc())
+                {
+                    ++res.unparsable;
+                    continue;
+                }
+
+                const std::size_t row = res.values.size();
+                res.values.resize(row + width, std::numeric_limits<double>::quiet_NaN());
+                bool valid = true;
+                for (std::size_t i = 0; i < positions.size() && p < line_end; ++i)
+                {
+                    auto text = nextField(p, line_end, delimiter);
+                    if (positions[i] < 0 || text.empty()) continue;
+                    double value = 0.0;
+                    const char *parsed = EdgeListParser::parseValue(text.data(), text.data() + text.size(), value);
+                    if (parsed != text.data() + text.size())
+                    {
+                        valid = false;
+                        break;
+                    }
+                    res.values[row + positions[i]] = value;
+                }
+                if (!valid)
+                {
+                    res.values.resize(row);
+                    ++res.unparsable;
+                    continue;
+                }
+                res.sources.push_back(u);
+                res.targets.push_back(v);
+            }
+            return res;
+        }
+    }
+
+    std::string LinkMetricsTable::findSidecar(const std::string &edge_list)
+    {
+        const std::string sidecar = edge_list + SIDECAR_SUFFIX;
+        std::ifstream probe(sidecar);
+        return probe ? sidecar : std::string();
+    }
+
+    LinkMetricsTable::LinkMetricsTable(const std::string &filename)
+    {
+        MappedFile file(filename);
+        const char *text = file.data();
+        const char *text_end = text + file.size();
+        if (file.size() >= 3 && static_cast<unsigned char>(text[0]) == 0xEF &&
+            static_cast<unsigned char>(text[1]) == 0xBB && static_cast<unsigned char>(text[2]) == 0xBF)
+            text += 3;
+
+        // заголовок: два поля ключа, затем столбцы параметров
+        const char *body = EdgeListParser::nextLine(text, text_end);
+        const std::string_view header(text, body - text);
+        const char delimiter = header.find(',') != std::string_view::npos    ? ','
+                               : header.find('\t') != std::string_view::npos ? '\t'
+                                                                            : ' ';
+        const char *p = text;
+        const char *header_end = body > text && body[-1] == '\n' ? body - 1 : body;
+        if (p < header_end && *p == '#') ++p;
+        nextField(p, header_end, delimiter);
+        nextField(p, header_end, delimiter);
+        std::vector<int> positions;
+        while (p < header_end)
+        {
+            const auto name = nextField(p, header_end, delimiter);
+            LinkParameterStore::Column column;
+            if (!TelemetryIngestor::parseColumn(std::string(name), column))
+            {
+                positions.push_back(-1);
+                skippedColumns.emplace_back(name);
+                continue;
+            }
+            // повтор столбца пишет в то же место строки
+            auto known = std::find(columns.begin(), columns.end(), column);
+            positions.push_back(static_cast<int>(known - columns.begin()));
+            if (known == columns.end()) columns.push_back(column);
+        }
+        if (columns.empty())
+            throw std::runtime_error("No link parameter columns in metrics file header: " + filename);
+
+        // куски по границам строк разбираются параллельно и склеиваются в порядке файла
+        const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        const std::size_t size = static_cast<std::size_t>(text_end - body);
+        const std::size_t chunk_count = std::max<std::size_t>(1, std::min(threads * 4, size / MIN_CHUNK));
+        std::vector<const char *> bounds{body};
+        for (std::size_t c = 1; c < chunk_count; ++c)
+        {
+            const char *next = EdgeListParser::nextLine(body + size * c / chunk_count, text_end);
+            if (next > bounds.back() && next < text_end) bounds.push_back(next);
+        }
+        bounds.push_back(text_end);
+
+        std::vector<Rows> chunks(bounds.size() - 1);
+        if (chunks.size() == 1)
+        {
+            chunks[0] = parseRows(bounds[0], bounds[1], delimiter, positions, columns.size());
+        }
+        else
+        {
+            ThreadPool pool(std::min(threads, chunks.size()));
+            std::vector<std::future<Rows>> pending;
+            for (std::size_t c = 0; c < chunks.size(); ++c)
+                pending.push_back(pool.enqueue(parseRows, bounds[c], bounds[c + 1], delimiter, std::cref(positions),
+                                               columns.size()));
+            for (std::size_t c = 0; c < chunks.size(); ++c)
+                chunks[c] = pending[c].get();
+        }
+
+        std::size_t row_count = 0;
+        for (const auto &chunk : chunks) row_count += chunk.sources.size();
+        if (row_count >= std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("Too many rows in metrics file: " + filename);
+        sources.reserve(row_count);
+        targets.reserve(row_count);
+        values.reserve(row_count * columns.size());
+        for (auto &chunk : chunks)
+        {
+            sources.insert(sources.end(), chunk.sources.begin(), chunk.sources.end());
+            targets.insert(targets.end(), chunk.targets.begin(), chunk.targets.end());
+            values.insert(values.end(), chunk.values.begin(), chunk.values.end());
+            unparsable += chunk.unparsable;
+            chunk = Rows();
+        }
+
+        // таблица заполнена не более чем наполовину; повтор ключа переназначает место на новую строку
+        std::size_t capacity = 16;
+        while (capacity < row_count * 2) capacity *= 2;
+        slots.assign(capacity, 0);
+        for (std::size_t row = 0; row < row_count; ++row)
+        {
+            std::size_t slot = keyHash(sources[row], targets[row]) & (capacity - 1);
+            while (slots[slot] != 0)
+            {
+                const std::size_t other = slots[slot] - 1;
+                if (sources[other] == sources[row] && targets[other] == targets[row]) break;
+                slot = (slot + 1) & (capacity - 1);
+            }
+            slots[slot] = static_cast<std::uint32_t>(row + 1);
+        }
+        used.reset(new std::atomic<bool>[row_count]());
+    }
+
+    std::size_t LinkMetricsTable::find(Domain::NodeId u, Domain::NodeId v) const
+    {
+        const std::size_t mask = slots.size() - 1;
+        for (std::size_t slot = keyHash(u, v) & mask; slots[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const std::size_t row = slots[slot] - 1;
+            if (sources[row] == u && targets[row] == v) return row;
+        }
+        return NOT_FOUND;
+    }
+
+    bool LinkMetricsTable::apply(Domain::NodeId u, Domain::NodeId v, bool symmetric, Domain::LinkParameters &params) const
+    {
+        std::size_t row = find(u, v);
+        if (row == NOT_FOUND && symmetric) row = find(v, u);
+        if (row == NOT_FOUND) return false;
+
+        // отметка без записи, если строка уже использована: потоки не делят строку кэша на запись
+        if (!used[row].load(std::memory_order_relaxed)) used[row].store(true, std::memory_order_relaxed);
+        const double *value = values.data() + row * columns.size();
+        for (std::size_t j = 0; j < columns.size(); ++j)
+            if (!std::isnan(value[j])) field(params, columns[j]) = value[j];
+        return true;
+    }
+
+    std::size_t LinkMetricsTable::getUnusedRowCount() const
+    {
+        std::size_t unused = 0;
+        for (auto slot : slots)
+            if (slot != 0 && !used[slot - 1].load(std::memory_order_relaxed)) ++unused;
+        return unused;
+    }
+}
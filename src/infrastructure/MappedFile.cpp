@@ -0,0 +1,91 @@
+#include "infrastructure/MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Infrastructure
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string &filename, Access access)
+    {
+        const DWORD hint = access == SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+        HANDLE handle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | hint, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Cannot open file: " + filename);
+        file = handle;
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(handle, &file_size))
+        {
+            CloseHandle(handle);
+            throw std::runtime_error("Cannot get file size: " + filename);
+        }
+        length = static_cast<std::size_t>(file_size.QuadPart);
+        if (length == 0)
+            return;
+
+        mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping)
+            view = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!view)
+        {
+            if (mapping)
+                CloseHandle(mapping);
+            CloseHandle(handle);
+            throw std::runtime_error("Cannot map file: " + filename);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (view)
+            UnmapViewOfFile(view);
+        if (mapping)
+            CloseHandle(mapping);
+        if (file)
+            CloseHandle(file);
+    }
+#else
+    MappedFile::MappedFile(const std::string &filename, Access access)
+    {
+        descriptor = open(filename.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            throw std::runtime_error("Cannot open file: " + filename);
+
+        struct stat info;
+        if (fstat(descriptor, &info) != 0)
+        {
+            close(descriptor);
+            throw std::runtime_error("Cannot get file size: " + filename);
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length == 0)
+            return;
+
+        void *address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address == MAP_FAILED)
+        {
+            close(descriptor);
+            throw std::runtime_error("Cannot map file: " + filename);
+        }
+        madvise(address, length, access == SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+        view = static_cast<const char *>(address);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (view)
+            munmap(const_cast<char *>(view), length);
+        if (descriptor >= 0)
+            close(descriptor);
+    }
+#endif
+}
@@ -0,0 +1,71 @@
+#include "infrastructure/MemoryProbe.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <fstream>
+#include <string>
+#endif
+
+namespace Infrastructure
+{
+    MemoryProbe::Sample MemoryProbe::sample()
+    {
+        Sample res;
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            res.currentRss = counters.WorkingSetSize;
+            res.peakRss = counters.PeakWorkingSetSize;
+        }
+#else
+        // VmRSS и VmHWM в килобайтах
+        std::ifstream status("/proc/self/status");
+        std::string key;
+        std::size_t value = 0;
+        while (status >> key)
+        {
+            if (key == "VmRSS:" && status >> value) res.currentRss = value * 1024;
+            else if (key == "VmHWM:" && status >> value) res.peakRss = value * 1024;
+        }
+#endif
+        return res;
+    }
+
+    bool MemoryProbe::resetPeak()
+    {
+#ifdef _WIN32
+        // пиковый рабочий набор процесса в Windows не сбрасывается
+        return false;
+#else
+        std::ofstream clear("/proc/self/clear_refs");
+        if (!clear) return false;
+        clear << "5";
+        return static_cast<bool>(clear);
+#endif
+    }
+
+    MemoryProbe::MemoryProbe()
+    {
+        exactPeak = resetPeak();
+        start = sample();
+    }
+
+    std::size_t MemoryProbe::getPeakIncrease() const
+    {
+        Sample now = sample();
+        // без сброса пик процесса виден, только если вызов его превысил; иначе берется текущий RSS
+        std::size_t peak = (exactPeak || now.peakRss > start.peakRss) ? now.peakRss : now.currentRss;
+        peak = std::max(peak, now.currentRss);
+        return peak > start.currentRss ? peak - start.currentRss : 0;
+    }
+
+    long long MemoryProbe::getRetained() const
+    {
+        return static_cast<long long>(sample().currentRss) - static_cast<long long>(start.currentRss);
+    }
+}
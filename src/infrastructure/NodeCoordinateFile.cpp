@@ -0,0 +1,195 @@
+#include "infrastructure/NodeCoordinateFile.h"
+#include "infrastructure/EdgeListParser.h"
+#include "infrastructure/MappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        using Domain::NodeCoordinates;
+
+        constexpr double DIMACS_DEGREE = 1e-6;   // координаты .co - миллионные доли градуса
+
+        // поля строки; ' ' - поля через пробелы и табуляцию
+        std::vector<std::string_view> splitFields(std::string_view line, char delimiter)
+        {
+            std::vector<std::string_view> res;
+            std::size_t pos = 0;
+            while (pos <= line.size())
+            {
+                if (delimiter == ' ')
+                {
+                    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) ++pos;
+                    if (pos == line.size()) break;
+                }
+                std::size_t end = pos;
+                while (end < line.size() && line[end] != delimiter &&
+                       !(delimiter == ' ' && std::isspace(static_cast<unsigned char>(line[end])))) ++end;
+                std::string_view field = line.substr(pos, end - pos);
+                while (!field.empty() && std::isspace(static_cast<unsigned char>(field.front()))) field.remove_prefix(1);
+                while (!field.empty() && std::isspace(static_cast<unsigned char>(field.back()))) field.remove_suffix(1);
+                res.push_back(field);
+                pos = end + 1;
+            }
+            return res;
+        }
+
+        bool parseId(std::string_view text, Domain::NodeId &id)
+        {
+            const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), id);
+            return error == std::errc() && end == text.data() + text.size();
+        }
+
+        bool parseNumber(std::string_view text, double &value)
+        {
+            return !text.empty() && EdgeListParser::parseValue(text.data(), text.data() + text.size(), value) ==
+                                        text.data() + text.size();
+        }
+
+        std::string lowercase(std::string_view text)
+        {
+            std::string res(text);
+            std::transform(res.begin(), res.end(), res.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return res;
+        }
+
+        // номер столбца с одним из имен, -1 - такого нет
+        int findColumn(const std::vector<std::string> &names, std::initializer_list<const char *> candidates)
+        {
+            for (std::size_t i = 0; i < names.size(); ++i)
+                for (const char *candidate : candidates)
+                    if (names[i] == candidate) return static_cast<int>(i);
+            return -1;
+        }
+    }
+
+    std::string NodeCoordinateFile::findSidecar(const std::string &edge_list)
+    {
+        std::vector<std::string> candidates{edge_list + SIDECAR_SUFFIX};
+        if (lowercase(std::filesystem::path(edge_list).extension().string()) == ".gr")
+            candidates.push_back(std::filesystem::path(edge_list).replace_extension(DIMACS_EXTENSION).string());
+        for (const auto &candidate : candidates)
+        {
+            std::ifstream probe(candidate);
+            if (probe) return candidate;
+        }
+        return std::string();
+    }
+
+    NodeCoordinateFile::NodeCoordinateFile(const std::string &filename)
+    {
+        MappedFile file(filename);
+        const char *text = file.data();
+        const char *text_end = text + file.size();
+        if (file.size() >= 3 && static_cast<unsigned char>(text[0]) == 0xEF &&
+            static_cast<unsigned char>(text[1]) == 0xBB && static_cast<unsigned char>(text[2]) == 0xBF)
+            text += 3;
+
+        // строки без перевода строки и пробелов по краям; пустые и комментарии # пропускаются
+        std::vector<std::string_view> lines;
+        for (const char *line = text; line < text_end;)
+        {
+            const char *next = EdgeListParser::nextLine(line, text_end);
+            std::string_view view(line, next - line);
+            line = next;
+            while (!view.empty() && std::isspace(static_cast<unsigned char>(view.back()))) view.remove_suffix(1);
+            while (!view.empty() && std::isspace(static_cast<unsigned char>(view.front()))) view.remove_prefix(1);
+            if (!view.empty() && view.front() != '#') lines.push_back(view);
+        }
+
+        const bool dimacs = lowercase(std::filesystem::path(filename).extension().string()) == DIMACS_EXTENSION ||
+                            (!lines.empty() && lines.front().size() > 1 &&
+                             (lines.front()[0] == 'c' || lines.front()[0] == 'p' || lines.front()[0] == 'v') &&
+                             std::isspace(static_cast<unsigned char>(lines.front()[1])));
+
+        NodeCoordinates::System system = NodeCoordinates::PLANAR;
+        std::vector<std::pair<Domain::NodeId, NodeCoordinates::Point>> points;
+        points.reserve(lines.size());
+        if (dimacs)
+        {
+            system = NodeCoordinates::GEOGRAPHIC;
+            for (auto line : lines)
+            {
+                if (line.front() != 'v') continue;
+                const auto fields = splitFields(line, ' ');
+                Domain::NodeId id = 0;
+                NodeCoordinates::Point point;
+                if (fields.size() < 4 || !parseId(fields[1], id) || !parseNumber(fields[2], point.x) ||
+                    !parseNumber(fields[3], point.y))
+                {
+                    ++unparsable;
+                    continue;
+                }
+                point.x *= DIMACS_DEGREE;
+                point.y *= DIMACS_DEGREE;
+                points.emplace_back(id, point);
+            }
+        }
+        else if (!lines.empty())
+        {
+            const std::string_view first = lines.front();
+            const char delimiter = first.find(',') != std::string_view::npos    ? ','
+                                   : first.find('\t') != std::string_view::npos ? '\t'
+                                                                               : ' ';
+            // заголовок - первая строка, если ее первое поле не число
+            int id_column = 0, x_column = 1, y_column = 2;
+            std::size_t row = 0;
+            Domain::NodeId probe = 0;
+            const auto header = splitFields(first, delimiter);
+            if (!header.empty() && !parseId(header.front(), probe))
+            {
+                row = 1;
+                std::vector<std::string> names;
+                for (auto name : header) names.push_back(lowercase(name));
+                const int lat = findColumn(names, {"lat", "latitude"});
+                const int lon = findColumn(names, {"lon", "lng", "longitude"});
+                const int x = findColumn(names, {"x"});
+                const int y = findColumn(names, {"y"});
+                const int id = findColumn(names, {"id", "node", "node_id"});
+                if (id >= 0) id_column = id;
+                if (lat >= 0 && lon >= 0)
+                {
+                    system = NodeCoordinates::GEOGRAPHIC;
+                    x_column = lon;
+                    y_column = lat;
+                }
+                else if (x >= 0 && y >= 0)
+                {
+                    x_column = x;
+                    y_column = y;
+                }
+            }
+
+            const std::size_t width = static_cast<std::size_t>(std::max({id_column, x_column, y_column})) + 1;
+            for (; row < lines.size(); ++row)
+            {
+                const auto fields = splitFields(lines[row], delimiter);
+                Domain::NodeId id = 0;
+                NodeCoordinates::Point point;
+                if (fields.size() < width || !parseId(fields[id_column], id) ||
+                    !parseNumber(fields[x_column], point.x) || !parseNumber(fields[y_column], point.y))
+                {
+                    ++unparsable;
+                    continue;
+                }
+                points.emplace_back(id, point);
+            }
+        }
+
+        if (points.empty())
+            throw std::runtime_error("No node coordinates in file: " + filename);
+        coordinates = std::make_shared<NodeCoordinates>(system, std::move(points));
+    }
+}
@@ -0,0 +1,217 @@
+#include "infrastructure/ParetoPathFinder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <queue>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        using LabelIndex = std::uint32_t;
+        constexpr LabelIndex NO_LABEL = static_cast<LabelIndex>(-1);
+
+        struct Label
+        {
+            RouteObjectives objectives;
+            Domain::CompactGraph::NodeIndex node;
+            LabelIndex parent;
+            bool alive;
+        };
+
+        // критерии после прохода по ребру e: суммы, узкое место и произведение надежностей
+        RouteObjectives extend(const RouteObjectives &from, const Domain::CompactGraph &graph,
+                               Domain::CompactGraph::EdgeIndex e)
+        {
+            using Store = Domain::LinkParameterStore;
+            RouteObjectives res = from;
+            res.values[RouteObjectives::LATENCY] += graph.getEdgeValue(Store::LATENCY, e);
+            res.values[RouteObjectives::COST] += graph.getEdgeValue(Store::COST, e);
+            res.values[RouteObjectives::INVERSE_BANDWIDTH] =
+                std::max(res.values[RouteObjectives::INVERSE_BANDWIDTH], 1.0 / graph.getEdgeValue(Store::BANDWIDTH, e));
+            res.values[RouteObjectives::UNRELIABILITY] =
+                1.0 - (1.0 - res.values[RouteObjectives::UNRELIABILITY]) * graph.getEdgeValue(Store::RELIABILITY, e);
+            return res;
+        }
+    }
+
+    ParetoResult ParetoPathFinder::findParetoFront(
+        const Domain::NetworkGraphPtr &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id)
+    {
+        return findParetoFrontStatic(*graph->getCompactGraph(), start_id, end_id, settings);
+    }
+
+    ParetoResult ParetoPathFinder::findParetoFront(
+        const Domain::CompactGraph &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id)
+    {
+        return findParetoFrontStatic(graph, start_id, end_id, settings);
+    }
+
+    Domain::PathResult ParetoPathFinder::findShortestPath(
+        const Domain::NetworkGraphPtr &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id)
+    {
+        return findShortestPath(*graph->getCompactGraph(), start_id, end_id);
+    }
+
+    Domain::PathResult ParetoPathFinder::findShortestPath(
+        const Domain::CompactGraph &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id)
+    {
+        Domain::PathResult result;
+        auto front = findParetoFrontStatic(graph, start_id, end_id, settings);
+        result.algorithmName = getAlgorithmName();
+        result.executionTime = front.executionTime;
+        result.scratchBytes = front.scratchBytes;
+        if (!front.success)
+        {
+            result.errorMessage = front.errorMessage;
+            return result;
+        }
+        result.success = true;
+        result.pathNodes = front.routes.front().pathNodes;
+        result.totalCost = front.routes.front().objectives.values[RouteObjectives::LATENCY];
+        return result;
+    }
+
+    ParetoResult ParetoPathFinder::findParetoFrontStatic(
+        const Domain::CompactGraph &graph,
+        Domain::NodeId start_id, Domain::NodeId end_id,
+        const Settings &settings)
+    {
+        ParetoResult result;
+        result.algorithmName = "Pareto Label-Setting";
+
+        const auto start_idx = graph.findIndex(start_id);
+        const auto end_idx = graph.findIndex(end_id);
+        if (start_idx == Domain::CompactGraph::INVALID_NODE || end_idx == Domain::CompactGraph::INVALID_NODE)
+        {
+            result.errorMessage = "Start or end node not found";
+            return result;
+        }
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        std::vector<Label> labels;
+        std::vector<std::vector<LabelIndex>> bags(graph.getNodeCount());
+        // извлечение в лексикографическом порядке: извлеченную метку не доминирует ни одна более поздняя
+        auto later = [&labels](LabelIndex a, LabelIndex b) {
+            return labels[a].objectives.values > labels[b].objectives.values;
+        };
+        std::priority_queue<LabelIndex, std::vector<LabelIndex>, decltype(later)> queue(later);
+        std::size_t peak_queue = 0;
+
+        labels.push_back({RouteObjectives{}, start_idx, NO_LABEL, true});
+        bags[start_idx].push_back(0);
+        queue.push(0);
+        result.labelsCreated = 1;
+
+        auto dominated = [&](const std::vector<LabelIndex> &bag, const RouteObjectives &objectives) {
+            return std::any_of(bag.begin(), bag.end(), [&](LabelIndex l) {
+                return labels[l].objectives.dominates(objectives, settings.epsilon);
+            });
+        };
+
+        while (!queue.empty())
+        {
+            const LabelIndex current = queue.top();
+            queue.pop();
+            if (!labels[current].alive || labels[current].node == end_idx)
+                continue;
+            // цель могла получить доминирующий маршрут уже после постановки метки в очередь
+            if (dominated(bags[end_idx], labels[current].objectives))
+            {
+                ++result.labelsPruned;
+                continue;
+            }
+
+            const auto u = labels[current].node;
+            for (auto e = graph.edgesBegin(u); e != graph.edgesEnd(u); ++e)
+            {
+                const auto v = graph.getTarget(e);
+                const RouteObjectives candidate = extend(labels[current].objectives, graph, e);
+
+                // отсечение по найденным маршрутам цели и по меткам вершины v
+                if (dominated(bags[end_idx], candidate) || (v != end_idx && dominated(bags[v], candidate)))
+                {
+                    ++result.labelsPruned;
+                    continue;
+                }
+
+                // метки v, которые новая доминирует, удаляются (в очереди помечаются мертвыми)
+                auto &bag = bags[v];
+                bag.erase(std::remove_if(bag.begin(), bag.end(), [&](LabelIndex l) {
+                              if (!candidate.dominates(labels[l].objectives))
+                                  return false;
+                              labels[l].alive = false;
+                              ++result.labelsPruned;
+                              return true;
+                          }),
+                          bag.end());
+
+                if (bag.size() >= settings.maxLabelsPerNode || labels.size() >= settings.maxLabels)
+                {
+                    result.truncated = true;
+                    ++result.labelsPruned;
+                    continue;
+                }
+
+                const auto index = static_cast<LabelIndex>(labels.size());
+                labels.push_back({candidate, v, current, true});
+                bag.push_back(index);
+                ++result.labelsCreated;
+                if (v != end_idx)
+                {
+                    queue.push(index);
+                    peak_queue = std::max(peak_queue, queue.size());
+                }
+            }
+        }
+
+        for (LabelIndex l : bags[end_idx])
+        {
+            ParetoRoute route;
+            route.objectives = labels[l].objectives;
+            for (LabelIndex p = l; p != NO_LABEL; p = labels[p].parent)
+                route.pathNodes.push_back(graph.getNodeId(labels[p].node));
+            std::reverse(route.pathNodes.begin(), route.pathNodes.end());
+            result.routes.push_back(std::move(route));
+        }
+        std::sort(result.routes.begin(), result.routes.end(), [](const ParetoRoute &a, const ParetoRoute &b) {
+            return a.objectives.values < b.objectives.values;
+        });
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.executionTime = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        std::size_t bag_bytes = bags.capacity() * sizeof(std::vector<LabelIndex>);
+        for (const auto &bag : bags)
+            bag_bytes += bag.capacity() * sizeof(LabelIndex);
+        result.scratchBytes = labels.capacity() * sizeof(Label) + bag_bytes + peak_queue * sizeof(LabelIndex);
+
+        result.success = !result.routes.empty();
+        if (!result.success)
+            result.errorMessage = "No path found";
+        return result;
+    }
+
+    bool ParetoPathFinder::evaluateRoute(const Domain::CompactGraph &graph, const std::vector<Domain::NodeId> &path,
+                                         RouteObjectives &objectives)
+    {
+        objectives = RouteObjectives{};
+        for (std::size_t i = 1; i < path.size(); ++i)
+        {
+            const auto u = graph.findIndex(path[i - 1]);
+            const auto v = graph.findIndex(path[i]);
+            if (u == Domain::CompactGraph::INVALID_NODE || v == Domain::CompactGraph::INVALID_NODE)
+                return false;
+            const auto e = graph.findEdge(u, v);
+            if (e == Domain::CompactGraph::INVALID_EDGE)
+                return false;
+            objectives = extend(objectives, graph, e);
+        }
+        return true;
+    }
+}
@@ -1,4 +1,5 @@
 #include "infrastructure/SimpleStorage.h"
+#include <algorithm>
 #include <iostream>
 
 namespace Infrastructure
@@ -7,14 +8,16 @@ namespace Infrastructure
                                             const std::vector<AlgorithmComparison>& results)
     {
         std::ofstream file(filename);
-        file << "Algorithm,Success,Cost,Length,Time(ms)\n";
+        file << "Algorithm,Success,Cost,Length,Time(ms),Scratch(bytes),PeakRSS(bytes)\n";
         
         for (const auto& result : results) {
             file << result.algorithmName << ","
                  << (result.success ? "true" : "false") << ","
                  << result.pathCost << ","
                  << result.pathLength << ","
-                 << result.executionTime << "\n";
+                 << result.executionTime << ","
+                 << result.scratchMemory << ","
+                 << result.peakMemory << "\n";
         }
         
         std::cout << "Результаты эксперимента сохранены в " << filename << "\n";
@@ -39,20 +42,42 @@ namespace Infrastructure
         
         auto nodes = graph->getAllNodeIds();
         file << "Nodes: ";
-        for (int node : nodes) {
+        for (Domain::NodeId node : nodes) {
             file << node << " ";
         }
         file << "\n";
         
-        int edge_count = 0;
-        for (int node : nodes) {
-            edge_count += graph->getNeighbors(node).size();
+        std::size_t edge_count = 0;
+        for (Domain::NodeId node : nodes) {
+            edge_count += graph->getOutDegree(node);
         }
         file << "Edge Count: " << edge_count << "\n";
         
         std::cout << "Информация о графе сохранена в " << filename << "\n";
     }
     
+    void SimpleStorage::saveMemoryReport(const Domain::NetworkGraphPtr& graph,
+                                         const std::vector<AlgorithmComparison>& results,
+                                         const std::string& filename)
+    {
+        std::ofstream file(filename);
+        auto usage = graph->getMemoryUsage();
+        const double edges = static_cast<double>(std::max<std::size_t>(graph->getEdgeCount(), 1));
+
+        file << "Structure,Bytes,BytesPerEdge\n";
+        for (const auto& [name, bytes] : usage.items) {
+            file << name << "," << bytes << "," << bytes / edges << "\n";
+        }
+        file << "total," << usage.getTotal() << "," << usage.getTotal() / edges << "\n";
+
+        file << "\nAlgorithm,Scratch(bytes),PeakRSS(bytes)\n";
+        for (const auto& result : results) {
+            file << result.algorithmName << "," << result.scratchMemory << "," << result.peakMemory << "\n";
+        }
+
+        std::cout << "Отчет о памяти сохранен в " << filename << "\n";
+    }
+    
     void SimpleStorage::saveComparisonTable(const std::vector<AlgorithmComparison>& results, 
                                           const std::string& filename)
     {
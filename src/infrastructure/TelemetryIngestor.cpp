@@ -0,0 +1,261 @@
+#include "infrastructure/TelemetryIngestor.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace Infrastructure
+{
+    namespace
+    {
+        constexpr std::size_t BINARY_RECORD_SIZE = 32;
+
+        const char *const COLUMN_NAMES[Domain::LinkParameterStore::COLUMN_COUNT] = {
+            "latency", "bandwidth", "packet_loss", "utilization", "cost", "reliability"};
+    }
+
+    TelemetryIngestor::TelemetryIngestor(const Domain::NetworkGraphPtr &graph, const Settings &settings)
+        : graph(graph.get()), settings(settings)
+    {
+        if (!graph)
+            throw std::invalid_argument("TelemetryIngestor requires a graph");
+    }
+
+    TelemetryIngestor::TelemetryIngestor(Domain::ConcurrentGraph &graph, const Settings &settings)
+        : concurrent(&graph), settings(settings)
+    {
+    }
+
+    TelemetryIngestor::Stats TelemetryIngestor::run(std::istream &in)
+    {
+        readAvailable(in, false);
+        flush();
+        return getStats();
+    }
+
+    TelemetryIngestor::Stats TelemetryIngestor::follow(const std::string &filename, const std::atomic<bool> &stop,
+                                                       std::chrono::milliseconds poll_interval)
+    {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in.is_open())
+            throw std::runtime_error("Cannot open telemetry stream: " + filename);
+
+        while (!stop.load())
+        {
+            readAvailable(in, true);
+            // новых данных нет: накопленный пакет не ждет заполнения
+            flush();
+            in.clear();
+            std::this_thread::sleep_for(poll_interval);
+        }
+        readAvailable(in, false);
+        flush();
+        return getStats();
+    }
+
+    void TelemetryIngestor::readAvailable(std::istream &in, bool tail)
+    {
+        if (settings.format == BINARY)
+        {
+            char record[BINARY_RECORD_SIZE];
+            for (;;)
+            {
+                auto pos = in.tellg();
+                in.read(record, BINARY_RECORD_SIZE);
+                if (in.gcount() < static_cast<std::streamsize>(BINARY_RECORD_SIZE))
+                {
+                    // запись дописана не до конца - дочитаем при следующем опросе
+                    if (tail && in.gcount() > 0 && pos != std::streampos(-1))
+                    {
+                        in.clear();
+                        in.seekg(pos);
+                    }
+                    return;
+                }
+
+                std::int64_t source, target;
+                std::uint32_t column;
+                double value;
+                std::memcpy(&source, record, 8);
+                std::memcpy(&target, record + 8, 8);
+                std::memcpy(&column, record + 16, 4);
+                std::memcpy(&value, record + 24, 8);
+                if (column >= Domain::LinkParameterStore::COLUMN_COUNT)
+                {
+                    ++stats.received;
+                    ++stats.rejected;
+                    continue;
+                }
+                push({source, target, static_cast<Domain::LinkParameterStore::Column>(column), value});
+            }
+        }
+
+        std::string line;
+        for (;;)
+        {
+            auto pos = in.tellg();
+            if (!std::getline(in, line)) return;
+            if (in.eof() && tail && pos != std::streampos(-1))
+            {
+                // строка без перевода строки еще дописывается
+                in.clear();
+                in.seekg(pos);
+                return;
+            }
+
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+
+            TelemetryUpdate update;
+            if (!parseLine(line, update))
+            {
+                ++stats.received;
+                ++stats.rejected;
+                continue;
+            }
+            push(update);
+        }
+    }
+
+    bool TelemetryIngestor::parseLine(const std::string &line, TelemetryUpdate &update) const
+    {
+        // source,target,column,value; допускаются пробелы и табуляция вместо запятых
+        const char *p = line.c_str();
+        char *end = nullptr;
+        auto skipSeparators = [&p]() {
+            while (*p == ',' || *p == ';' || std::isspace(static_cast<unsigned char>(*p))) ++p;
+        };
+
+        skipSeparators();
+        update.source = std::strtoll(p, &end, 10);
+        if (end == p) return false;
+        p = end;
+        skipSeparators();
+        update.target = std::strtoll(p, &end, 10);
+        if (end == p) return false;
+        p = end;
+        skipSeparators();
+
+        const char *name = p;
+        while (*p && *p != ',' && *p != ';' && !std::isspace(static_cast<unsigned char>(*p))) ++p;
+        if (!parseColumn(std::string(name, p), update.column)) return false;
+        skipSeparators();
+
+        update.value = std::strtod(p, &end);
+        return end != p;
+    }
+
+    bool TelemetryIngestor::parseColumn(const std::string &name, Domain::LinkParameterStore::Column &column)
+    {
+        if (!name.empty() && std::all_of(name.begin(), name.end(), [](unsigned char c) { return std::isdigit(c); }))
+        {
+            int index = std::atoi(name.c_str());
+            if (index >= Domain::LinkParameterStore::COLUMN_COUNT) return false;
+            column = static_cast<Domain::LinkParameterStore::Column>(index);
+            return true;
+        }
+
+        std::string lower(name);
+        std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+        for (int i = 0; i < Domain::LinkParameterStore::COLUMN_COUNT; ++i)
+        {
+            if (lower == COLUMN_NAMES[i])
+            {
+                column = static_cast<Domain::LinkParameterStore::Column>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TelemetryIngestor::push(const TelemetryUpdate &update)
+    {
+        auto now = Clock::now();
+        if (!startedSet)
+        {
+            started = now;
+            startedSet = true;
+        }
+        if (pending.empty()) batchStart = now;
+
+        ++stats.received;
+        auto inserted = pending.insert_or_assign({update.source, update.target, update.column}, update.value);
+        if (!inserted.second) ++stats.coalesced;
+
+        if (pending.size() >= settings.batchSize || now - batchStart >= settings.maxDelay)
+            flush();
+    }
+
+    void TelemetryIngestor::flush()
+    {
+        if (pending.empty()) return;
+
+        auto applyStart = Clock::now();
+        for (const auto &[key, value] : pending)
+        {
+            TelemetryUpdate update{key.source, key.target, static_cast<Domain::LinkParameterStore::Column>(key.column), value};
+            if (applyUpdate(update))
+                ++stats.applied;
+            else
+                ++stats.rejected;
+        }
+        if (concurrent) concurrent->publish();
+        auto applyEnd = Clock::now();
+
+        applyTimes.push_back(std::chrono::duration<double, std::milli>(applyEnd - applyStart).count());
+        totalBatchDelayMs += std::chrono::duration<double, std::milli>(applyEnd - batchStart).count();
+        ++stats.batches;
+        pending.clear();
+    }
+
+    bool TelemetryIngestor::applyUpdate(const TelemetryUpdate &update)
+    {
+        if (concurrent)
+            return concurrent->setEdgeParameter(update.source, update.target, update.column, update.value);
+        return graph->setEdgeParameter(update.source, update.target, update.column, update.value);
+    }
+
+    TelemetryIngestor::Stats TelemetryIngestor::getStats() const
+    {
+        Stats res = stats;
+        if (startedSet)
+            res.elapsedSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+        if (res.elapsedSeconds > 0.0)
+            res.updatesPerSecond = res.received / res.elapsedSeconds;
+
+        if (!applyTimes.empty())
+        {
+            std::vector<double> sorted(applyTimes);
+            std::sort(sorted.begin(), sorted.end());
+            double total = 0.0;
+            for (double t : sorted) total += t;
+            res.avgApplyMs = total / sorted.size();
+            res.p95ApplyMs = sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)];
+            res.maxApplyMs = sorted.back();
+            res.avgBatchDelayMs = totalBatchDelayMs / sorted.size();
+        }
+        return res;
+    }
+
+    void TelemetryIngestor::printStats(const Stats &stats)
+    {
+        std::cout << "ТЕЛЕМЕТРИЯ:\n";
+        std::cout << "Получено обновлений: " << stats.received
+                  << ", применено: " << stats.applied
+                  << ", схлопнуто: " << stats.coalesced
+                  << ", отклонено: " << stats.rejected << "\n";
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Пакетов: " << stats.batches
+                  << ", скорость: " << stats.updatesPerSecond << " обновл./с"
+                  << " за " << stats.elapsedSeconds << " с\n";
+        std::cout << "Применение пакета (мс): среднее " << stats.avgApplyMs
+                  << ", p95 " << stats.p95ApplyMs
+                  << ", макс. " << stats.maxApplyMs
+                  << "; задержка пакета: " << stats.avgBatchDelayMs << " мс\n";
+    }
+}
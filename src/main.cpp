@@ -6,16 +6,25 @@
 #include <iomanip>
 #include <chrono>
 #include <algorithm>
+#include <future>
+#include <random>
 
 // core components
 #include "domain/NetworkGraph.h"
+#include "domain/ConcurrentGraph.h"
 #include "application/GraphAnalysisFactory.h"
+#include "application/GraphAnalysisService.h"
 
 // infrastructure
 #include "infrastructure/AlgorithmComparator.h"
 #include "infrastructure/BasicMonitor.h"
 #include "infrastructure/SimpleStorage.h"
 #include "infrastructure/BoostFlowSolver.h"
+#include "infrastructure/CustomStrategyLoader.h"
+#include "infrastructure/BinaryGraphRepository.h"
+#include "infrastructure/ExternalGraphBuilder.h"
+#include "infrastructure/LinkMetricsTable.h"
+#include "infrastructure/TelemetryIngestor.h"
 
 // config
 #include "config/StrategyConfig.h"
@@ -71,7 +80,9 @@ std::string selectGraphFromCLI()
     std::cout << "2. astar_friendly.txt (200 узлов) - Дорожная сеть\n";
     std::cout << "3. memory:astar_friendly - Генерация графа A* в памяти\n";
     std::cout << "4. custom - Указать свой файл\n";
-    std::cout << "\nВыберите граф (1-5): ";
+    std::cout << "5. external - Список ребер больше памяти: построение .ngb во внешней памяти\n";
+    std::cout << "6. road_grid.csv (900 узлов) - Дорожная сетка с координатами узлов\n";
+    std::cout << "\nВыберите граф (1-6): ";
 
     int choice;
     std::cin >> choice;
@@ -91,6 +102,25 @@ std::string selectGraphFromCLI()
         std::cin >> custom_path;
         return custom_path;
     }
+    case 5:
+    {
+        std::cout << "Введите путь к списку ребер: ";
+        std::string edge_list;
+        std::cin >> edge_list;
+        const std::string output = edge_list + Infrastructure::BinaryGraphRepository::FILE_EXTENSION;
+        Infrastructure::ExternalGraphBuilder::Settings settings;
+        settings.metricsFile = Infrastructure::LinkMetricsTable::findSidecar(edge_list);
+        auto stats = Infrastructure::ExternalGraphBuilder(settings).build(edge_list, output);
+        std::cout << "✅ Построен " << output << ": " << stats.nodes << " узлов, " << stats.edges << " ребер ("
+                  << stats.runs << " прогонов, " << stats.temporaryBytes / (1024 * 1024) << " МБ на диске; "
+                  << "прогоны " << stats.runTime << " мс, слияние " << stats.mergeTime << " мс)\n";
+        if (!settings.metricsFile.empty())
+            std::cout << "Метрики связей (" << settings.metricsFile << "): присоединены к " << stats.joined
+                      << " связям, без метрик " << stats.unjoined << "\n";
+        return output;
+    }
+    case 6:
+        return "data/datasets/road_grid.csv";
     default:
         std::cout << "Неверный выбор, используем gr_1500.csv по умолчанию\n";
         return "data/datasets/gr_1500.csv";
@@ -98,8 +128,8 @@ std::string selectGraphFromCLI()
 }
 
 // получение тестовых маршрутов
-std::vector<std::pair<int, int>> getTestRoutesForGraph(const std::string &graph_file,
-                                                       const Domain::NetworkGraphPtr &graph)
+std::vector<Domain::NodePair> getTestRoutesForGraph(const std::string &graph_file,
+                                                    const Domain::NetworkGraphPtr &graph)
 {
     if (graph_file.find("astar_friendly") != std::string::npos)
     {
@@ -111,15 +141,25 @@ std::vector<std::pair<int, int>> getTestRoutesForGraph(const std::string &graph_
             {300, 1200},
             {120, 300}};
     }
+    else if (graph_file.find("road_grid") != std::string::npos)
+    {
+        // сетка 30x30: маршруты через всю сетку, по диагонали и вдоль края
+        return {
+            {0, 899},
+            {29, 870},
+            {0, 29},
+            {435, 899},
+            {15, 884}};
+    }
     else
     {
         auto nodes = graph->getAllNodeIds();
-        std::vector<std::pair<int, int>> routes;
-        std::vector<int> good_nodes;
+        std::vector<Domain::NodePair> routes;
+        std::vector<Domain::NodeId> good_nodes;
 
         for (int i = 0; i < std::min(20, (int)nodes.size()); ++i)
         {
-            if (graph->getNeighbors(nodes[i]).size() >= 3)
+            if (graph->getOutDegree(nodes[i]) >= 3)
             {
                 good_nodes.push_back(nodes[i]);
                 if (good_nodes.size() >= 6)
@@ -150,6 +190,8 @@ std::string getGraphDescription(const std::string &graph_file)
 {
     if (graph_file.find("astar_friendly") != std::string::npos)
         return "astar_friendly.txt (200 узлов) - ДОРОЖНАЯ СЕТЬ";
+    else if (graph_file.find("road_grid") != std::string::npos)
+        return "road_grid.csv (900 узлов) - ДОРОЖНАЯ СЕТКА С КООРДИНАТАМИ";
     else if (graph_file.find("gr_1500") != std::string::npos)
         return "gr_1500.csv (300 узлов) - Социальная сеть";
     else if (graph_file.find("small_test") != std::string::npos)
@@ -169,11 +211,30 @@ Config::StrategySettings selectStrategyFromCLI()
     std::cout << "4. Cost Optimized       - минимизация стоимости (бюджетный)\n";
     std::cout << "5. Adaptive             - адаптивная стратегия (интеллектуальный)\n";
     std::cout << "6. Mixed                - смешанный подход (разные стратегии)\n";
-    std::cout << "\nВыберите стратегию (1-6): ";
+
+    // пользовательские стратегии компилируются при загрузке и дальше не отличаются от встроенных
+    std::vector<Domain::WeightCalculator::Strategy> custom;
+    try
+    {
+        custom = Infrastructure::CustomStrategyLoader::loadFile("data/strategies.cfg");
+    }
+    catch (const std::exception &e)
+    {
+        std::cout << "⚠️ Пользовательские стратегии не загружены: " << e.what() << "\n";
+    }
+    for (std::size_t i = 0; i < custom.size(); ++i)
+    {
+        std::cout << (7 + i) << ". " << std::left << std::setw(22) << Domain::WeightCalculator::getStrategyName(custom[i])
+                  << " - " << Domain::WeightCalculator::getStrategyDescription(custom[i]) << " (strategies.cfg)\n";
+    }
+    std::cout << "\nВыберите стратегию (1-" << (6 + custom.size()) << "): ";
 
     int choice;
     std::cin >> choice;
 
+    if (choice > 6 && choice <= 6 + static_cast<int>(custom.size()))
+        return Config::StrategySettings::createCustom(custom[choice - 7]);
+
     switch (choice)
     {
     case 1:
@@ -194,6 +255,75 @@ Config::StrategySettings selectStrategyFromCLI()
     }
 }
 
+// потоковая телеметрия во время параллельных запросов: писатель применяет обновления загрузки
+// и задержки к копии графа и публикует версии, запросы закрепляют текущую версию
+void runConcurrentTelemetryBenchmark(const Domain::NetworkGraphPtr &graph,
+                                     const std::vector<Domain::NodePair> &test_routes, int rounds = 20)
+{
+    using Column = Domain::LinkParameterStore::Column;
+
+    Domain::ConcurrentGraph concurrent(graph->createSnapshot());
+
+    // по раунду на каждое ребро: новая загрузка и задержка с колебанием до 10%
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> jitter(0.9, 1.1);
+    std::uniform_real_distribution<double> load(0.0, 0.95);
+    std::vector<Infrastructure::TelemetryUpdate> updates;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (auto id : graph->getAllNodeIds())
+        {
+            for (auto edge : graph->neighbors(id))
+            {
+                updates.push_back({id, edge.getTarget(), Column::UTILIZATION, load(rng)});
+                updates.push_back({id, edge.getTarget(), Column::LATENCY, edge.getValue(Column::LATENCY) * jitter(rng)});
+            }
+        }
+    }
+
+    Infrastructure::TelemetryIngestor::Settings settings;
+    settings.batchSize = 256;
+    Infrastructure::TelemetryIngestor ingestor(concurrent, settings);
+    auto writer = std::async(std::launch::async, [&]()
+                             {
+                                 for (const auto &update : updates)
+                                     ingestor.push(update);
+                                 ingestor.flush();
+                                 return ingestor.getStats();
+                             });
+
+    // запросы идут, пока писатель не применит все обновления (хотя бы один раунд)
+    Application::GraphAnalysisService service;
+    std::size_t query_rounds = 0, queries = 0, found = 0;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    do
+    {
+        for (const auto &result : service.analyzePathsParallel(concurrent, test_routes))
+        {
+            ++queries;
+            if (result.success)
+                ++found;
+        }
+        ++query_rounds;
+    } while (writer.wait_for(std::chrono::seconds(0)) != std::future_status::ready);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto stats = writer.get();
+    double query_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+    std::cout << "\n"
+              << std::string(100, '=') << "\n";
+    std::cout << "ТЕЛЕМЕТРИЯ ВО ВРЕМЯ ПАРАЛЛЕЛЬНЫХ ЗАПРОСОВ (ConcurrentGraph)\n";
+    std::cout << std::string(100, '=') << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Запросов: " << queries << " (" << query_rounds << " раундов по " << test_routes.size()
+              << " маршрутов), путь найден: " << found
+              << ", среднее время раунда: " << (query_rounds ? query_ms / query_rounds : 0.0) << " мс\n";
+    concurrent.reclaim();
+    std::cout << "Опубликовано версий: " << concurrent.getEpoch() - 1
+              << ", не освобождено: " << concurrent.getRetiredCount() << "\n";
+    Infrastructure::TelemetryIngestor::printStats(stats);
+}
+
 int main()
 {
     setupConsole();
@@ -223,7 +353,7 @@ int main()
         }
         else
         {
-            auto repo = Application::GraphAnalysisFactory::createRepository();
+            auto repo = Application::GraphAnalysisFactory::createRepository(graph_file);
             graph = repo->loadGraph(graph_file);
             std::cout << "✅ Успешно загружен: " << graph->getInfo() << "\n\n";
         }
@@ -251,8 +381,32 @@ int main()
         auto all_results = Infrastructure::AlgorithmComparator::compareAlgorithms(graph, test_routes, strategies);
         Infrastructure::AlgorithmComparator::printComparisonTable(all_results);
 
+        // влияние нумерации вершин на точные алгоритмы
+        auto ordering_results = Infrastructure::AlgorithmComparator::benchmarkOrderings(graph, test_routes);
+        Infrastructure::AlgorithmComparator::printOrderingTable(ordering_results);
+
+        // пересчет весов векторными ядрами
+        auto kernel_results = Infrastructure::AlgorithmComparator::benchmarkWeightKernels(graph);
+        Infrastructure::AlgorithmComparator::printWeightKernelTable(kernel_results);
+
+        // массив весов против ядер, специализированных под стратегию
+        auto evaluation_results = Infrastructure::AlgorithmComparator::benchmarkWeightEvaluation(graph, test_routes);
+        Infrastructure::AlgorithmComparator::printWeightEvaluationTable(evaluation_results);
+
+        // один многокритериальный поиск против поиска по каждой стратегии
+        auto pareto_results = Infrastructure::AlgorithmComparator::benchmarkParetoSearch(graph, test_routes);
+        Infrastructure::AlgorithmComparator::printParetoTable(pareto_results);
+
+        // обновления телеметрии параллельно с запросами к публикуемым версиям графа
+        runConcurrentTelemetryBenchmark(graph, test_routes);
+
+        // занятая память после построения всех снимков и кэшей весов
+        std::cout << "\n";
+        Infrastructure::BasicMonitor::printMemoryReport(graph);
+
         // сохранение результатов
         Infrastructure::SimpleStorage::saveExperimentResults("full_algorithm_comparison.csv", all_results);
+        Infrastructure::SimpleStorage::saveMemoryReport(graph, all_results, "memory_report.csv");
         Infrastructure::SimpleStorage::saveGraphInfo(graph, "full_test_results.txt");
         Infrastructure::SimpleStorage::logEvent("Полное сравнение 6 алгоритмов завершено. Граф: " + graph_description + ", Стратегия: " + strategies.getDescription());
         std::cout << "\n✅ Результаты сохранены.\n";